@@ -0,0 +1,83 @@
+#include "asteroid_effects.h"
+
+//------------------------------------------------------------------------------------
+// AsteroidEffects Class - Implementation
+//------------------------------------------------------------------------------------
+
+void AsteroidEffects::Reset(size_t asteroidCount)
+{
+    members.clear();
+    memberSlots.assign(asteroidCount, -1);
+}
+
+void AsteroidEffects::Register(int index)
+{
+    if ((size_t)index >= memberSlots.size())
+        memberSlots.resize((size_t)index + 1, -1); // Store grew since Reset
+    if (memberSlots[index] >= 0)
+        return;
+    memberSlots[index] = (int)members.size();
+    members.push_back(index);
+}
+
+// Swap-remove: the last member takes the freed slot
+void AsteroidEffects::Unregister(size_t slot)
+{
+    int index = members[slot];
+    int last = members.back();
+    members[slot] = last;
+    memberSlots[last] = (int)slot;
+    members.pop_back();
+    memberSlots[index] = -1;
+}
+
+void AsteroidEffects::StartShake(AsteroidStore &asteroids, int index, float duration)
+{
+    asteroids.flags[index] |= ASTEROID_SHAKING;
+    asteroids.shakeTimers[index] = duration;
+    asteroids.currentColors[index] = RED;
+    Register(index);
+}
+
+void AsteroidEffects::MarkTouched(AsteroidStore &asteroids, int index)
+{
+    asteroids.currentColors[index] = RED;
+    Register(index);
+}
+
+void AsteroidEffects::UpdateShakeTimers(AsteroidStore &asteroids, float deltaTime)
+{
+    for (int i : members)
+    {
+        if (asteroids.flags[i] & ASTEROID_SHAKING)
+        {
+            asteroids.shakeTimers[i] -= deltaTime;
+            if (asteroids.shakeTimers[i] <= 0.0f)
+                asteroids.flags[i] &= ~ASTEROID_SHAKING; // Color is restored by UpdateColors
+        }
+    }
+}
+
+void AsteroidEffects::UpdateColors(AsteroidStore &asteroids, Vector3 playerPosition, float playerRadius)
+{
+    // Backwards, so the member swapped into a freed slot has already been visited
+    for (size_t k = members.size(); k-- > 0;)
+    {
+        int i = members[k];
+        if (!asteroids.IsActive(i))
+        {
+            Unregister(k); // Destroyed or evicted, nothing left to restore
+            continue;
+        }
+
+        // Rough check if player is still touching this asteroid
+        bool collidingWithPlayer = CheckCollisionSpheres(playerPosition, playerRadius, asteroids.positions[i], asteroids.collisionRadii[i]);
+        if (asteroids.IsShaking(i) || collidingWithPlayer)
+        {
+            asteroids.currentColors[i] = RED; // Keep red if shaking or colliding
+            continue;
+        }
+        asteroids.currentColors[i] = asteroids.cold[i].color;
+        Unregister(k);
+    }
+}
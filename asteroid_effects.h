@@ -0,0 +1,45 @@
+#ifndef ASTEROID_EFFECTS_H
+#define ASTEROID_EFFECTS_H
+
+#include "raylib.h"
+#include <vector>
+
+#include "asteroid_store.h"
+
+//------------------------------------------------------------------------------------
+// Active Asteroid Effects
+//------------------------------------------------------------------------------------
+// The few asteroids whose tint or shake state can change: hits (StartShake) and player
+// contacts (MarkTouched) turn an asteroid RED and register it, the per-tick and per-frame
+// passes then only visit registered asteroids instead of the whole store. An asteroid stays
+// registered until it neither shakes nor touches the player, then its color is restored.
+//
+// Main thread only. Asteroids destroyed, evicted or overwritten (AsteroidStore::Set) while
+// registered are dropped by the next UpdateColors without touching them.
+class AsteroidEffects
+{
+public:
+    // Empty set for a store of asteroidCount asteroids (new field or new game)
+    void Reset(size_t asteroidCount);
+
+    // Hit effect: shake for duration seconds, RED until it ends
+    void StartShake(AsteroidStore &asteroids, int index, float duration);
+    // The player bumped into asteroid index: RED while the player sphere still overlaps it
+    void MarkTouched(AsteroidStore &asteroids, int index);
+
+    // Count down the shake timers of registered asteroids, clear ASTEROID_SHAKING when they expire (per tick)
+    void UpdateShakeTimers(AsteroidStore &asteroids, float deltaTime);
+    // Keep RED while shaking or touching the player, otherwise restore the color and drop the asteroid (per frame)
+    void UpdateColors(AsteroidStore &asteroids, Vector3 playerPosition, float playerRadius);
+
+    int GetActiveCount() const { return (int)members.size(); }
+
+private:
+    void Register(int index);
+    void Unregister(size_t slot);
+
+    std::vector<int> members;     // Registered asteroid indices (unordered)
+    std::vector<int> memberSlots; // Per asteroid: position in members, -1 when not registered
+};
+
+#endif // ASTEROID_EFFECTS_H
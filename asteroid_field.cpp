@@ -2,147 +2,548 @@
 #include "asteroid_field.h" // Include the header file (defines constants now)
 
 #include "raymath.h"
+#include "displacement_kernel.h" // AsteroidShape and the vectorized displacement/normal kernels
 #include <vector>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
 
 //------------------------------------------------------------------------------------
-// Helper Function for Random Float (Definition)
+// Procedural Asteroid Shape (shared by all LODs of a variant)
 //------------------------------------------------------------------------------------
-float GetRandomFloat(float min, float max)
+
+static AsteroidShape GenerateAsteroidShape(float baseRadius, float irregularity, Rng &rng)
 {
-    if (max <= min)
-        return min;
-    return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+    AsteroidShape shape;
+    shape.baseRadius = baseRadius;
+    shape.irregularity = irregularity;
+    for (int i = 0; i < SHAPE_LOBE_COUNT; ++i)
+    {
+        Vector3 dir;
+        do
+        {
+            rng.FillFloats(&dir.x, 3, -1.0f, 1.0f);
+        } while (Vector3LengthSqr(dir) < 0.01f);
+        shape.directions[i] = Vector3Normalize(dir);
+        // Slightly bias towards pushing out more than in for chunkier rocks
+        shape.amplitudes[i] = rng.Range(-0.5f, 1.0f);
+        shape.sharpness[i] = rng.Range(1.5f, 4.0f);
+    }
+    return shape;
 }
 
 //------------------------------------------------------------------------------------
-// Procedural Asteroid Mesh Generation Function (Static - internal use)
+// CPU Sphere Mesh (no GPU upload, safe to call from a worker thread)
 //------------------------------------------------------------------------------------
-static Mesh GenerateAsteroidMesh(float baseRadius, float irregularity)
+// Indexed UV sphere: (rings + 1) x (slices + 1) vertices, the seam column is duplicated so
+// texcoords stay continuous. Buffers come from MemAlloc, so UnloadMesh releases them.
+static Mesh GenerateSphereMeshData(float radius, int rings, int slices)
 {
-    // Use GenMeshSphere with low segment count instead of Icosphere
-    int rings = (rand() % 9) + 4;  // random number between 4 and 12
-    int slices = (rand() % 9) + 4; // Adjust detail level
-    Mesh mesh = GenMeshSphere(baseRadius, rings, slices);
+    Mesh mesh = {0};
+    if (rings < 2 || slices < 3)
+        return mesh;
 
-    if (mesh.vertices == nullptr)
+    int columns = slices + 1;
+    mesh.vertexCount = (rings + 1) * columns;
+    mesh.triangleCount = rings * slices * 2;
+    mesh.vertices = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+    mesh.normals = (float *)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+    mesh.texcoords = (float *)MemAlloc(mesh.vertexCount * 2 * sizeof(float));
+    mesh.indices = (unsigned short *)MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short));
+
+    for (int ring = 0; ring <= rings; ++ring)
     {
-        TraceLog(LOG_WARNING, "Failed to generate base mesh for asteroid");
-        return mesh; // Return empty mesh if generation failed
+        float v = (float)ring / (float)rings;
+        float phi = v * PI; // 0 at the north pole
+        for (int slice = 0; slice <= slices; ++slice)
+        {
+            float u = (float)slice / (float)slices;
+            float theta = (slice == slices) ? 0.0f : u * 2.0f * PI; // Seam column matches column 0 exactly
+            Vector3 dir = {sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta)};
+
+            int vertex = ring * columns + slice;
+            mesh.vertices[vertex * 3 + 0] = dir.x * radius;
+            mesh.vertices[vertex * 3 + 1] = dir.y * radius;
+            mesh.vertices[vertex * 3 + 2] = dir.z * radius;
+            mesh.normals[vertex * 3 + 0] = dir.x;
+            mesh.normals[vertex * 3 + 1] = dir.y;
+            mesh.normals[vertex * 3 + 2] = dir.z;
+            mesh.texcoords[vertex * 2 + 0] = u;
+            mesh.texcoords[vertex * 2 + 1] = v;
+        }
     }
 
-    int vertexCount = mesh.vertexCount;
-    float *vertices = mesh.vertices; // Work directly with the float* vertex buffer
+    int index = 0;
+    for (int ring = 0; ring < rings; ++ring)
+    {
+        for (int slice = 0; slice < slices; ++slice)
+        {
+            unsigned short a = (unsigned short)(ring * columns + slice);
+            unsigned short b = (unsigned short)(a + columns);
+            // Counter-clockwise seen from outside
+            mesh.indices[index++] = a;
+            mesh.indices[index++] = (unsigned short)(a + 1);
+            mesh.indices[index++] = b;
+            mesh.indices[index++] = (unsigned short)(a + 1);
+            mesh.indices[index++] = (unsigned short)(b + 1);
+            mesh.indices[index++] = b;
+        }
+    }
+
+    return mesh;
+}
+
+//------------------------------------------------------------------------------------
+// Smooth Normals for a Displaced UV Sphere (Static - internal use, CPU only)
+//------------------------------------------------------------------------------------
+// Area-weighted face normals are accumulated per vertex, then the duplicated seam column
+// and the collapsed pole rows are merged so they shade as one vertex. The SoA buffers
+// receive the normalized result.
+static void ComputeSphereNormals(const Mesh &mesh, int rings, int slices, float *nx, float *ny, float *nz)
+{
+    int columns = slices + 1;
+    const float *vertices = mesh.vertices;
+    for (int i = 0; i < mesh.vertexCount; ++i)
+        nx[i] = ny[i] = nz[i] = 0.0f;
+
+    for (int t = 0; t < mesh.triangleCount; ++t)
+    {
+        int a = mesh.indices[t * 3 + 0];
+        int b = mesh.indices[t * 3 + 1];
+        int c = mesh.indices[t * 3 + 2];
+        Vector3 pa = {vertices[a * 3 + 0], vertices[a * 3 + 1], vertices[a * 3 + 2]};
+        Vector3 pb = {vertices[b * 3 + 0], vertices[b * 3 + 1], vertices[b * 3 + 2]};
+        Vector3 pc = {vertices[c * 3 + 0], vertices[c * 3 + 1], vertices[c * 3 + 2]};
+        Vector3 faceNormal = Vector3CrossProduct(Vector3Subtract(pb, pa), Vector3Subtract(pc, pa)); // Length = 2 * area
+        int corners[3] = {a, b, c};
+        for (int k = 0; k < 3; ++k)
+        {
+            nx[corners[k]] += faceNormal.x;
+            ny[corners[k]] += faceNormal.y;
+            nz[corners[k]] += faceNormal.z;
+        }
+    }
 
-    for (int i = 0; i < vertexCount; ++i) // 'int i' is fine here as vertexCount is int
+    // Seam: first and last column are the same points
+    for (int ring = 0; ring <= rings; ++ring)
     {
-        // Read current vertex position components
-        float vx = vertices[i * 3 + 0];
-        float vy = vertices[i * 3 + 1];
-        float vz = vertices[i * 3 + 2];
-        Vector3 vertexPos = {vx, vy, vz};
+        int first = ring * columns;
+        int last = first + slices;
+        nx[first] = nx[last] = nx[first] + nx[last];
+        ny[first] = ny[last] = ny[first] + ny[last];
+        nz[first] = nz[last] = nz[first] + nz[last];
+    }
 
-        // Calculate random offset
-        float offsetMagnitude = baseRadius * irregularity * GetRandomFloat(0.5f, 1.0f);
-        Vector3 offsetDir = {0};
-        if (Vector3LengthSqr(vertexPos) > 0.0001f)
+    // Poles: every vertex of the first and last row is the same point
+    const int poleRows[2] = {0, rings};
+    for (int p = 0; p < 2; ++p)
+    {
+        int rowStart = poleRows[p] * columns;
+        Vector3 sum = {0};
+        for (int slice = 0; slice < slices; ++slice) // Seam vertex already holds column 0's sum
         {
-            offsetDir = Vector3Normalize(vertexPos);
+            sum.x += nx[rowStart + slice];
+            sum.y += ny[rowStart + slice];
+            sum.z += nz[rowStart + slice];
         }
-        else
+        for (int slice = 0; slice <= slices; ++slice)
         {
-            offsetDir = {1.0f, 0.0f, 0.0f}; // Default direction
+            nx[rowStart + slice] = sum.x;
+            ny[rowStart + slice] = sum.y;
+            nz[rowStart + slice] = sum.z;
         }
-        // Slightly bias towards pushing out more than in for chunkier rocks
-        Vector3 randomOffset = Vector3Scale(offsetDir, offsetMagnitude * GetRandomFloat(-0.5f, 1.0f));
-        Vector3 newPos = Vector3Add(vertexPos, randomOffset);
+    }
+
+    NormalizeVectors(nx, ny, nz, mesh.vertexCount);
+}
+
+//------------------------------------------------------------------------------------
+// Procedural Asteroid Mesh Generation Function (Static - internal use, CPU only)
+//------------------------------------------------------------------------------------
+static Mesh GenerateAsteroidMesh(const AsteroidShape &shape, int rings, int slices)
+{
+    Mesh mesh = GenerateSphereMeshData(shape.baseRadius, rings, slices);
 
-        // Write new position components back to the float buffer
-        vertices[i * 3 + 0] = newPos.x;
-        vertices[i * 3 + 1] = newPos.y;
-        vertices[i * 3 + 2] = newPos.z;
+    if (mesh.vertices == nullptr)
+    {
+        TraceLog(LOG_WARNING, "Failed to generate base mesh for asteroid");
+        return mesh; // Return empty mesh if generation failed
+    }
+
+    // The base sphere's normals are the unit vertex directions, transposed here into SoA
+    // streams for the kernels: x, y, z, radius
+    int vertexCount = mesh.vertexCount;
+    std::vector<float> scratch(vertexCount * 4);
+    float *x = scratch.data();
+    float *y = x + vertexCount;
+    float *z = y + vertexCount;
+    float *radius = z + vertexCount;
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        x[i] = mesh.normals[i * 3 + 0];
+        y[i] = mesh.normals[i * 3 + 1];
+        z[i] = mesh.normals[i * 3 + 2];
+    }
+
+    EvaluateShapeRadii(shape, x, y, z, radius, vertexCount);
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        mesh.vertices[i * 3 + 0] = x[i] * radius[i];
+        mesh.vertices[i * 3 + 1] = y[i] * radius[i];
+        mesh.vertices[i * 3 + 2] = z[i] * radius[i];
+    }
+
+    // Lighting needs the normals of the displaced surface, not of the sphere
+    ComputeSphereNormals(mesh, rings, slices, x, y, z);
+    for (int i = 0; i < vertexCount; ++i)
+    {
+        mesh.normals[i * 3 + 0] = x[i];
+        mesh.normals[i * 3 + 1] = y[i];
+        mesh.normals[i * 3 + 2] = z[i];
     }
 
     return mesh;
 }
 
 //------------------------------------------------------------------------------------
-// Function Definition for Initializing Asteroids
+// Parallel Generation Helpers
 //------------------------------------------------------------------------------------
-std::vector<Asteroid> InitializeAsteroidField(Material defaultMaterial)
+constexpr size_t FIELD_JOB_CHUNK = 1024; // Asteroids placed per job
+
+// Run fn over [0, count) on the job system and join, or inline without one
+template <typename Fn>
+static void RunGenerationJobs(JobSystem *jobs, size_t count, size_t chunkSize, const Fn &fn)
+{
+    if (jobs == nullptr)
+    {
+        fn(0, count);
+        return;
+    }
+    jobs->ParallelFor(count, chunkSize, fn);
+    jobs->Wait();
+}
+
+//------------------------------------------------------------------------------------
+// Mesh Pool Generation / Upload / Unloading
+//------------------------------------------------------------------------------------
+
+// One variant with all its LODs into outLodMeshes (CPU buffers only). On failure every
+// level is freed and false is returned.
+static bool GenerateAsteroidMeshVariant(Rng &rng, float irregularity, Mesh *outLodMeshes, float &outRadius)
 {
-    // Constants are now defined in asteroid_field.h via AsteroidFieldConstants namespace
     using namespace AsteroidFieldConstants;
 
-    std::vector<Asteroid> asteroids;
-    asteroids.reserve(NUM_ASTEROIDS);
-    std::vector<Vector3> clusterCenters(NUM_CLUSTERS);
+    // Variants are built at base radius, asteroids scale them up when drawn
+    float currentIrregularity = irregularity * rng.Range(0.8f, 1.2f);
+    AsteroidShape shape = GenerateAsteroidShape(BASE_MESH_RADIUS, currentIrregularity, rng);
 
-    // Generate cluster centers
-    for (int i = 0; i < NUM_CLUSTERS; ++i)
+    bool generated = true;
+    for (int lod = 0; lod < NUM_LOD_LEVELS; ++lod)
     {
-        clusterCenters[i].x = GetRandomFloat(-CLUSTER_SPREAD_RADIUS, CLUSTER_SPREAD_RADIUS);
-        clusterCenters[i].y = GetRandomFloat(-CLUSTER_SPREAD_RADIUS, CLUSTER_SPREAD_RADIUS);
-        clusterCenters[i].z = GetRandomFloat(-CLUSTER_SPREAD_RADIUS, CLUSTER_SPREAD_RADIUS);
+        outLodMeshes[lod] = GenerateAsteroidMesh(shape, LOD_RINGS[lod], LOD_SLICES[lod]);
+        generated = generated && (outLodMeshes[lod].vertices != nullptr);
     }
 
-    // Generate asteroids
-    for (int i = 0; i < NUM_ASTEROIDS; ++i)
+    if (!generated)
     {
-        Asteroid currentAsteroid = {0};
+        for (int lod = 0; lod < NUM_LOD_LEVELS; ++lod)
+            UnloadMesh(outLodMeshes[lod]); // CPU buffers only, nothing was uploaded yet
+        return false;
+    }
 
-        int clusterIndex = rand() % NUM_CLUSTERS;
-        Vector3 clusterCenter = clusterCenters[clusterIndex];
-        currentAsteroid.position.x = clusterCenter.x + GetRandomFloat(-ASTEROID_SCATTER_RADIUS, ASTEROID_SCATTER_RADIUS);
-        currentAsteroid.position.y = clusterCenter.y + GetRandomFloat(-ASTEROID_SCATTER_RADIUS, ASTEROID_SCATTER_RADIUS);
-        currentAsteroid.position.z = clusterCenter.z + GetRandomFloat(-ASTEROID_SCATTER_RADIUS, ASTEROID_SCATTER_RADIUS);
+    // The finest level defines the bounds
+    BoundingBox bounds = GetMeshBoundingBox(outLodMeshes[0]);
+    Vector3 boundsSize = Vector3Subtract(bounds.max, bounds.min);
+    float maxDim = fmaxf(fmaxf(boundsSize.x, boundsSize.y), boundsSize.z);
+    outRadius = maxDim * 0.5f;
+    return true;
+}
 
-        float sizeMultiplier = 1.0f;
-        if (GetRandomFloat(0.0f, 1.0f) < LARGE_ASTEROID_CHANCE)
-        {
-            sizeMultiplier = GetRandomFloat(1.8f, 3.0f);
-        }
+float GetAsteroidMeshInnerRadius(float irregularity, int lod)
+{
+    using namespace AsteroidFieldConstants;
+    // Deepest dent: the variant jitter (up to 1.2x irregularity) times the kernel scale (0.75) at its -0.5 clamp
+    float vertexRadius = BASE_MESH_RADIUS * (1.0f - irregularity * 1.2f * 0.75f * 0.5f);
+    if (vertexRadius < 0.0f)
+        return 0.0f;
+    // Flat faces between the vertices cut inside the sphere through them
+    if (lod < 0)
+        lod = 0;
+    if (lod >= NUM_LOD_LEVELS)
+        lod = NUM_LOD_LEVELS - 1;
+    return vertexRadius * cosf(PI / LOD_SLICES[lod]) * cosf(PI / LOD_RINGS[lod]);
+}
+
+int GenerateAsteroidMeshVariants(AsteroidMeshPool &pool, const FieldConfig &config, Rng &rng, JobSystem *jobs, std::atomic<int> *progress)
+{
+    using namespace AsteroidFieldConstants;
+    pool.lodCount = NUM_LOD_LEVELS;
+    int variantCount = config.meshVariants;
+    float irregularity = config.meshIrregularity;
+    if (variantCount <= 0)
+        variantCount = 1;
 
-        float currentRadius = BASE_MESH_RADIUS * sizeMultiplier;
-        float currentIrregularity = MESH_IRREGULARITY * GetRandomFloat(0.8f, 1.2f);
-        currentAsteroid.mesh = GenerateAsteroidMesh(currentRadius, currentIrregularity);
+    TraceLog(LOG_INFO, "Generating %d asteroid mesh variants (%s displacement kernel)", variantCount, GetDisplacementKernelName());
 
-        if (currentAsteroid.mesh.vertices == nullptr)
+    // Variant v always comes from stream v of this seed, whichever thread builds it
+    uint64_t variantSeed = rng.NextUInt64();
+
+    std::vector<Mesh> meshes(variantCount * NUM_LOD_LEVELS, Mesh{0});
+    std::vector<float> radii(variantCount, 0.0f);
+    std::vector<unsigned char> generated(variantCount, 0);
+    Mesh *meshData = meshes.data();
+    float *radiusData = radii.data();
+    unsigned char *generatedData = generated.data();
+
+    RunGenerationJobs(jobs, (size_t)variantCount, 1, [=](size_t begin, size_t end)
+                      {
+        for (size_t v = begin; v < end; ++v)
         {
-            TraceLog(LOG_WARNING, "Skipping asteroid %d due to mesh generation failure.", i);
+            Rng variantRng(variantSeed, v);
+            generatedData[v] = GenerateAsteroidMeshVariant(variantRng, irregularity, meshData + v * NUM_LOD_LEVELS, radiusData[v]) ? 1 : 0;
+            if (progress != nullptr)
+                (*progress)++;
+        } });
+
+    // Append in variant order, so failures only drop their own variant
+    int added = 0;
+    pool.meshes.reserve(pool.meshes.size() + meshes.size());
+    pool.radii.reserve(pool.radii.size() + radii.size());
+    for (int v = 0; v < variantCount; ++v)
+    {
+        if (!generated[v])
+        {
+            TraceLog(LOG_WARNING, "Skipping mesh variant %d due to mesh generation failure.", v);
             continue;
         }
+        for (int lod = 0; lod < NUM_LOD_LEVELS; ++lod)
+            pool.meshes.push_back(meshes[v * NUM_LOD_LEVELS + lod]);
+        pool.radii.push_back(radii[v]);
+        added++;
+    }
+    return added;
+}
+
+void UploadAsteroidMesh(Mesh &mesh)
+{
+    if (mesh.vertices != nullptr && mesh.vboId == nullptr)
+        UploadMesh(&mesh, false);
+}
 
-        currentAsteroid.material = defaultMaterial;
+AsteroidMeshPool GenerateAsteroidMeshPool(const FieldConfig &config, Rng &rng, JobSystem *jobs)
+{
+    using namespace AsteroidFieldConstants;
 
-        unsigned char grayValue = (unsigned char)GetRandomFloat(50.0f, 200.0f);
-        currentAsteroid.color = {grayValue, grayValue, grayValue, 255};
-        currentAsteroid.currentColor = currentAsteroid.color;
+    // CPU phase (parallel), then GPU upload (this thread)
+    AsteroidMeshPool pool;
+    GenerateAsteroidMeshVariants(pool, config, rng, jobs);
+    for (size_t i = 0; i < pool.meshes.size(); ++i)
+        UploadAsteroidMesh(pool.meshes[i]);
 
-        currentAsteroid.rotationAngle = GetRandomFloat(0.0f, 360.0f);
-        currentAsteroid.rotationSpeed = GetRandomFloat(MIN_ROTATION_SPEED, MAX_ROTATION_SPEED) * (rand() % 2 == 0 ? 1.0f : -1.0f);
-        do
-        {
-            currentAsteroid.rotationAxis = Vector3Normalize({GetRandomFloat(-1.0f, 1.0f), GetRandomFloat(-1.0f, 1.0f), GetRandomFloat(-1.0f, 1.0f)});
-        } while (Vector3LengthSqr(currentAsteroid.rotationAxis) < 0.01f);
+    TraceLog(LOG_INFO, "Generated %d asteroid mesh variants with %d LODs each.", GetMeshPoolVariantCount(pool), NUM_LOD_LEVELS);
+
+    return pool;
+}
+
+void UnloadAsteroidMeshPool(AsteroidMeshPool &pool)
+{
+    // UnloadMesh frees GPU buffers if uploaded and the CPU arrays in any case
+    for (size_t i = 0; i < pool.meshes.size(); ++i)
+        UnloadMesh(pool.meshes[i]);
+    pool.meshes.clear();
+    pool.radii.clear();
+}
+
+size_t GetMeshPoolCpuMemory(const AsteroidMeshPool &pool)
+{
+    size_t bytes = 0;
+    for (const Mesh &mesh : pool.meshes)
+    {
+        size_t vertexCount = (size_t)mesh.vertexCount;
+        if (mesh.vertices != nullptr)
+            bytes += vertexCount * 3 * sizeof(float);
+        if (mesh.normals != nullptr)
+            bytes += vertexCount * 3 * sizeof(float);
+        if (mesh.texcoords != nullptr)
+            bytes += vertexCount * 2 * sizeof(float);
+        if (mesh.indices != nullptr)
+            bytes += (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+    }
+    return bytes;
+}
+
+size_t GetMeshPoolGpuMemory(const AsteroidMeshPool &pool)
+{
+    // Pool meshes have no colors, tangents or second texcoords, so UploadMesh creates no buffers for them
+    size_t bytes = 0;
+    for (const Mesh &mesh : pool.meshes)
+    {
+        if (mesh.vboId == nullptr)
+            continue; // Not uploaded yet
+        bytes += (size_t)mesh.vertexCount * (3 + 2 + 3) * sizeof(float);
+        if (mesh.indices != nullptr)
+            bytes += (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+    }
+    return bytes;
+}
+
+//------------------------------------------------------------------------------------
+// Function Definition for Initializing Asteroids
+//------------------------------------------------------------------------------------
+// Everything about asteroid i except its cluster, drawn from its own stream
+static void GenerateAsteroid(Rng &asteroidRng, Vector3 clusterCenter, const FieldConfig &config, const AsteroidMeshPool &meshPool,
+                             AsteroidStore &store, size_t i)
+{
+    AsteroidColdData coldData = {0};
+    Vector3 position;
+    float scatter = config.scatterRadius;
+    position.x = clusterCenter.x + asteroidRng.Range(-scatter, scatter);
+    position.y = clusterCenter.y + asteroidRng.Range(-scatter, scatter);
+    position.z = clusterCenter.z + asteroidRng.Range(-scatter, scatter);
+
+    float sizeMultiplier = 1.0f;
+    if (asteroidRng.NextFloat() < config.largeAsteroidChance)
+    {
+        sizeMultiplier = asteroidRng.Range(1.8f, 3.0f);
+    }
+
+    coldData.variantIndex = asteroidRng.NextInt(GetMeshPoolVariantCount(meshPool));
+    coldData.scale = sizeMultiplier;
+
+    unsigned char grayValue = (unsigned char)asteroidRng.Range(50.0f, 200.0f);
+    coldData.color = {grayValue, grayValue, grayValue, 255};
+
+    float rotationAngle = asteroidRng.Range(0.0f, 360.0f);
+    float rotationSpeed = asteroidRng.Range(config.minRotationSpeed, config.maxRotationSpeed) * (asteroidRng.NextBool() ? 1.0f : -1.0f);
+    do
+    {
+        asteroidRng.FillFloats(&coldData.rotationAxis.x, 3, -1.0f, 1.0f);
+    } while (Vector3LengthSqr(coldData.rotationAxis) < 0.01f);
+    coldData.rotationAxis = Vector3Normalize(coldData.rotationAxis);
+
+    float collisionRadius = meshPool.radii[coldData.variantIndex] * sizeMultiplier;
+    coldData.shakeIntensity = config.shakeMagnitude * sizeMultiplier;
+
+    store.Set(i, position, collisionRadius, rotationAngle, rotationSpeed, config.initialHitPoints, coldData);
+}
+
+AsteroidStore InitializeAsteroidField(const AsteroidMeshPool &meshPool, Rng &rng, const FieldConfig &config, JobSystem *jobs)
+{
+    int asteroidCount = config.asteroidCount;
+    int clusterCount = (config.clusterCount > 0) ? config.clusterCount : 1;
+    float spread = config.clusterSpreadRadius;
 
-        BoundingBox bounds = GetMeshBoundingBox(currentAsteroid.mesh);
-        Vector3 boundsSize = Vector3Subtract(bounds.max, bounds.min);
-        float maxDim = fmaxf(fmaxf(boundsSize.x, boundsSize.y), boundsSize.z);
-        currentAsteroid.collisionRadius = maxDim * 0.5f;
+    AsteroidStore asteroids;
+    if (GetMeshPoolVariantCount(meshPool) == 0)
+    {
+        TraceLog(LOG_WARNING, "Mesh pool is empty, no asteroids generated.");
+        return asteroids;
+    }
+    if (asteroidCount <= 0)
+        return asteroids;
 
-        currentAsteroid.isActive = true;
-        currentAsteroid.hitPoints = INITIAL_HIT_POINTS;
-        currentAsteroid.isShaking = false;
-        currentAsteroid.shakeTimer = 0.0f;
-        currentAsteroid.shakeIntensity = SHAKE_MAGNITUDE_BASE * sizeMultiplier;
+    std::vector<Vector3> clusterCenters(clusterCount);
 
-        asteroids.push_back(currentAsteroid);
+    // Generate cluster centers
+    for (int i = 0; i < clusterCount; ++i)
+    {
+        clusterCenters[i].x = rng.Range(-spread, spread);
+        clusterCenters[i].y = rng.Range(-spread, spread);
+        clusterCenters[i].z = rng.Range(-spread, spread);
     }
 
-    TraceLog(LOG_INFO, "Generated %d asteroids.", (int)asteroids.size());
+    // Generate asteroids. Asteroid i draws from its own stream (seed, i), so the field is
+    // identical for any thread count and chunking.
+    uint64_t asteroidSeed = rng.NextUInt64();
+    asteroids.Resize(asteroidCount);
+    AsteroidStore *store = &asteroids;
+    const AsteroidMeshPool *pool = &meshPool;
+    const Vector3 *centers = clusterCenters.data();
+    const FieldConfig *fieldConfig = &config;
+
+    RunGenerationJobs(jobs, (size_t)asteroidCount, FIELD_JOB_CHUNK, [=](size_t begin, size_t end)
+                      {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Rng asteroidRng(asteroidSeed, i);
+            int clusterIndex = asteroidRng.NextInt(clusterCount);
+            GenerateAsteroid(asteroidRng, centers[clusterIndex], *fieldConfig, *pool, *store, i);
+        } });
+
+    TraceLog(LOG_INFO, "Generated %d asteroids.", (int)asteroids.Size());
 
     return asteroids;
-}
\ No newline at end of file
+}
+
+BoundingBox GetAsteroidFieldBounds(const FieldConfig &config, float padding)
+{
+    using namespace AsteroidFieldConstants;
+
+    float maxPossibleAsteroidRadius = BASE_MESH_RADIUS * 3.0f;
+    float maxExtent = config.clusterSpreadRadius + config.scatterRadius + maxPossibleAsteroidRadius + padding;
+    return BoundingBox{{-maxExtent, -maxExtent, -maxExtent}, {maxExtent, maxExtent, maxExtent}};
+}
+
+//------------------------------------------------------------------------------------
+// Function Definitions for Streamed Sectors
+//------------------------------------------------------------------------------------
+uint64_t GetSectorSeed(uint64_t fieldSeed, int sx, int sy, int sz)
+{
+    // Fold each coordinate in with a different odd multiplier, then finalize (MurmurHash3 fmix64)
+    uint64_t h = fieldSeed;
+    h ^= (uint64_t)(uint32_t)sx * 0x9E3779B97F4A7C15ULL;
+    h ^= (uint64_t)(uint32_t)sy * 0xC2B2AE3D27D4EB4FULL;
+    h ^= (uint64_t)(uint32_t)sz * 0x165667B19E3779F9ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+int GenerateSectorAsteroids(const AsteroidMeshPool &meshPool, const FieldConfig &config, uint64_t fieldSeed, int sx, int sy,
+                            int sz, AsteroidStore &outAsteroids)
+{
+    using namespace AsteroidFieldConstants;
+
+    outAsteroids.Clear();
+    if (GetMeshPoolVariantCount(meshPool) == 0)
+        return 0;
+
+    Rng sectorRng(GetSectorSeed(fieldSeed, sx, sy, sz), RNG_STREAM_FIELD);
+    int clusterCount = sectorRng.NextInt(SECTOR_MAX_CLUSTERS + 1);
+
+    // Cluster centers keep the scatter radius from the sector faces, so asteroids rarely spill over
+    Vector3 sectorMin = {sx * SECTOR_SIZE, sy * SECTOR_SIZE, sz * SECTOR_SIZE};
+    float margin = fminf(config.scatterRadius, SECTOR_SIZE * 0.25f); // Large scatter still leaves room for the center
+    Vector3 clusterCenters[SECTOR_MAX_CLUSTERS];
+    int clusterSizes[SECTOR_MAX_CLUSTERS];
+    int asteroidCount = 0;
+    for (int c = 0; c < clusterCount; ++c)
+    {
+        clusterCenters[c].x = sectorMin.x + sectorRng.Range(margin, SECTOR_SIZE - margin);
+        clusterCenters[c].y = sectorMin.y + sectorRng.Range(margin, SECTOR_SIZE - margin);
+        clusterCenters[c].z = sectorMin.z + sectorRng.Range(margin, SECTOR_SIZE - margin);
+        clusterSizes[c] = SECTOR_CLUSTER_MIN_ASTEROIDS + sectorRng.NextInt(SECTOR_CLUSTER_MAX_ASTEROIDS - SECTOR_CLUSTER_MIN_ASTEROIDS + 1);
+        asteroidCount += clusterSizes[c];
+    }
+
+    uint64_t asteroidSeed = sectorRng.NextUInt64();
+    outAsteroids.Resize(asteroidCount);
+    int i = 0;
+    for (int c = 0; c < clusterCount; ++c)
+    {
+        for (int n = 0; n < clusterSizes[c]; ++n, ++i)
+        {
+            Rng asteroidRng(asteroidSeed, (uint64_t)i);
+            GenerateAsteroid(asteroidRng, clusterCenters[c], config, meshPool, outAsteroids, (size_t)i);
+        }
+    }
+    return asteroidCount;
+}
+
+BoundingBox GetStreamedFieldBounds()
+{
+    using namespace AsteroidFieldConstants;
+    return BoundingBox{{-STREAMED_WORLD_EXTENT, -STREAMED_WORLD_EXTENT, -STREAMED_WORLD_EXTENT},
+                       {STREAMED_WORLD_EXTENT, STREAMED_WORLD_EXTENT, STREAMED_WORLD_EXTENT}};
+}
@@ -4,9 +4,15 @@
 
 #include "raylib.h"
 #include <vector> // Required for std::vector
+#include <atomic>
+
+#include "asteroid_store.h" // Per-asteroid state (structure of arrays)
+#include "rng.h"            // Generators are passed in explicitly (no global rand state)
+#include "job_system.h"     // Optional parallel generation
+#include "field_config.h"   // Runtime generation parameters
 
 //------------------------------------------------------------------------------------
-// Constants for Asteroid Field Generation
+// Constants for Asteroid Field Generation (the tunable ones are FieldConfig defaults)
 //------------------------------------------------------------------------------------
 namespace AsteroidFieldConstants
 {
@@ -21,39 +27,81 @@ namespace AsteroidFieldConstants
     constexpr float BASE_MESH_RADIUS = 0.5f;
     constexpr float MESH_IRREGULARITY = 0.7f;
     constexpr float SHAKE_MAGNITUDE_BASE = 0.08f;
+    constexpr int NUM_MESH_VARIANTS = 24; // Shared meshes in the pool (asteroids pick one each)
+
+    // Level of detail: every variant is generated at each resolution below (finest first)
+    constexpr int NUM_LOD_LEVELS = 3;
+    constexpr int LOD_RINGS[NUM_LOD_LEVELS] = {12, 8, 5};
+    constexpr int LOD_SLICES[NUM_LOD_LEVELS] = {12, 8, 6};
+    constexpr int LOD_IMPOSTOR = NUM_LOD_LEVELS; // Level past the last mesh: drawn as a billboard
+
+    // Streamed (endless) field: space is split into cubic sectors, each generated on its own
+    constexpr float SECTOR_SIZE = 100.0f;
+    constexpr int SECTOR_MAX_CLUSTERS = 2;             // Clusters per sector are drawn from [0, max]
+    constexpr int SECTOR_CLUSTER_MIN_ASTEROIDS = 20;
+    constexpr int SECTOR_CLUSTER_MAX_ASTEROIDS = 32;
+    constexpr int SECTOR_MAX_ASTEROIDS = SECTOR_MAX_CLUSTERS * SECTOR_CLUSTER_MAX_ASTEROIDS;
+    constexpr float STREAMED_WORLD_EXTENT = 50000.0f; // Half size of the explorable box (float precision stays ~4 mm)
 } // namespace AsteroidFieldConstants
 
 //------------------------------------------------------------------------------------
-// Structure Definition for Asteroids
+// Shared Mesh Pool (a small set of variants reused by every asteroid)
 //------------------------------------------------------------------------------------
+// Meshes are stored variant-major: meshes[variant * lodCount + lod]. All LODs of a variant share
+// the same displacement (it is a function of direction), so switching levels keeps the silhouette.
 typedef struct
 {
-    Vector3 position;
-    Mesh mesh;          // Mesh data
-    Material material;  // Material (can share default, but allows customization)
-    Color color;        // Original color (used to tint material)
-    Color currentColor; // Current color (changes on collision/hit)
-    float rotationAngle;
-    Vector3 rotationAxis;
-    float rotationSpeed;
-    float collisionRadius; // Will be calculated from mesh bounds
-    bool isActive;
+    std::vector<Mesh> meshes; // Variant LOD meshes, uploaded to the GPU once
+    std::vector<float> radii; // Bounding radius of each variant at scale 1.0
+    int lodCount;
+} AsteroidMeshPool;
 
-    int hitPoints;
-    bool isShaking;
-    float shakeTimer;
-    float shakeIntensity;
+//------------------------------------------------------------------------------------
+// Function Declarations for the Mesh Pool
+//------------------------------------------------------------------------------------
+// Generate config.meshVariants variants (in parallel when jobs is given) and upload the whole pool
+// (blocking, main thread only)
+AsteroidMeshPool GenerateAsteroidMeshPool(const FieldConfig &config, Rng &rng, JobSystem *jobs = nullptr);
+// Generate the variants with all their LODs into CPU memory only (safe on a worker thread)
+int GenerateAsteroidMeshVariants(AsteroidMeshPool &pool, const FieldConfig &config, Rng &rng, JobSystem *jobs = nullptr,
+                                 std::atomic<int> *progress = nullptr);
+// Upload a CPU mesh from the pool to the GPU if it is not uploaded yet (main thread only)
+void UploadAsteroidMesh(Mesh &mesh);
+// Free GPU buffers (if uploaded) and CPU data of every mesh (main thread only)
+void UnloadAsteroidMeshPool(AsteroidMeshPool &pool);
+// Bytes of the meshes' vertex and index arrays in RAM (heap, or mapped from the field cache)
+size_t GetMeshPoolCpuMemory(const AsteroidMeshPool &pool);
+// Estimated VRAM of the uploaded meshes: position, texcoord and normal buffers plus the index buffer
+size_t GetMeshPoolGpuMemory(const AsteroidMeshPool &pool);
 
-} Asteroid;
+inline int GetMeshPoolVariantCount(const AsteroidMeshPool &pool) { return (int)pool.radii.size(); }
+inline int GetMeshPoolIndex(const AsteroidMeshPool &pool, int variant, int lod) { return variant * pool.lodCount + lod; }
+// Radius of a sphere that every variant mesh of this irregularity covers at LOD lod and scale 1.0
+// (the displacement is clamped, so it holds whatever the random lobes). Used for occluders.
+float GetAsteroidMeshInnerRadius(float irregularity, int lod);
 
 //------------------------------------------------------------------------------------
 // Function Declaration for Initializing Asteroids
 //------------------------------------------------------------------------------------
-std::vector<Asteroid> InitializeAsteroidField(Material defaultMaterial);
+// config.asteroidCount asteroids, placed in parallel when jobs is given (same result as the serial path)
+AsteroidStore InitializeAsteroidField(const AsteroidMeshPool &meshPool, Rng &rng, const FieldConfig &config,
+                                      JobSystem *jobs = nullptr);
+
+// World box that contains every asteroid the generator can place with config, grown by padding on each side
+BoundingBox GetAsteroidFieldBounds(const FieldConfig &config, float padding);
 
 //------------------------------------------------------------------------------------
-// Helper Function Declaration (Needed by main.cpp for shake effect, or other files)
+// Function Declarations for Streamed Sectors
 //------------------------------------------------------------------------------------
-float GetRandomFloat(float min, float max);
+// Sector (sx, sy, sz) covers [s * SECTOR_SIZE, (s + 1) * SECTOR_SIZE) on each axis. Its contents
+// depend only on the field seed and the coordinate, so a sector that is evicted and generated
+// again comes back identical. Safe on a worker thread (reads meshPool.radii only).
+uint64_t GetSectorSeed(uint64_t fieldSeed, int sx, int sy, int sz);
+// Fills outAsteroids with the sector's asteroids (at most SECTOR_MAX_ASTEROIDS), returns the count
+// (cluster sizes follow the sector constants, the asteroids themselves follow config)
+int GenerateSectorAsteroids(const AsteroidMeshPool &meshPool, const FieldConfig &config, uint64_t fieldSeed, int sx, int sy,
+                            int sz, AsteroidStore &outAsteroids);
+// World box the streamed field can place sectors in (the grid bounds of an endless game)
+BoundingBox GetStreamedFieldBounds();
 
 #endif // ASTEROID_FIELD_H
\ No newline at end of file
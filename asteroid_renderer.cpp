@@ -0,0 +1,511 @@
+#include "asteroid_renderer.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <vector>
+#include <algorithm> // For std::fill
+#include <cmath>     // For fmodf
+#include <cstdint>   // For uintptr_t
+
+//------------------------------------------------------------------------------------
+// Instancing Shader Source (GLSL 330, desktop)
+//------------------------------------------------------------------------------------
+static const char *instancingVertexShader =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    // Tint travels in the bottom row of the instance transform (m3, m7, m11)\n"
+    "    mat4 model = instanceTransform;\n"
+    "    fragColor = vec4(model[0][3], model[1][3], model[2][3], 1.0);\n"
+    "    model[0][3] = 0.0;\n"
+    "    model[1][3] = 0.0;\n"
+    "    model[2][3] = 0.0;\n"
+    "    gl_Position = mvp*model*vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *instancingFragmentShader =
+    "#version 330\n"
+    "in vec4 fragColor;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = fragColor*colDiffuse;\n"
+    "}\n";
+
+//------------------------------------------------------------------------------------
+// Animated Instancing Shader Source (GLSL 330, desktop)
+//------------------------------------------------------------------------------------
+// Attribute location of the per-instance asteroid index, past raylib's default locations (0-5)
+// so it never aliases an attribute of the mesh VAOs
+static const int INSTANCE_INDEX_LOCATION = 6;
+static const int INSTANCE_TEXELS = 4; // Texels per InstanceRecord
+static const int INSTANCES_PER_ROW = INSTANCE_TEXTURE_WIDTH / INSTANCE_TEXELS;
+
+static const char *animatedVertexShader =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "layout(location = 6) in float instanceIndex;\n"
+    "uniform mat4 mvp;\n"
+    "uniform float animationTime;\n"
+    "uniform sampler2D instanceData;\n"
+    "out vec4 fragColor;\n"
+    "vec4 FetchInstance(int index, int texel)\n"
+    "{\n"
+    "    int t = index*4 + texel;\n"
+    "    return texelFetch(instanceData, ivec2(t % 1024, t / 1024), 0);\n"
+    "}\n"
+    "void main()\n"
+    "{\n"
+    "    int index = int(instanceIndex + 0.5);\n"
+    "    vec4 placement = FetchInstance(index, 0);  // position, scale\n"
+    "    vec4 rotation = FetchInstance(index, 1);   // axis, degrees per second\n"
+    "    vec4 phaseTint = FetchInstance(index, 2);  // phase in degrees, tint\n"
+    "    vec3 offset = FetchInstance(index, 3).xyz; // shake\n"
+    "    // Rodrigues rotation, the same as MatrixRotate(axis, angle) on the CPU\n"
+    "    float angle = radians(phaseTint.x + rotation.w*animationTime);\n"
+    "    float c = cos(angle);\n"
+    "    float s = sin(angle);\n"
+    "    vec3 k = rotation.xyz;\n"
+    "    vec3 v = vertexPosition*placement.w;\n"
+    "    vec3 rotated = v*c + cross(k, v)*s + k*dot(k, v)*(1.0 - c);\n"
+    "    fragColor = vec4(phaseTint.yzw, 1.0);\n"
+    "    gl_Position = mvp*vec4(rotated + placement.xyz + offset, 1.0);\n"
+    "}\n";
+
+//------------------------------------------------------------------------------------
+// AsteroidRenderer Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+AsteroidRenderer::AsteroidRenderer()
+    : instancingAvailable(false), drawCalls(0), gpuAnimationAvailable(false), animationTimeLoc(-1),
+      instanceDataLoc(-1), instanceTexture(0), instanceRows(0), instanceEpoch(0.0), dirtyRowCount(0),
+      instanceRowUploads(0), indexBuffer(0), indexBufferSize(0)
+{
+    fallbackMaterial = LoadMaterialDefault();
+    instancedMaterial = LoadMaterialDefault();
+
+    instancingShader = LoadShaderFromMemory(instancingVertexShader, instancingFragmentShader);
+    if (IsShaderReady(instancingShader))
+    {
+        // DrawMeshInstanced binds the per-instance matrices to this attribute location
+        instancingShader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(instancingShader, "instanceTransform");
+        instancingAvailable = (instancingShader.locs[SHADER_LOC_MATRIX_MODEL] != -1);
+    }
+
+    // Soft round blob for far asteroids, tinted per impostor
+    Image impostorImage = GenImageGradientRadial(64, 64, 0.3f, WHITE, BLANK);
+    impostorTexture = LoadTextureFromImage(impostorImage);
+    UnloadImage(impostorImage);
+
+    if (instancingAvailable)
+    {
+        instancedMaterial.shader = instancingShader;
+        TraceLog(LOG_INFO, "AsteroidRenderer: Instanced rendering enabled");
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "AsteroidRenderer: Instancing shader unavailable, using DrawMesh fallback");
+    }
+
+    // Same fragment stage, the vertex stage animates from the instance texture
+    animatedShader = LoadShaderFromMemory(animatedVertexShader, instancingFragmentShader);
+    if (instancingAvailable && IsShaderReady(animatedShader))
+    {
+        animationTimeLoc = GetShaderLocation(animatedShader, "animationTime");
+        instanceDataLoc = GetShaderLocation(animatedShader, "instanceData");
+        gpuAnimationAvailable = (animationTimeLoc != -1 && instanceDataLoc != -1 && animatedShader.locs[SHADER_LOC_MATRIX_MVP] != -1);
+    }
+    if (gpuAnimationAvailable)
+        TraceLog(LOG_INFO, "AsteroidRenderer: GPU rotation animation enabled");
+    else
+        TraceLog(LOG_WARNING, "AsteroidRenderer: Animated instancing shader unavailable, rotations stay on the CPU");
+}
+
+// Destructor
+AsteroidRenderer::~AsteroidRenderer()
+{
+    // UnloadMaterial also unloads a non-default shader, so only unload it directly when unused
+    if (!instancingAvailable && IsShaderReady(instancingShader))
+        UnloadShader(instancingShader);
+    UnloadMaterial(instancedMaterial);
+    UnloadMaterial(fallbackMaterial);
+    UnloadTexture(impostorTexture);
+    if (IsShaderReady(animatedShader))
+        UnloadShader(animatedShader);
+    if (instanceTexture != 0)
+        rlUnloadTexture(instanceTexture);
+    if (indexBuffer != 0)
+        rlUnloadVertexBuffer(indexBuffer);
+}
+
+void AsteroidRenderer::BeginFrame(int meshCount, FrameArena *frameArena)
+{
+    if ((int)meshTransforms.size() != meshCount)
+    {
+        meshTransforms.resize(meshCount);
+        meshAnimated.resize(meshCount);
+    }
+
+    if (frameArena != nullptr)
+    {
+        // Last frame's buffers were released with the arena, nothing to free
+        for (size_t i = 0; i < meshTransforms.size(); ++i)
+        {
+            meshTransforms[i] = MakeFrameVector<Matrix>(frameArena);
+            meshAnimated[i] = MakeFrameVector<float>(frameArena);
+        }
+        impostors = MakeFrameVector<Impostor>(frameArena);
+        return;
+    }
+    for (size_t i = 0; i < meshTransforms.size(); ++i)
+    {
+        meshTransforms[i].clear(); // Keeps capacity, no reallocation in steady state
+        meshAnimated[i].clear();
+    }
+    impostors.clear();
+}
+
+void AsteroidRenderer::Submit(int meshIndex, Matrix transform, Color tint)
+{
+    if (meshIndex < 0 || meshIndex >= (int)meshTransforms.size())
+        return;
+
+    // Pack tint into the unused projective row, the shader restores it to (0, 0, 0, 1)
+    transform.m3 = tint.r / 255.0f;
+    transform.m7 = tint.g / 255.0f;
+    transform.m11 = tint.b / 255.0f;
+    meshTransforms[meshIndex].push_back(transform);
+}
+
+void AsteroidRenderer::SubmitImpostor(Vector3 position, float size, Color tint)
+{
+    impostors.push_back((Impostor){position, size, tint});
+}
+
+void AsteroidRenderer::SubmitAnimated(int meshIndex, int asteroidIndex)
+{
+    if (meshIndex < 0 || meshIndex >= (int)meshAnimated.size() || asteroidIndex < 0 || asteroidIndex >= (int)instances.size())
+        return;
+    meshAnimated[meshIndex].push_back((float)asteroidIndex); // Exact up to 2^24, above INSTANCE_TEXTURE_MAX_ROWS
+}
+
+void AsteroidRenderer::Flush(const AsteroidMeshPool &meshPool, const Camera3D &camera, bool useInstancing, double animationTime)
+{
+    drawCalls = 0;
+    instanceRowUploads = 0;
+    size_t meshCount = meshTransforms.size();
+    if (meshPool.meshes.size() < meshCount)
+        meshCount = meshPool.meshes.size();
+
+    if (instanceTexture != 0)
+    {
+        if (animationTime - instanceEpoch > INSTANCE_EPOCH_SECONDS)
+            RebaseInstances(animationTime);
+        UploadDirtyRows();
+        if (useInstancing)
+            DrawAnimated(meshPool, meshCount, (float)(animationTime - instanceEpoch));
+    }
+
+    for (size_t v = 0; v < meshCount; ++v)
+    {
+        FrameVector<Matrix> &transforms = meshTransforms[v];
+        if (transforms.empty())
+            continue;
+
+        if (useInstancing && instancingAvailable)
+        {
+            DrawMeshInstanced(meshPool.meshes[v], instancedMaterial, transforms.data(), (int)transforms.size());
+            drawCalls++;
+            continue;
+        }
+
+        // Fallback: one draw per asteroid, unpack the tint into the material color
+        for (size_t i = 0; i < transforms.size(); ++i)
+        {
+            Matrix transform = transforms[i];
+            fallbackMaterial.maps[MATERIAL_MAP_DIFFUSE].color = (Color){
+                (unsigned char)(transform.m3 * 255.0f + 0.5f),
+                (unsigned char)(transform.m7 * 255.0f + 0.5f),
+                (unsigned char)(transform.m11 * 255.0f + 0.5f), 255};
+            transform.m3 = 0.0f;
+            transform.m7 = 0.0f;
+            transform.m11 = 0.0f;
+            DrawMesh(meshPool.meshes[v], fallbackMaterial, transform);
+            drawCalls++;
+        }
+    }
+
+    // Impostors go through the rlgl batch: same texture, so one draw unless the batch fills up
+    for (size_t i = 0; i < impostors.size(); ++i)
+        DrawBillboard(camera, impostorTexture, impostors[i].position, impostors[i].size, impostors[i].tint);
+    if (!impostors.empty())
+        drawCalls++;
+}
+
+//------------------------------------------------------------------------------------
+// GPU Animation
+//------------------------------------------------------------------------------------
+
+// Angle in degrees at time seconds after the instance epoch, within [0, 360)
+static float WrapAngle(float phase, float speed, double time)
+{
+    float angle = fmodf((float)(phase + speed * time), 360.0f);
+    return (angle < 0.0f) ? angle + 360.0f : angle;
+}
+
+// Record of asteroid i, whose rotation angle is current sinceEpoch seconds after the epoch
+AsteroidRenderer::InstanceRecord AsteroidRenderer::MakeInstanceRecord(const AsteroidStore &asteroids, size_t i, double sinceEpoch)
+{
+    const AsteroidColdData &cold = asteroids.cold[i];
+    Color tint = asteroids.currentColors[i];
+    InstanceRecord record;
+    record.position = asteroids.positions[i];
+    record.scale = cold.scale;
+    record.rotationAxis = Vector3Normalize(cold.rotationAxis);
+    record.rotationSpeed = asteroids.rotationSpeeds[i];
+    record.phase = WrapAngle(asteroids.rotationAngles[i], -record.rotationSpeed, sinceEpoch);
+    record.tint[0] = tint.r / 255.0f;
+    record.tint[1] = tint.g / 255.0f;
+    record.tint[2] = tint.b / 255.0f;
+    record.offset = Vector3{0.0f, 0.0f, 0.0f};
+    record.padding = 0.0f;
+    return record;
+}
+
+void AsteroidRenderer::UploadInstances(const AsteroidStore &asteroids, double animationTime)
+{
+    if (!gpuAnimationAvailable)
+        return;
+
+    int rows = (int)((asteroids.Size() + INSTANCES_PER_ROW - 1) / INSTANCES_PER_ROW);
+    if (rows < 1)
+        rows = 1;
+    if (rows > INSTANCE_TEXTURE_MAX_ROWS)
+    {
+        TraceLog(LOG_WARNING, "AsteroidRenderer: %zu asteroids exceed the instance texture, rotations stay on the CPU", asteroids.Size());
+        gpuAnimationAvailable = false;
+        return;
+    }
+
+    instanceEpoch = animationTime;
+    instances.assign((size_t)rows * INSTANCES_PER_ROW, InstanceRecord()); // Whole rows, the texture is uploaded by row
+    for (size_t i = 0; i < asteroids.Size(); ++i)
+        instances[i] = MakeInstanceRecord(asteroids, i, 0.0);
+    dirtyRows.assign(rows, 0);
+    dirtyRowCount = 0;
+
+    if (instanceTexture != 0 && rows != instanceRows)
+    {
+        rlUnloadTexture(instanceTexture);
+        instanceTexture = 0;
+    }
+    instanceRows = rows;
+    if (instanceTexture != 0)
+    {
+        rlUpdateTexture(instanceTexture, 0, 0, INSTANCE_TEXTURE_WIDTH, rows, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, instances.data());
+        return;
+    }
+
+    instanceTexture = rlLoadTexture(instances.data(), INSTANCE_TEXTURE_WIDTH, rows, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+    if (instanceTexture == 0)
+    {
+        TraceLog(LOG_WARNING, "AsteroidRenderer: Float textures unsupported, rotations stay on the CPU");
+        gpuAnimationAvailable = false;
+        instances.clear();
+        return;
+    }
+    rlTextureParameters(instanceTexture, RL_TEXTURE_MIN_FILTER, RL_TEXTURE_FILTER_NEAREST);
+    rlTextureParameters(instanceTexture, RL_TEXTURE_MAG_FILTER, RL_TEXTURE_FILTER_NEAREST);
+    TraceLog(LOG_INFO, "AsteroidRenderer: Instance texture %dx%d for %zu asteroids", INSTANCE_TEXTURE_WIDTH, rows, asteroids.Size());
+}
+
+void AsteroidRenderer::UpdateInstances(const AsteroidStore &asteroids, size_t begin, size_t end, double animationTime)
+{
+    if (end > asteroids.Size())
+        end = asteroids.Size();
+    if (end > instances.size())
+        end = instances.size();
+    for (size_t i = begin; i < end; ++i)
+    {
+        instances[i] = MakeInstanceRecord(asteroids, i, animationTime - instanceEpoch);
+        MarkDirty((int)i);
+    }
+}
+
+void AsteroidRenderer::SetInstanceTint(int asteroidIndex, Color tint)
+{
+    if (asteroidIndex < 0 || asteroidIndex >= (int)instances.size())
+        return;
+    InstanceRecord &record = instances[asteroidIndex];
+    float r = tint.r / 255.0f, g = tint.g / 255.0f, b = tint.b / 255.0f;
+    if (record.tint[0] == r && record.tint[1] == g && record.tint[2] == b)
+        return;
+    record.tint[0] = r;
+    record.tint[1] = g;
+    record.tint[2] = b;
+    MarkDirty(asteroidIndex);
+}
+
+void AsteroidRenderer::SetInstanceOffset(int asteroidIndex, Vector3 offset)
+{
+    if (asteroidIndex < 0 || asteroidIndex >= (int)instances.size())
+        return;
+    InstanceRecord &record = instances[asteroidIndex];
+    if (record.offset.x == offset.x && record.offset.y == offset.y && record.offset.z == offset.z)
+        return;
+    record.offset = offset;
+    MarkDirty(asteroidIndex);
+}
+
+void AsteroidRenderer::ReadBackRotations(AsteroidStore &asteroids, double animationTime) const
+{
+    size_t count = (asteroids.Size() < instances.size()) ? asteroids.Size() : instances.size();
+    for (size_t i = 0; i < count; ++i)
+        asteroids.rotationAngles[i] = WrapAngle(instances[i].phase, instances[i].rotationSpeed, animationTime - instanceEpoch);
+}
+
+size_t AsteroidRenderer::GetMemoryUsage() const
+{
+    size_t bytes = instances.capacity() * sizeof(InstanceRecord) + dirtyRows.capacity();
+    for (const FrameVector<Matrix> &bucket : meshTransforms)
+    {
+        if (bucket.get_allocator().GetArena() == nullptr) // Arena memory is counted by the arena
+            bytes += bucket.capacity() * sizeof(Matrix);
+    }
+    for (const FrameVector<float> &bucket : meshAnimated)
+    {
+        if (bucket.get_allocator().GetArena() == nullptr)
+            bytes += bucket.capacity() * sizeof(float);
+    }
+    if (impostors.get_allocator().GetArena() == nullptr)
+        bytes += impostors.capacity() * sizeof(Impostor);
+    return bytes;
+}
+
+size_t AsteroidRenderer::GetGpuMemoryUsage() const
+{
+    size_t bytes = (size_t)impostorTexture.width * impostorTexture.height * 4; // RGBA8
+    if (instanceTexture != 0)
+        bytes += (size_t)INSTANCE_TEXTURE_WIDTH * instanceRows * sizeof(float) * 4; // RGBA32F
+    if (indexBuffer != 0)
+        bytes += indexBufferSize;
+    return bytes;
+}
+
+void AsteroidRenderer::MarkDirty(int asteroidIndex)
+{
+    int row = asteroidIndex / INSTANCES_PER_ROW;
+    if (!dirtyRows[row])
+    {
+        dirtyRows[row] = 1;
+        dirtyRowCount++;
+    }
+}
+
+// Upload each run of consecutive dirty rows with one texture update
+void AsteroidRenderer::UploadDirtyRows()
+{
+    if (dirtyRowCount == 0)
+        return;
+    for (int row = 0; row < instanceRows;)
+    {
+        if (!dirtyRows[row])
+        {
+            row++;
+            continue;
+        }
+        int runEnd = row;
+        while (runEnd < instanceRows && dirtyRows[runEnd])
+            dirtyRows[runEnd++] = 0;
+        rlUpdateTexture(instanceTexture, 0, row, INSTANCE_TEXTURE_WIDTH, runEnd - row, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32,
+                        &instances[(size_t)row * INSTANCES_PER_ROW]);
+        instanceRowUploads += runEnd - row;
+        row = runEnd;
+    }
+    dirtyRowCount = 0;
+}
+
+// Float time loses precision as it grows: fold the elapsed rotation into the phases now and then
+void AsteroidRenderer::RebaseInstances(double animationTime)
+{
+    double elapsed = animationTime - instanceEpoch;
+    for (size_t i = 0; i < instances.size(); ++i)
+        instances[i].phase = WrapAngle(instances[i].phase, instances[i].rotationSpeed, elapsed);
+    instanceEpoch = animationTime;
+    rlUpdateTexture(instanceTexture, 0, 0, INSTANCE_TEXTURE_WIDTH, instanceRows, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, instances.data());
+    std::fill(dirtyRows.begin(), dirtyRows.end(), (unsigned char)0);
+    dirtyRowCount = 0;
+    instanceRowUploads += instanceRows;
+}
+
+// One instanced draw per bucket, every bucket's indices uploaded into one buffer first
+void AsteroidRenderer::DrawAnimated(const AsteroidMeshPool &meshPool, size_t meshCount, float time)
+{
+    size_t total = 0;
+    for (size_t v = 0; v < meshCount; ++v)
+        total += meshAnimated[v].size();
+    if (total == 0)
+        return;
+
+    size_t bytes = total * sizeof(float);
+    if (bytes > indexBufferSize)
+    {
+        if (indexBuffer != 0)
+            rlUnloadVertexBuffer(indexBuffer);
+        indexBufferSize = (bytes > 2 * indexBufferSize) ? bytes : 2 * indexBufferSize;
+        indexBuffer = rlLoadVertexBuffer(nullptr, (int)indexBufferSize, true);
+    }
+    size_t offset = 0;
+    for (size_t v = 0; v < meshCount; ++v)
+    {
+        const FrameVector<float> &indices = meshAnimated[v];
+        if (indices.empty())
+            continue;
+        rlUpdateVertexBuffer(indexBuffer, indices.data(), (int)(indices.size() * sizeof(float)), (int)offset);
+        offset += indices.size() * sizeof(float);
+    }
+
+    // Same matrices DrawMesh would use with an identity model transform
+    Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+    int textureSlot = 0;
+    rlEnableShader(animatedShader.id);
+    rlSetUniformMatrix(animatedShader.locs[SHADER_LOC_MATRIX_MVP], mvp);
+    rlSetUniform(animationTimeLoc, &time, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlActiveTextureSlot(textureSlot);
+    rlEnableTexture(instanceTexture);
+    rlSetUniform(instanceDataLoc, &textureSlot, RL_SHADER_UNIFORM_SAMPLER2D, 1);
+
+    offset = 0;
+    for (size_t v = 0; v < meshCount; ++v)
+    {
+        size_t count = meshAnimated[v].size();
+        if (count == 0)
+            continue;
+        const Mesh &mesh = meshPool.meshes[v];
+        if (rlEnableVertexArray(mesh.vaoId))
+        {
+            rlEnableVertexBuffer(indexBuffer);
+            rlSetVertexAttribute(INSTANCE_INDEX_LOCATION, 1, RL_FLOAT, false, 0, (const void *)(uintptr_t)offset);
+            rlEnableVertexAttribute(INSTANCE_INDEX_LOCATION);
+            rlSetVertexAttributeDivisor(INSTANCE_INDEX_LOCATION, 1);
+            if (mesh.indices != nullptr)
+                rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount * 3, 0, (int)count);
+            else
+                rlDrawVertexArrayInstanced(0, mesh.vertexCount, (int)count);
+            rlDisableVertexAttribute(INSTANCE_INDEX_LOCATION); // Other shaders draw this VAO too
+            drawCalls++;
+        }
+        offset += count * sizeof(float);
+    }
+
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableTexture();
+    rlDisableShader();
+}
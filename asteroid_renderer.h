@@ -0,0 +1,120 @@
+#ifndef ASTEROID_RENDERER_H
+#define ASTEROID_RENDERER_H
+
+#include "raylib.h"
+#include <vector>
+
+#include "asteroid_field.h" // For AsteroidMeshPool
+#include "asteroid_store.h"
+#include "frame_arena.h"
+
+//------------------------------------------------------------------------------------
+// Asteroid Renderer
+//------------------------------------------------------------------------------------
+// Collects per-frame asteroid transforms into one bucket per pool mesh (variant + LOD)
+// and draws each bucket with a single DrawMeshInstanced call. The per-instance tint is
+// packed into the unused bottom row of the affine transform, so no extra vertex buffer
+// is needed. Falls back to one DrawMesh per asteroid when instancing is unavailable.
+// Asteroids past the last LOD are drawn as billboards sharing one radial gradient
+// texture, which rlgl batches into a single draw.
+//
+// GPU animation path: the static part of every asteroid (position, scale, rotation axis,
+// speed and phase, plus its tint and shake offset) lives in a float texture, one row of
+// texels per INSTANCE_TEXTURE_WIDTH / 4 asteroids, and the vertex shader builds the rotation
+// from a time uniform. A frame then uploads one float per drawn asteroid (its index) and
+// only the texture rows of asteroids whose tint or offset changed; no matrices are built.
+constexpr int INSTANCE_TEXTURE_WIDTH = 1024;     // Texels per row (4 per asteroid), matches the shader
+constexpr int INSTANCE_TEXTURE_MAX_ROWS = 4096;  // 1M asteroids, beyond that the matrix path is used
+constexpr double INSTANCE_EPOCH_SECONDS = 600.0; // Phases are rebased this often to keep float time precise
+
+class AsteroidRenderer
+{
+public:
+    AsteroidRenderer();  // Loads the instancing shader and impostor texture (requires an open window)
+    ~AsteroidRenderer(); // Unloads shader, texture and materials (call before CloseWindow)
+
+    bool IsInstancingAvailable() const { return instancingAvailable; }
+    bool IsGpuAnimationAvailable() const { return gpuAnimationAvailable; }
+
+    // Clear all buckets. With a frame arena they are rebound to it (drawn from until its next
+    // Reset), without one they keep their heap capacity for the next frame.
+    void BeginFrame(int meshCount, FrameArena *frameArena = nullptr);
+    // Queue one asteroid for drawing with pool mesh meshIndex (see GetMeshPoolIndex)
+    void Submit(int meshIndex, Matrix transform, Color tint);
+    // Queue one far asteroid as a camera-facing billboard of the given world size
+    void SubmitImpostor(Vector3 position, float size, Color tint);
+    // Queue one asteroid for the GPU animation path (its instance must have been uploaded)
+    void SubmitAnimated(int meshIndex, int asteroidIndex);
+    // Draw everything queued since BeginFrame (must be inside BeginMode3D). animationTime is the
+    // rotation clock of the animated asteroids, the one passed to UploadInstances.
+    void Flush(const AsteroidMeshPool &meshPool, const Camera3D &camera, bool useInstancing, double animationTime = 0.0);
+
+    // GPU animation instance table. UploadInstances (re)builds it for the whole store, whose
+    // rotation angles are current at animationTime; UpdateInstances refreshes [begin, end) after
+    // those asteroids were replaced (streamed sectors), with angles current at animationTime.
+    // Both keep the store's current colors as tints, with no offset.
+    void UploadInstances(const AsteroidStore &asteroids, double animationTime);
+    void UpdateInstances(const AsteroidStore &asteroids, size_t begin, size_t end, double animationTime);
+    // Per-frame state of one asteroid, its texture row is re-uploaded only if the value changed
+    void SetInstanceTint(int asteroidIndex, Color tint);
+    void SetInstanceOffset(int asteroidIndex, Vector3 offset);
+    // Write the animated rotation angles at animationTime back to the store (before going back to CPU transforms)
+    void ReadBackRotations(AsteroidStore &asteroids, double animationTime) const;
+    int GetInstanceRowUploads() const { return instanceRowUploads; } // Texture rows patched by the last Flush
+
+    int GetDrawCallCount() const { return drawCalls; }
+    int GetImpostorCount() const { return (int)impostors.size(); }
+    size_t GetMemoryUsage() const;    // CPU copy of the instance table, dirty rows and heap-backed buckets
+    size_t GetGpuMemoryUsage() const; // Estimated VRAM: instance texture, index buffer, impostor texture
+
+private:
+    Shader instancingShader;
+    Material instancedMaterial; // Uses instancingShader
+    Material fallbackMaterial;  // Default raylib shader, tinted per DrawMesh
+    bool instancingAvailable;
+    int drawCalls;
+    std::vector<FrameVector<Matrix>> meshTransforms; // One transform bucket per pool mesh
+    std::vector<FrameVector<float>> meshAnimated;    // Asteroid indices per pool mesh (GPU animation path)
+
+    // GPU animation
+    typedef struct
+    {
+        Vector3 position;
+        float scale;
+        Vector3 rotationAxis; // Normalized
+        float rotationSpeed;  // Degrees per second
+        float phase;          // Degrees at instanceEpoch
+        float tint[3];
+        Vector3 offset;       // Shake
+        float padding;
+    } InstanceRecord;         // 4 RGBA32F texels
+    static InstanceRecord MakeInstanceRecord(const AsteroidStore &asteroids, size_t index, double sinceEpoch);
+    void MarkDirty(int asteroidIndex);
+    void UploadDirtyRows();
+    void RebaseInstances(double animationTime);
+    void DrawAnimated(const AsteroidMeshPool &meshPool, size_t meshCount, float time);
+    Shader animatedShader;
+    bool gpuAnimationAvailable;
+    int animationTimeLoc;
+    int instanceDataLoc;
+    unsigned int instanceTexture;          // 0 until UploadInstances
+    int instanceRows;                      // Texture height
+    std::vector<InstanceRecord> instances; // CPU copy of the texture, whole rows
+    double instanceEpoch;                  // animationTime the phases refer to
+    std::vector<unsigned char> dirtyRows;  // 1 if the row waits for upload
+    int dirtyRowCount;
+    int instanceRowUploads;
+    unsigned int indexBuffer; // Per-instance asteroid indices of all buckets, refilled every frame
+    size_t indexBufferSize;   // Bytes
+
+    typedef struct
+    {
+        Vector3 position;
+        float size;
+        Color tint;
+    } Impostor;
+    Texture2D impostorTexture;
+    FrameVector<Impostor> impostors;
+};
+
+#endif // ASTEROID_RENDERER_H
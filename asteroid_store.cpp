@@ -0,0 +1,85 @@
+#include "asteroid_store.h"
+#include <vector>
+
+//------------------------------------------------------------------------------------
+// AsteroidStore Class - Implementation
+//------------------------------------------------------------------------------------
+
+void AsteroidStore::Clear()
+{
+    positions.clear();
+    collisionRadii.clear();
+    rotationAngles.clear();
+    rotationSpeeds.clear();
+    shakeTimers.clear();
+    hitPoints.clear();
+    flags.clear();
+    currentColors.clear();
+    lodLevels.clear();
+    cold.clear();
+}
+
+void AsteroidStore::Reserve(size_t count)
+{
+    positions.reserve(count);
+    collisionRadii.reserve(count);
+    rotationAngles.reserve(count);
+    rotationSpeeds.reserve(count);
+    shakeTimers.reserve(count);
+    hitPoints.reserve(count);
+    flags.reserve(count);
+    currentColors.reserve(count);
+    lodLevels.reserve(count);
+    cold.reserve(count);
+}
+
+size_t AsteroidStore::GetMemoryUsage() const
+{
+    return positions.capacity() * sizeof(Vector3) + collisionRadii.capacity() * sizeof(float) +
+           rotationAngles.capacity() * sizeof(float) + rotationSpeeds.capacity() * sizeof(float) +
+           shakeTimers.capacity() * sizeof(float) + hitPoints.capacity() * sizeof(int) + flags.capacity() +
+           currentColors.capacity() * sizeof(Color) + lodLevels.capacity() + cold.capacity() * sizeof(AsteroidColdData);
+}
+
+int AsteroidStore::Add(Vector3 position, float collisionRadius, float rotationAngle, float rotationSpeed, int initialHitPoints, const AsteroidColdData &coldData)
+{
+    positions.push_back(position);
+    collisionRadii.push_back(collisionRadius);
+    rotationAngles.push_back(rotationAngle);
+    rotationSpeeds.push_back(rotationSpeed);
+    shakeTimers.push_back(0.0f);
+    hitPoints.push_back(initialHitPoints);
+    flags.push_back(ASTEROID_ACTIVE);
+    currentColors.push_back(coldData.color);
+    lodLevels.push_back(0);
+    cold.push_back(coldData);
+    return (int)positions.size() - 1;
+}
+
+void AsteroidStore::Resize(size_t count)
+{
+    positions.resize(count, Vector3{0.0f, 0.0f, 0.0f});
+    collisionRadii.resize(count, 0.0f);
+    rotationAngles.resize(count, 0.0f);
+    rotationSpeeds.resize(count, 0.0f);
+    shakeTimers.resize(count, 0.0f);
+    hitPoints.resize(count, 0);
+    flags.resize(count, 0);
+    currentColors.resize(count, BLANK);
+    lodLevels.resize(count, 0);
+    cold.resize(count, AsteroidColdData{0});
+}
+
+void AsteroidStore::Set(size_t i, Vector3 position, float collisionRadius, float rotationAngle, float rotationSpeed, int initialHitPoints, const AsteroidColdData &coldData)
+{
+    positions[i] = position;
+    collisionRadii[i] = collisionRadius;
+    rotationAngles[i] = rotationAngle;
+    rotationSpeeds[i] = rotationSpeed;
+    shakeTimers[i] = 0.0f;
+    hitPoints[i] = initialHitPoints;
+    flags[i] = ASTEROID_ACTIVE;
+    currentColors[i] = coldData.color;
+    lodLevels[i] = 0;
+    cold[i] = coldData;
+}
@@ -0,0 +1,70 @@
+#ifndef ASTEROID_STORE_H
+#define ASTEROID_STORE_H
+
+#include "raylib.h"
+#include <vector>
+
+//------------------------------------------------------------------------------------
+// Asteroid State Flags (stored per asteroid in AsteroidStore::flags)
+//------------------------------------------------------------------------------------
+enum AsteroidFlags : unsigned char
+{
+    ASTEROID_ACTIVE = 1 << 0,  // Asteroid exists (not destroyed)
+    ASTEROID_SHAKING = 1 << 1, // Hit effect running (shakeTimers is counting down)
+};
+
+//------------------------------------------------------------------------------------
+// Cold Per-Asteroid Data (read when drawing or spawning effects, never by the updates)
+//------------------------------------------------------------------------------------
+typedef struct
+{
+    int variantIndex;     // Index into AsteroidMeshPool::meshes
+    float scale;          // Uniform scale applied to the variant mesh
+    Vector3 rotationAxis; // Normalized spin axis
+    Color color;          // Original color (restored after hits/collisions)
+    float shakeIntensity; // Max shake offset while ASTEROID_SHAKING is set
+} AsteroidColdData;
+
+//------------------------------------------------------------------------------------
+// Asteroid Store - Structure of Arrays
+//------------------------------------------------------------------------------------
+// Every hot field lives in its own contiguous array so the per-frame loops only
+// stream the data they actually touch. All arrays are indexed by asteroid id and
+// always have the same length.
+class AsteroidStore
+{
+public:
+    // Hot data (touched by per-frame update, collision and culling loops)
+    std::vector<Vector3> positions;
+    std::vector<float> collisionRadii;
+    std::vector<float> rotationAngles; // Degrees, kept in [0, 360)
+    std::vector<float> rotationSpeeds; // Degrees per second
+    std::vector<float> shakeTimers;
+    std::vector<int> hitPoints;
+    std::vector<unsigned char> flags; // AsteroidFlags bitmask
+    std::vector<Color> currentColors; // Current tint (changes on collision/hit)
+    std::vector<unsigned char> lodLevels; // Mesh LOD picked by culling (kept for hysteresis)
+
+    // Cold data
+    std::vector<AsteroidColdData> cold;
+
+    size_t Size() const { return positions.size(); }
+    bool Empty() const { return positions.empty(); }
+
+    bool IsActive(size_t i) const { return (flags[i] & ASTEROID_ACTIVE) != 0; }
+    bool IsShaking(size_t i) const { return (flags[i] & ASTEROID_SHAKING) != 0; }
+
+    void Clear();
+    void Reserve(size_t count);
+    size_t GetMemoryUsage() const; // Bytes reserved by all arrays (capacity, not size)
+    // Grow or shrink every array to count asteroids (new entries are inactive until Set)
+    void Resize(size_t count);
+
+    // Appends an active asteroid at full hit points and returns its index
+    int Add(Vector3 position, float collisionRadius, float rotationAngle, float rotationSpeed, int initialHitPoints, const AsteroidColdData &coldData);
+    // Overwrites asteroid i with the same initial state Add would give it (i < Size(); safe
+    // to call from several threads for different indices)
+    void Set(size_t i, Vector3 position, float collisionRadius, float rotationAngle, float rotationSpeed, int initialHitPoints, const AsteroidColdData &coldData);
+};
+
+#endif // ASTEROID_STORE_H
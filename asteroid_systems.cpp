@@ -0,0 +1,145 @@
+#include "asteroid_systems.h"
+#include "raymath.h"
+#include "rlgl.h" // For RL_CULL_DISTANCE_NEAR
+#include <cmath>
+
+//------------------------------------------------------------------------------------
+// Per-Frame Asteroid Systems - Implementation
+//------------------------------------------------------------------------------------
+// Job lambdas capture raw array pointers (and small values) by copy, so they stay
+// valid after these functions return. Every chunk writes only its own index range.
+
+void UpdateAsteroidRotations(AsteroidStore &asteroids, float deltaTime, JobSystem &jobs)
+{
+    const unsigned char *flags = asteroids.flags.data();
+    float *rotationAngles = asteroids.rotationAngles.data();
+    const float *rotationSpeeds = asteroids.rotationSpeeds.data();
+
+    jobs.ParallelFor(asteroids.Size(), ASTEROID_JOB_CHUNK, [=](size_t begin, size_t end)
+                     {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!(flags[i] & ASTEROID_ACTIVE))
+                continue;
+            rotationAngles[i] += rotationSpeeds[i] * deltaTime;
+            // Keep angle within 0-360 range
+            while (rotationAngles[i] >= 360.0f)
+                rotationAngles[i] -= 360.0f;
+            while (rotationAngles[i] < 0.0f)
+                rotationAngles[i] += 360.0f;
+        } });
+}
+
+CullView GetCullView(Camera3D camera, int screenWidth, int screenHeight, float farPlane)
+{
+    CullView view;
+    float aspect = (screenHeight > 0) ? (float)screenWidth / (float)screenHeight : 1.0f;
+    view.frustum = GetCameraFrustum(camera, aspect, (float)RL_CULL_DISTANCE_NEAR, farPlane);
+    view.cameraPosition = camera.position;
+    view.pixelsPerUnit = (float)screenHeight / (2.0f * tanf(camera.fovy * DEG2RAD * 0.5f));
+    view.rotationTimeOffset = 0.0f;
+    view.buildTransforms = true;
+    return view;
+}
+
+// Pick the LOD for a projected size, moving from the current level only past the hysteresis band
+static inline int SelectLodLevel(int currentLevel, float pixelSize)
+{
+    using namespace AsteroidFieldConstants;
+    int level = (currentLevel > LOD_IMPOSTOR) ? LOD_IMPOSTOR : currentLevel;
+    while (level > 0 && pixelSize > LOD_MIN_PIXEL_SIZE[level - 1] * (1.0f + LOD_HYSTERESIS))
+        level--; // Finer
+    while (level < LOD_IMPOSTOR && pixelSize < LOD_MIN_PIXEL_SIZE[level] * (1.0f - LOD_HYSTERESIS))
+        level++; // Coarser
+    return level;
+}
+
+AsteroidCullResult CreateAsteroidCullResult(FrameArena *arena)
+{
+    AsteroidCullResult result = {MakeFrameVector<int>(arena), MakeFrameVector<unsigned char>(arena),
+                                 MakeFrameVector<Matrix>(arena), 0, CullView(), MakeFrameVector<int>(arena)};
+    return result;
+}
+
+void CullAsteroids(AsteroidStore &asteroids, const CullView &view, SpatialIndex *index, CullMode mode,
+                   AsteroidCullResult &result, JobSystem &jobs)
+{
+    FrameVector<int> &candidates = result.candidates;
+    if (mode == CULL_MODE_GRID && index != nullptr)
+    {
+        // Destroyed asteroids are already removed from the index
+        index->QueryFrustum(view.frustum, candidates, result.intersectingScratch);
+        result.insideCount = candidates.size();
+        candidates.insert(candidates.end(), result.intersectingScratch.begin(), result.intersectingScratch.end());
+    }
+    else
+    {
+        candidates.resize(asteroids.Size());
+        for (size_t i = 0; i < candidates.size(); ++i)
+            candidates[i] = (int)i;
+        result.insideCount = 0;
+    }
+
+    size_t count = candidates.size();
+    if (result.visible.size() < count)
+    {
+        result.visible.resize(count);
+        result.transforms.resize(count);
+    }
+
+    AsteroidStore *store = &asteroids;
+    AsteroidCullResult *out = &result;
+    result.view = view; // Jobs read the copy, the caller's view may go out of scope
+
+    jobs.ParallelFor(count, ASTEROID_JOB_CHUNK, [=](size_t begin, size_t end)
+                     {
+        // The culling test reads only flags + positions + radii, cold data is fetched for visible asteroids
+        const unsigned char *flags = store->flags.data();
+        const Vector3 *positions = store->positions.data();
+        const float *collisionRadii = store->collisionRadii.data();
+        unsigned char *lodLevels = store->lodLevels.data(); // Candidates are unique, no two jobs share an index
+        const int *indices = out->candidates.data();
+        const CullView &cullView = out->view;
+        unsigned char *visible = out->visible.data();
+        Matrix *transforms = out->transforms.data();
+
+        for (size_t k = begin; k < end; ++k)
+        {
+            int i = indices[k];
+            visible[k] = 0;
+            if (!(flags[i] & ASTEROID_ACTIVE))
+                continue;
+            if (k >= out->insideCount && !FrustumIntersectsSphere(cullView.frustum, positions[i], collisionRadii[i]))
+                continue;
+            visible[k] = 1;
+
+            float distance = fmaxf(Vector3Distance(cullView.cameraPosition, positions[i]), 0.001f);
+            float pixelSize = 2.0f * collisionRadii[i] * cullView.pixelsPerUnit / distance;
+            int lod = SelectLodLevel(lodLevels[i], pixelSize);
+            lodLevels[i] = (unsigned char)lod;
+            if (lod == AsteroidFieldConstants::LOD_IMPOSTOR || !cullView.buildTransforms)
+                continue; // Billboards only need the position, GPU-animated meshes their index
+
+            const AsteroidColdData &cold = store->cold[i];
+            Matrix matScale = MatrixScale(cold.scale, cold.scale, cold.scale);
+            float angle = store->rotationAngles[i] + store->rotationSpeeds[i] * cullView.rotationTimeOffset;
+            Matrix matRotation = MatrixRotate(cold.rotationAxis, angle * DEG2RAD);
+            Matrix matTranslation = MatrixTranslate(positions[i].x, positions[i].y, positions[i].z);
+            transforms[k] = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+        } });
+}
+
+// Narrow phase for FindAsteroidContacts (userData is the store, only read)
+static bool AsteroidSpheresOverlap(int a, int b, void *userData)
+{
+    const AsteroidStore *store = (const AsteroidStore *)userData;
+    if (!store->IsActive(a) || !store->IsActive(b))
+        return false;
+    float radiusSum = store->collisionRadii[a] + store->collisionRadii[b];
+    return Vector3DistanceSqr(store->positions[a], store->positions[b]) <= radiusSum * radiusSum;
+}
+
+void FindAsteroidContacts(const AsteroidStore &asteroids, UniformGrid &grid, std::vector<GridPair> &outContacts, JobSystem &jobs)
+{
+    grid.FindPairs(outContacts, AsteroidSpheresOverlap, (void *)&asteroids, &jobs);
+}
@@ -0,0 +1,78 @@
+#ifndef ASTEROID_SYSTEMS_H
+#define ASTEROID_SYSTEMS_H
+
+#include "raylib.h"
+#include <vector>
+
+#include "asteroid_field.h" // For AsteroidFieldConstants (LOD levels)
+#include "asteroid_store.h"
+#include "frustum.h"
+#include "job_system.h"
+#include "uniform_grid.h"
+
+//------------------------------------------------------------------------------------
+// Per-Frame Asteroid Systems
+//------------------------------------------------------------------------------------
+// Each function splits the asteroid range into chunks and queues them on the job
+// system. They return immediately: call JobSystem::Wait() before touching the same
+// arrays from the main thread, and never resize the store while jobs are in flight.
+constexpr size_t ASTEROID_JOB_CHUNK = 2048; // Asteroids per job
+
+// LOD selection: projected diameter (pixels) an asteroid needs to stay on each mesh level,
+// below the last one it becomes an impostor. A level only changes once the size is
+// LOD_HYSTERESIS past the threshold, so asteroids near a boundary do not flicker.
+constexpr float LOD_MIN_PIXEL_SIZE[AsteroidFieldConstants::NUM_LOD_LEVELS] = {90.0f, 30.0f, 6.0f};
+constexpr float LOD_HYSTERESIS = 0.15f;
+
+// Camera data the culling jobs need (copied into the result, so it outlives the caller's frame)
+typedef struct
+{
+    Frustum frustum;
+    Vector3 cameraPosition;
+    float pixelsPerUnit;      // Projected pixels of one world unit at distance 1
+    float rotationTimeOffset; // Seconds added to the rotation (rendering between ticks, <= 0), 0 by default
+    bool buildTransforms;     // Fill AsteroidCullResult::transforms, true by default (off when the GPU animates)
+} CullView;
+
+// How CullAsteroids finds its candidates
+typedef enum
+{
+    CULL_MODE_BRUTE_FORCE = 0, // Sphere vs frustum test on every asteroid (O(N))
+    CULL_MODE_GRID,            // Spatial index (grid cells or BVH nodes) vs frustum first, then only their asteroids
+} CullMode;
+
+// Output of the culling pass. Entry k describes asteroid candidates[k]; the first insideCount
+// candidates came from cells or nodes fully inside the frustum and skip the sphere test. The chosen
+// LOD is written to AsteroidStore::lodLevels.
+typedef struct
+{
+    FrameVector<int> candidates;
+    FrameVector<unsigned char> visible; // 1 if candidate k passed culling
+    FrameVector<Matrix> transforms;     // Scale * rotation * translation (no shake), valid when visible mesh LOD and built
+    size_t insideCount;
+    CullView view;                        // Copy used by the jobs
+    FrameVector<int> intersectingScratch; // Index query buffer for cells or nodes crossing the frustum
+} AsteroidCullResult;
+
+// Empty result whose lists allocate from arena (valid until its next Reset), or from the heap
+// when arena is null (a result reused across frames)
+AsteroidCullResult CreateAsteroidCullResult(FrameArena *arena);
+
+// Advance rotation angles, kept within [0, 360)
+void UpdateAsteroidRotations(AsteroidStore &asteroids, float deltaTime, JobSystem &jobs);
+
+// Frustum matching BeginMode3D for this camera and screen size, far plane at farPlane
+CullView GetCullView(Camera3D camera, int screenWidth, int screenHeight, float farPlane);
+
+// Frustum culling (collision radius as bounding sphere), LOD selection and transform building.
+// Candidates are gathered on the calling thread (from the spatial index in CULL_MODE_GRID, falling
+// back to brute force without one), the tests and transforms run on the workers.
+void CullAsteroids(AsteroidStore &asteroids, const CullView &view, SpatialIndex *index, CullMode mode,
+                   AsteroidCullResult &result, JobSystem &jobs);
+
+// Asteroid vs asteroid contacts: grid broad phase plus a sphere narrow phase (collision radii,
+// active asteroids only). Unlike the passes above this one joins its jobs before returning.
+// The grid's GetPairStats() has the candidate and contact counts of the last call.
+void FindAsteroidContacts(const AsteroidStore &asteroids, UniformGrid &grid, std::vector<GridPair> &outContacts, JobSystem &jobs);
+
+#endif // ASTEROID_SYSTEMS_H
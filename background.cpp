@@ -1,22 +1,20 @@
 #include "background.h"
-#include "asteroid_field.h" // For GetRandomFloat - Alternatively move GetRandomFloat to its own utils header/cpp
+#include "raymath.h"
 #include <vector>
-#include <cstdlib> // For rand()
+#include <cmath>
 
 //------------------------------------------------------------------------------------
 // Background Functions - Implementation
 //------------------------------------------------------------------------------------
 
-std::vector<Star> InitializeStars(int screenWidth, int screenHeight, int starCount)
+std::vector<Star> InitializeStars(int screenWidth, int screenHeight, int starCount, Rng &rng)
 {
     std::vector<Star> stars(starCount);
     for (int i = 0; i < starCount; ++i) {
-        stars[i].position.x = (float)(rand() % screenWidth);
-        stars[i].position.y = (float)(rand() % screenHeight);
-        // Use basic rand() or GetRandomFloat if accessible
-        stars[i].radius = 0.5f + (float)(rand() % 100) / 100.0f; // Radius between 0.5 and 1.5
-        // stars[i].radius = GetRandomFloat(0.5f, 1.5f); // If GetRandomFloat is available
-        unsigned char brightness = (unsigned char)((rand() % 106) + 150); // Simple rand for brightness [150-255]
+        stars[i].position.x = (float)rng.NextInt(screenWidth);
+        stars[i].position.y = (float)rng.NextInt(screenHeight);
+        stars[i].radius = rng.Range(0.5f, 1.5f); // Radius between 0.5 and 1.5
+        unsigned char brightness = (unsigned char)(rng.NextInt(106) + 150); // Brightness [150-255]
         stars[i].color = { brightness, brightness, brightness, 255 };
     }
     return stars;
@@ -28,3 +26,146 @@ void DrawStars(const std::vector<Star>& stars)
         DrawCircleV(star.position, star.radius, star.color);
     }
 }
+
+//------------------------------------------------------------------------------------
+// Baked Star Background - Implementation
+//------------------------------------------------------------------------------------
+
+static const char *backgroundModeNames[BACKGROUND_MODE_COUNT] = { "Immediate", "Baked", "Parallax" };
+
+StarBackground::StarBackground(std::vector<Star> starList, int width, int height, Color top, Color bottom)
+    : stars(std::move(starList)), generationWidth(width > 0 ? width : 1), generationHeight(height > 0 ? height : 1),
+      topColor(top), bottomColor(bottom), mode(BACKGROUND_MODE_BAKED), flatTarget{}, gradientTarget{}, layerTargets{},
+      bakedWidth(0), bakedHeight(0), bakeCount(0)
+{
+    // Radii are in [0.5, 1.5): split the range evenly, bigger stars read as nearer
+    for (const Star &star : stars) {
+        int layer = (int)((star.radius - 0.5f) * BACKGROUND_PARALLAX_LAYERS);
+        layer = (layer < 0) ? 0 : (layer >= BACKGROUND_PARALLAX_LAYERS ? BACKGROUND_PARALLAX_LAYERS - 1 : layer);
+        layers[layer].push_back(star);
+    }
+}
+
+StarBackground::~StarBackground()
+{
+    Unload();
+}
+
+const char *StarBackground::GetModeName() const
+{
+    return backgroundModeNames[mode];
+}
+
+size_t StarBackground::GetMemoryUsage() const
+{
+    size_t starCount = stars.capacity();
+    for (int i = 0; i < BACKGROUND_PARALLAX_LAYERS; ++i) starCount += layers[i].capacity();
+    return starCount * sizeof(Star);
+}
+
+size_t StarBackground::GetGpuMemoryUsage() const
+{
+    size_t targetBytes = (size_t)bakedWidth * bakedHeight * 8;
+    return targetBytes * (2 + BACKGROUND_PARALLAX_LAYERS);
+}
+
+void StarBackground::Unload()
+{
+    if (bakedWidth == 0) return;
+    UnloadRenderTexture(flatTarget);
+    UnloadRenderTexture(gradientTarget);
+    for (int i = 0; i < BACKGROUND_PARALLAX_LAYERS; ++i) UnloadRenderTexture(layerTargets[i]);
+    bakedWidth = bakedHeight = 0;
+}
+
+// Draws stars scaled from the generation size to width x height. With wrap, stars touching
+// an edge are drawn again on the opposite side so the texture tiles without seams.
+void StarBackground::DrawStarsScaled(const std::vector<Star> &layerStars, int width, int height, bool wrap) const
+{
+    float scaleX = (float)width / (float)generationWidth;
+    float scaleY = (float)height / (float)generationHeight;
+    for (const Star &star : layerStars) {
+        Vector2 position = { star.position.x * scaleX, star.position.y * scaleY };
+        DrawCircleV(position, star.radius, star.color);
+        if (!wrap) continue;
+        float dx = (position.x < star.radius) ? (float)width : (position.x > width - star.radius ? -(float)width : 0.0f);
+        float dy = (position.y < star.radius) ? (float)height : (position.y > height - star.radius ? -(float)height : 0.0f);
+        if (dx != 0.0f) DrawCircleV({ position.x + dx, position.y }, star.radius, star.color);
+        if (dy != 0.0f) DrawCircleV({ position.x, position.y + dy }, star.radius, star.color);
+        if (dx != 0.0f && dy != 0.0f) DrawCircleV({ position.x + dx, position.y + dy }, star.radius, star.color);
+    }
+}
+
+void StarBackground::Bake(int width, int height)
+{
+    Unload();
+    flatTarget = LoadRenderTexture(width, height);
+    gradientTarget = LoadRenderTexture(width, height);
+    for (int i = 0; i < BACKGROUND_PARALLAX_LAYERS; ++i) {
+        layerTargets[i] = LoadRenderTexture(width, height);
+        SetTextureWrap(layerTargets[i].texture, TEXTURE_WRAP_REPEAT); // Scrolled through the source rectangle
+    }
+
+    BeginTextureMode(flatTarget);
+    DrawRectangleGradientV(0, 0, width, height, topColor, bottomColor);
+    DrawStarsScaled(stars, width, height, false);
+    EndTextureMode();
+
+    BeginTextureMode(gradientTarget);
+    DrawRectangleGradientV(0, 0, width, height, topColor, bottomColor);
+    EndTextureMode();
+
+    for (int i = 0; i < BACKGROUND_PARALLAX_LAYERS; ++i) {
+        BeginTextureMode(layerTargets[i]);
+        ClearBackground(BLANK);
+        DrawStarsScaled(layers[i], width, height, true);
+        EndTextureMode();
+    }
+
+    bakedWidth = width;
+    bakedHeight = height;
+    ++bakeCount;
+    TraceLog(LOG_INFO, "BACKGROUND: Baked %zu stars at %dx%d", stars.size(), width, height);
+}
+
+// Full-screen quad of a render texture, the source shifted by offset pixels (wrapping)
+void StarBackground::DrawLayer(const RenderTexture2D &target, float offsetX, float offsetY)
+{
+    // Negative source height: render textures are stored bottom-up
+    Rectangle source = { offsetX, offsetY, (float)target.texture.width, -(float)target.texture.height };
+    DrawTextureRec(target.texture, source, { 0.0f, 0.0f }, WHITE);
+}
+
+void StarBackground::Draw(const Camera3D &camera)
+{
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+
+    if (mode == BACKGROUND_MODE_IMMEDIATE) {
+        DrawRectangleGradientV(0, 0, width, height, topColor, bottomColor);
+        if (width == generationWidth && height == generationHeight) DrawStars(stars);
+        else DrawStarsScaled(stars, width, height, false);
+        return;
+    }
+
+    if (width != bakedWidth || height != bakedHeight) Bake(width, height);
+
+    if (mode == BACKGROUND_MODE_BAKED) {
+        DrawLayer(flatTarget, 0.0f, 0.0f);
+        return;
+    }
+
+    // Parallax: layer i scrolls i + 1 screen widths per full turn of yaw and at the same rate
+    // with pitch (pitch is clamped, so it never needs to line up). Turning left or looking up
+    // moves the sky right or down.
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    float yaw = atan2f(forward.x, forward.z);
+    float pitch = asinf(Clamp(forward.y, -1.0f, 1.0f));
+    DrawLayer(gradientTarget, 0.0f, 0.0f);
+    for (int i = 0; i < BACKGROUND_PARALLAX_LAYERS; ++i) {
+        float turns = (float)(i + 1);
+        float offsetX = -yaw / (2.0f * PI) * turns * (float)width;
+        float offsetY = -pitch / (2.0f * PI) * turns * (float)width;
+        DrawLayer(layerTargets[i], offsetX, offsetY);
+    }
+}
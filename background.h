@@ -3,6 +3,7 @@
 
 #include "raylib.h"
 #include <vector>
+#include "rng.h"
 
 //------------------------------------------------------------------------------------
 // Structure Definition for Stars
@@ -18,9 +19,65 @@ typedef struct {
 //------------------------------------------------------------------------------------
 
 // Generates a vector of stars with random positions, sizes, and brightness
-std::vector<Star> InitializeStars(int screenWidth, int screenHeight, int starCount);
+std::vector<Star> InitializeStars(int screenWidth, int screenHeight, int starCount, Rng &rng);
 
 // Draws the stars from the provided vector
 void DrawStars(const std::vector<Star>& stars); // Pass by const reference
 
+//------------------------------------------------------------------------------------
+// Baked Star Background
+//------------------------------------------------------------------------------------
+// Gradient plus starfield for every screen. The immediate mode redraws the gradient and
+// every star each frame; the baked modes render them once into render textures and then
+// cost one textured quad per layer, whatever the star count. Textures are rebaked when
+// the screen size changes (star positions are scaled from the size they were generated
+// for). In parallax mode the stars are split by radius into wrapping layers that scroll
+// with the camera's yaw and pitch, the bigger (nearer) stars faster; every layer wraps
+// a whole number of times per full turn, so the sky lines up after 360 degrees.
+typedef enum {
+    BACKGROUND_MODE_IMMEDIATE = 0, // Gradient + DrawCircleV per star every frame
+    BACKGROUND_MODE_BAKED,         // One texture with gradient and stars, fixed to the screen
+    BACKGROUND_MODE_PARALLAX,      // Baked gradient + camera-driven star layers
+    BACKGROUND_MODE_COUNT
+} BackgroundMode;
+
+constexpr int BACKGROUND_PARALLAX_LAYERS = 3;
+
+class StarBackground {
+public:
+    // Stars are in pixels of a generationWidth x generationHeight screen (see InitializeStars)
+    StarBackground(std::vector<Star> stars, int generationWidth, int generationHeight, Color top, Color bottom);
+    ~StarBackground(); // Unloads the render textures (call before CloseWindow)
+
+    void SetMode(BackgroundMode newMode) { mode = newMode; }
+    BackgroundMode GetMode() const { return mode; }
+    const char *GetModeName() const;
+
+    // Draws the full-screen background (right after BeginDrawing, before any 3D drawing);
+    // camera only matters in parallax mode. Rebakes first if the screen size changed.
+    void Draw(const Camera3D &camera);
+
+    int GetBakeCount() const { return bakeCount; } // Times the textures were (re)built
+    size_t GetMemoryUsage() const;    // Bytes of the star lists
+    size_t GetGpuMemoryUsage() const; // Estimated VRAM of the render targets (RGBA8 color + 32-bit depth each)
+
+private:
+    void Bake(int width, int height);
+    void Unload();
+    void DrawStarsScaled(const std::vector<Star> &layerStars, int width, int height, bool wrap) const;
+    static void DrawLayer(const RenderTexture2D &target, float offsetX, float offsetY);
+
+    std::vector<Star> stars;
+    std::vector<Star> layers[BACKGROUND_PARALLAX_LAYERS]; // stars split by radius, nearest last
+    int generationWidth, generationHeight;
+    Color topColor, bottomColor;
+    BackgroundMode mode;
+
+    RenderTexture2D flatTarget;                              // Gradient and all stars (baked mode)
+    RenderTexture2D gradientTarget;                          // Gradient only (parallax mode)
+    RenderTexture2D layerTargets[BACKGROUND_PARALLAX_LAYERS]; // Transparent star layers (parallax mode)
+    int bakedWidth, bakedHeight; // 0 until the first bake
+    int bakeCount;
+};
+
 #endif // BACKGROUND_H
@@ -0,0 +1,538 @@
+/*******************************************************************************************
+ *
+ * Asteroid Field Benchmark
+ *
+ * Replays a deterministic scenario against fields of increasing size and reports
+ * per-phase timings, so performance changes can be compared run to run:
+ * - Fixed seed for mesh variants and asteroid placement.
+ * - Scripted camera path (between asteroids of the field) with a scripted click every few frames.
+ * - Phases: mesh and field generation, grid build, BVH build, Query, player SweepSphere, Raycast, batched
+ *   raycast spread, asteroid pair broad phase, culling, occlusion, draw submission.
+ *
+ * Runs against a hidden window (drawing needs a GL context), without a frame rate cap.
+ * Build with `make bench`, run from the repository root:
+ *   bench/bench [--seed N] [--frames N] [--threads N] [--sizes 1000,5000,...] [--index grid|bvh]
+ *               [--csv file] [--json file] [--config file] [--<field option> value]...
+ * --index picks the spatial index behind the query, sweep, raycast and culling phases (the
+ * pair broad phase always runs on the grid); bvh_build only has a sample with --index bvh.
+ * Field options are the FieldConfig ones (field_config.h), e.g. --cell-size 6 or
+ * --auto-cell-size 1, so density vs. cell size can be swept without a rebuild. The asteroid
+ * count always comes from --sizes.
+ *
+ ********************************************************************************************/
+
+#include "raylib.h"
+#include "raymath.h"
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include "asteroid_field.h"
+#include "asteroid_renderer.h"
+#include "asteroid_effects.h"
+#include "asteroid_systems.h"
+#include "bvh_index.h"
+#include "frame_arena.h"
+#include "job_system.h"
+#include "occlusion_culler.h"
+#include "uniform_grid.h"
+
+//------------------------------------------------------------------------------------
+// Benchmark Phases
+//------------------------------------------------------------------------------------
+typedef enum
+{
+    BENCH_PHASE_MESH_GENERATION = 0,
+    BENCH_PHASE_FIELD_GENERATION,
+    BENCH_PHASE_GRID_BUILD,
+    BENCH_PHASE_BVH_BUILD,
+    BENCH_PHASE_QUERY,
+    BENCH_PHASE_SWEEP,
+    BENCH_PHASE_RAYCAST,
+    BENCH_PHASE_RAYCAST_BATCH,
+    BENCH_PHASE_BROAD_PHASE,
+    BENCH_PHASE_CULLING,
+    BENCH_PHASE_OCCLUSION,
+    BENCH_PHASE_DRAW_SUBMISSION,
+    BENCH_PHASE_COUNT
+} BenchPhase;
+
+static const char *phaseNames[BENCH_PHASE_COUNT] = {
+    "mesh_generation",
+    "field_generation",
+    "grid_build",
+    "bvh_build",
+    "query",
+    "sweep",
+    "raycast",
+    "raycast_batch",
+    "broad_phase",
+    "culling",
+    "occlusion",
+    "draw_submission",
+};
+
+// Summary of one phase over all its samples (milliseconds)
+typedef struct
+{
+    int samples;
+    double mean;
+    double p50;
+    double p95;
+    double max;
+} PhaseStats;
+
+typedef struct
+{
+    int asteroidCount;
+    Vector3 cellSize; // Grid cell size used (auto-tuned or configured)
+    int hits;      // Scripted clicks that hit an asteroid
+    int destroyed; // Asteroids destroyed by scripted clicks
+    double drawnAverage;
+    double occludedAverage;       // Frustum-visible asteroids hidden by occlusion culling per frame
+    double candidatePairsAverage; // Broad phase pairs per frame
+    double contactsAverage;       // Overlapping asteroid pairs per frame
+    size_t arenaHighWater;        // Most frame arena bytes used by one frame
+    PhaseStats phases[BENCH_PHASE_COUNT];
+} BenchResult;
+
+// Benchmark options (command line)
+typedef struct
+{
+    unsigned int seed;
+    int frames;
+    int threads; // Job system workers, -1 = hardware default
+    std::vector<int> sizes;
+    const char *csvPath;
+    const char *jsonPath;
+    bool useBvh; // --index bvh: queries and culling through the BVH
+    FieldConfig field; // Generation, grid and culling parameters
+} BenchOptions;
+
+// Scenario constants (same values as the game where they exist)
+constexpr int BENCH_SCREEN_WIDTH = 1280;
+constexpr int BENCH_SCREEN_HEIGHT = 720;
+constexpr int BENCH_CLICK_INTERVAL = 10;  // Frames between scripted clicks
+constexpr int BENCH_WAYPOINTS = 8;        // Asteroids visited by the camera path
+constexpr int BENCH_SPREAD_RAYS = 32;     // Rays of the scripted weapon spread (batched raycast)
+constexpr float BENCH_SPREAD_ANGLE = 0.15f; // Spread cone half-angle (radians)
+constexpr float BENCH_FRAME_TIME = 1.0f / 60.0f;
+constexpr float BENCH_HIT_MAX_DISTANCE = 50.0f;
+constexpr float BENCH_PLAYER_RADIUS = 0.5f;
+constexpr float BENCH_SHAKE_DURATION = 0.25f;
+
+//------------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------------
+
+static PhaseStats SummarizePhase(std::vector<double> &samples)
+{
+    PhaseStats stats = {0};
+    stats.samples = (int)samples.size();
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double sample : samples)
+        sum += sample;
+    stats.mean = sum / (double)samples.size();
+    stats.p50 = samples[samples.size() / 2];
+    stats.p95 = samples[std::min(samples.size() - 1, (samples.size() * 95) / 100)];
+    stats.max = samples.back();
+    return stats;
+}
+
+// Scripted camera: flies between asteroids picked at fixed index fractions (so the path only
+// depends on the seed), stopping short of each one while looking at it
+static Camera3D GetScriptedCamera(int frame, int frameCount, const AsteroidStore &asteroids)
+{
+    const Vector3 standOff = {0.0f, 4.0f, 20.0f};
+    float pathPosition = (float)BENCH_WAYPOINTS * (float)frame / (float)frameCount;
+    int segment = (int)pathPosition;
+    float t = pathPosition - (float)segment;
+    t = t * t * (3.0f - 2.0f * t); // Ease in and out of each waypoint
+
+    size_t count = asteroids.Size();
+    Vector3 from = asteroids.positions[(segment * count) / BENCH_WAYPOINTS];
+    Vector3 to = asteroids.positions[(((segment + 1) % BENCH_WAYPOINTS) * count) / BENCH_WAYPOINTS];
+
+    Camera3D camera = {0};
+    camera.position = Vector3Add(Vector3Lerp(from, to, t), standOff);
+    camera.target = to;
+    camera.up = {0.0f, 1.0f, 0.0f};
+    camera.fovy = 60.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    return camera;
+}
+
+// Fixed spread of rays around the view direction (golden-angle spiral), like a shotgun blast
+static void BuildSpreadRays(Ray center, Vector3 up, Ray *outRays, int rayCount)
+{
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(center.direction, up));
+    Vector3 localUp = Vector3CrossProduct(right, center.direction);
+    for (int i = 0; i < rayCount; ++i)
+    {
+        float radius = BENCH_SPREAD_ANGLE * sqrtf(((float)i + 0.5f) / (float)rayCount);
+        float angle = 2.39996323f * (float)i;
+        Vector3 offset = Vector3Add(Vector3Scale(right, radius * cosf(angle)), Vector3Scale(localUp, radius * sinf(angle)));
+        outRays[i].position = center.position;
+        outRays[i].direction = Vector3Normalize(Vector3Add(center.direction, offset));
+    }
+}
+
+// Same hit handling as the game's click handler
+static void ApplyScriptedClick(const GridRayHit &hit, AsteroidStore &asteroids, AsteroidEffects &effects, UniformGrid &grid,
+                               BvhIndex &bvh, BenchResult &result)
+{
+    int closestIndex = hit.instanceIndex;
+    if (closestIndex == -1)
+        return;
+
+    result.hits++;
+    effects.StartShake(asteroids, closestIndex, BENCH_SHAKE_DURATION);
+    if (--asteroids.hitPoints[closestIndex] <= 0)
+    {
+        asteroids.flags[closestIndex] &= ~ASTEROID_ACTIVE;
+        grid.Remove(closestIndex);
+        bvh.Remove(closestIndex); // No-op when the BVH is not in use
+        result.destroyed++;
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Scenario
+//------------------------------------------------------------------------------------
+
+static BenchResult RunScenario(const BenchOptions &options, int asteroidCount, AsteroidRenderer &renderer, JobSystem &jobs)
+{
+    BenchResult result = {0};
+    result.asteroidCount = asteroidCount;
+    std::vector<double> samples[BENCH_PHASE_COUNT];
+    for (int p = BENCH_PHASE_QUERY; p < BENCH_PHASE_COUNT; ++p)
+        samples[p].reserve(options.frames);
+
+    // Every size starts from the same streams
+    Rng meshRng(options.seed, RNG_STREAM_MESHES);
+    Rng fieldRng(options.seed, RNG_STREAM_FIELD);
+    FieldConfig config = options.field;
+    config.asteroidCount = asteroidCount;
+
+    // Generation (meshes are uploaded, since the draw phase needs them)
+    double start = GetTime();
+    AsteroidMeshPool meshPool = GenerateAsteroidMeshPool(config, meshRng, &jobs);
+    samples[BENCH_PHASE_MESH_GENERATION].push_back((GetTime() - start) * 1000.0);
+
+    start = GetTime();
+    AsteroidStore asteroids = InitializeAsteroidField(meshPool, fieldRng, config, &jobs);
+    samples[BENCH_PHASE_FIELD_GENERATION].push_back((GetTime() - start) * 1000.0);
+
+    // Auto-tuning is timed as part of the grid build
+    start = GetTime();
+    Vector3 cellSize = config.autoCellSize ? ComputeAutoCellSize(asteroids.positions, asteroids.collisionRadii, config.gridCellSize)
+                                           : config.gridCellSize;
+    result.cellSize = cellSize;
+    BoundingBox bounds = GetAsteroidFieldBounds(config, cellSize.x);
+    UniformGrid grid(bounds.min, bounds.max, cellSize);
+    grid.BuildInstanced(asteroids);
+    samples[BENCH_PHASE_GRID_BUILD].push_back((GetTime() - start) * 1000.0);
+
+    BvhIndex bvh;
+    if (options.useBvh)
+    {
+        start = GetTime();
+        bvh.BuildInstanced(asteroids);
+        samples[BENCH_PHASE_BVH_BUILD].push_back((GetTime() - start) * 1000.0);
+    }
+    SpatialIndex &index = options.useBvh ? (SpatialIndex &)bvh : (SpatialIndex &)grid;
+
+    if (asteroids.Empty())
+    {
+        TraceLog(LOG_WARNING, "BENCH: No asteroids generated for size %d", asteroidCount);
+        UnloadAsteroidMeshPool(meshPool);
+        return result;
+    }
+
+    Ray spreadRays[BENCH_SPREAD_RAYS];
+    GridRayHit spreadHits[BENCH_SPREAD_RAYS];
+    std::vector<GridPair> contacts;
+    FrameArena frameArena; // Same per-frame scratch memory as the game loop
+    AsteroidEffects effects;
+    OcclusionCuller occlusionCuller;
+    occlusionCuller.SetMeshPool(meshPool, config.meshIrregularity);
+    double occludedTotal = 0.0;
+    effects.Reset(asteroids.Size());
+    double drawnTotal = 0.0;
+    double candidatePairsTotal = 0.0;
+    double contactsTotal = 0.0;
+
+    Vector3 previousCameraPos = GetScriptedCamera(0, options.frames, asteroids).position;
+    for (int frame = 0; frame < options.frames; ++frame)
+    {
+        Camera3D camera = GetScriptedCamera(frame, options.frames, asteroids);
+        frameArena.Reset();
+        FrameVector<int> nearbyIndices = MakeFrameVector<int>(&frameArena);
+        AsteroidCullResult cullResult = CreateAsteroidCullResult(&frameArena);
+
+        // Per-frame asteroid updates (untimed, they keep the culled transforms changing)
+        effects.UpdateShakeTimers(asteroids, BENCH_FRAME_TIME);
+        effects.UpdateColors(asteroids, camera.position, BENCH_PLAYER_RADIUS);
+        UpdateAsteroidRotations(asteroids, BENCH_FRAME_TIME, jobs);
+        jobs.Wait();
+
+        // Player collision query
+        start = GetTime();
+        index.Query(camera.position, nearbyIndices);
+        samples[BENCH_PHASE_QUERY].push_back((GetTime() - start) * 1000.0);
+
+        // Player sweep from the previous frame's camera position
+        start = GetTime();
+        index.SweepSphere(previousCameraPos, camera.position, BENCH_PLAYER_RADIUS, asteroids);
+        samples[BENCH_PHASE_SWEEP].push_back((GetTime() - start) * 1000.0);
+        previousCameraPos = camera.position;
+
+        // Scripted click along the view direction
+        if (frame % BENCH_CLICK_INTERVAL == 0)
+        {
+            Ray ray = {camera.position, Vector3Normalize(Vector3Subtract(camera.target, camera.position))};
+            start = GetTime();
+            GridRayHit hit = index.Raycast(ray, BENCH_HIT_MAX_DISTANCE, asteroids);
+            samples[BENCH_PHASE_RAYCAST].push_back((GetTime() - start) * 1000.0);
+            ApplyScriptedClick(hit, asteroids, effects, grid, bvh, result);
+
+            // Weapon spread along the same direction (timed only, the hits are not applied)
+            BuildSpreadRays(ray, camera.up, spreadRays, BENCH_SPREAD_RAYS);
+            start = GetTime();
+            index.RaycastBatch(spreadRays, BENCH_SPREAD_RAYS, BENCH_HIT_MAX_DISTANCE, asteroids, spreadHits, &jobs);
+            samples[BENCH_PHASE_RAYCAST_BATCH].push_back((GetTime() - start) * 1000.0);
+        }
+
+        // Asteroid vs asteroid broad phase and sphere narrow phase
+        start = GetTime();
+        FindAsteroidContacts(asteroids, grid, contacts, jobs);
+        samples[BENCH_PHASE_BROAD_PHASE].push_back((GetTime() - start) * 1000.0);
+        candidatePairsTotal += grid.GetPairStats().candidatePairs;
+        contactsTotal += grid.GetPairStats().pairs;
+
+        // Culling, LOD selection and transforms
+        start = GetTime();
+        CullView cullView = GetCullView(camera, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, config.drawDistance);
+        CullAsteroids(asteroids, cullView, &index, CULL_MODE_GRID, cullResult, jobs);
+        jobs.Wait();
+        samples[BENCH_PHASE_CULLING].push_back((GetTime() - start) * 1000.0);
+
+        // Occlusion culling against the largest nearby asteroids
+        start = GetTime();
+        occlusionCuller.Cull(asteroids, camera, BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, cullResult, jobs);
+        samples[BENCH_PHASE_OCCLUSION].push_back((GetTime() - start) * 1000.0);
+        occludedTotal += occlusionCuller.GetStats().occluded;
+
+        // Draw submission (buckets + instanced draw calls, buffer swap excluded)
+        BeginDrawing();
+        ClearBackground(BLACK);
+        BeginMode3D(camera);
+        start = GetTime();
+        int drawn = 0;
+        renderer.BeginFrame((int)meshPool.meshes.size(), &frameArena);
+        for (size_t k = 0; k < cullResult.candidates.size(); ++k)
+        {
+            if (!cullResult.visible[k])
+                continue;
+            int i = cullResult.candidates[k];
+            int lod = asteroids.lodLevels[i];
+            drawn++;
+            if (lod == AsteroidFieldConstants::LOD_IMPOSTOR)
+                renderer.SubmitImpostor(asteroids.positions[i], 2.0f * asteroids.collisionRadii[i], asteroids.currentColors[i]);
+            else
+                renderer.Submit(GetMeshPoolIndex(meshPool, asteroids.cold[i].variantIndex, lod), cullResult.transforms[k],
+                                asteroids.currentColors[i]);
+        }
+        renderer.Flush(meshPool, camera, true);
+        samples[BENCH_PHASE_DRAW_SUBMISSION].push_back((GetTime() - start) * 1000.0);
+        EndMode3D();
+        EndDrawing();
+        drawnTotal += drawn;
+    }
+
+    UnloadAsteroidMeshPool(meshPool);
+
+    result.arenaHighWater = frameArena.GetStats().highWater;
+    result.drawnAverage = (options.frames > 0) ? drawnTotal / (double)options.frames : 0.0;
+    result.occludedAverage = (options.frames > 0) ? occludedTotal / (double)options.frames : 0.0;
+    result.candidatePairsAverage = (options.frames > 0) ? candidatePairsTotal / (double)options.frames : 0.0;
+    result.contactsAverage = (options.frames > 0) ? contactsTotal / (double)options.frames : 0.0;
+    for (int p = 0; p < BENCH_PHASE_COUNT; ++p)
+        result.phases[p] = SummarizePhase(samples[p]);
+    return result;
+}
+
+//------------------------------------------------------------------------------------
+// Output
+//------------------------------------------------------------------------------------
+
+static bool WriteCsv(const char *path, const std::vector<BenchResult> &results)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "BENCH: Failed to open %s", path);
+        return false;
+    }
+    fprintf(file, "asteroids,cell_size,phase,samples,mean_ms,p50_ms,p95_ms,max_ms\n");
+    for (const BenchResult &result : results)
+    {
+        for (int p = 0; p < BENCH_PHASE_COUNT; ++p)
+        {
+            const PhaseStats &stats = result.phases[p];
+            fprintf(file, "%d,%.3f,%s,%d,%.4f,%.4f,%.4f,%.4f\n", result.asteroidCount, result.cellSize.x, phaseNames[p],
+                    stats.samples, stats.mean, stats.p50, stats.p95, stats.max);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+static bool WriteJson(const char *path, const BenchOptions &options, int threadCount, const std::vector<BenchResult> &results)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "BENCH: Failed to open %s", path);
+        return false;
+    }
+    fprintf(file, "{\n  \"seed\": %u,\n  \"frames\": %d,\n  \"threads\": %d,\n  \"index\": \"%s\",\n  \"results\": [\n",
+            options.seed, options.frames, threadCount, options.useBvh ? "bvh" : "grid");
+    for (size_t r = 0; r < results.size(); ++r)
+    {
+        const BenchResult &result = results[r];
+        fprintf(file, "    {\"asteroids\": %d, \"cell_size\": [%.3f, %.3f, %.3f], \"hits\": %d, \"destroyed\": %d, \"drawn_avg\": %.1f, \"occluded_avg\": %.1f, \"candidate_pairs_avg\": %.1f, \"contacts_avg\": %.1f, \"arena_high_water_kb\": %.1f, \"phases\": {",
+                result.asteroidCount, result.cellSize.x, result.cellSize.y, result.cellSize.z, result.hits, result.destroyed,
+                result.drawnAverage, result.occludedAverage, result.candidatePairsAverage, result.contactsAverage, result.arenaHighWater / 1024.0);
+        for (int p = 0; p < BENCH_PHASE_COUNT; ++p)
+        {
+            const PhaseStats &stats = result.phases[p];
+            fprintf(file, "%s\n      \"%s\": {\"samples\": %d, \"mean_ms\": %.4f, \"p50_ms\": %.4f, \"p95_ms\": %.4f, \"max_ms\": %.4f}",
+                    (p > 0) ? "," : "", phaseNames[p], stats.samples, stats.mean, stats.p50, stats.p95, stats.max);
+        }
+        fprintf(file, "}}%s\n", (r + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+static bool ParseOptions(int argc, char **argv, BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+        {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+
+        if (strcmp(arg, "--seed") == 0)
+            options.seed = (unsigned int)strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--frames") == 0)
+            options.frames = std::max(1, atoi(value));
+        else if (strcmp(arg, "--threads") == 0)
+            options.threads = atoi(value);
+        else if (strcmp(arg, "--csv") == 0)
+            options.csvPath = value;
+        else if (strcmp(arg, "--json") == 0)
+            options.jsonPath = value;
+        else if (strcmp(arg, "--index") == 0)
+        {
+            if (strcmp(value, "bvh") != 0 && strcmp(value, "grid") != 0)
+            {
+                fprintf(stderr, "Unknown index %s (grid or bvh)\n", value);
+                return false;
+            }
+            options.useBvh = (strcmp(value, "bvh") == 0);
+        }
+        else if (strcmp(arg, "--sizes") == 0)
+        {
+            options.sizes.clear();
+            for (const char *c = value; *c != '\0';)
+            {
+                int size = atoi(c);
+                if (size > 0)
+                    options.sizes.push_back(size);
+                const char *comma = strchr(c, ',');
+                if (comma == nullptr)
+                    break;
+                c = comma + 1;
+            }
+        }
+        else if (strcmp(arg, "--config") == 0)
+        {
+            if (!LoadFieldConfig(value, options.field))
+                return false;
+        }
+        else if (strncmp(arg, "--", 2) != 0 || !SetFieldConfigOption(options.field, arg + 2, value))
+        {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return false;
+        }
+        i++; // Skip the value
+    }
+    return !options.sizes.empty();
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    options.seed = 12345;
+    options.frames = 600;
+    options.threads = -1;
+    options.sizes = {1000, 5000, 10000, 25000, 50000, 100000};
+    options.csvPath = "bench_results.csv";
+    options.jsonPath = "bench_results.json";
+    options.useBvh = false;
+    options.field = GetDefaultFieldConfig();
+    if (!ParseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "Usage: bench [--seed N] [--frames N] [--threads N] [--sizes 1000,5000,...] [--index grid|bvh] [--csv file] [--json file] [--config file] [--<field option> value]\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING); // Keep generation logs out of the benchmark output
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(BENCH_SCREEN_WIDTH, BENCH_SCREEN_HEIGHT, "Asteroid Field Benchmark");
+
+    AsteroidRenderer *renderer = new AsteroidRenderer();
+    JobSystem *jobs = new JobSystem(options.threads);
+
+    std::vector<BenchResult> results;
+    for (int size : options.sizes)
+    {
+        results.push_back(RunScenario(options, size, *renderer, *jobs));
+        const BenchResult &result = results.back();
+        printf("%7d asteroids | cell %5.2f | gen %8.2f ms | %s %7.2f ms | query %.4f | ray %.4f | spread %.4f | pairs %.3f | cull %.3f | occl %.3f | draw %.3f ms (avg, %.0f drawn, %.0f occluded, %.0f contacts)\n",
+               size, result.cellSize.x, result.phases[BENCH_PHASE_FIELD_GENERATION].mean, options.useBvh ? "bvh " : "grid",
+               result.phases[options.useBvh ? BENCH_PHASE_BVH_BUILD : BENCH_PHASE_GRID_BUILD].mean,
+               result.phases[BENCH_PHASE_QUERY].mean, result.phases[BENCH_PHASE_RAYCAST].mean,
+               result.phases[BENCH_PHASE_RAYCAST_BATCH].mean, result.phases[BENCH_PHASE_BROAD_PHASE].mean,
+               result.phases[BENCH_PHASE_CULLING].mean, result.phases[BENCH_PHASE_OCCLUSION].mean,
+               result.phases[BENCH_PHASE_DRAW_SUBMISSION].mean, result.drawnAverage, result.occludedAverage, result.contactsAverage);
+    }
+
+    bool written = WriteCsv(options.csvPath, results);
+    written = WriteJson(options.jsonPath, options, jobs->GetThreadCount(), results) && written;
+    if (written)
+        printf("Results written to %s and %s\n", options.csvPath, options.jsonPath);
+
+    delete jobs;
+    delete renderer; // GPU resources go before the window
+    CloseWindow();
+
+    return written ? 0 : 1;
+}
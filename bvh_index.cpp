@@ -0,0 +1,757 @@
+#include "bvh_index.h"
+#include <algorithm> // For std::nth_element, std::partition, std::max
+#include <atomic>    // RaycastBatch node counter
+#include <cfloat>    // For FLT_MAX
+#include <cmath>
+
+//------------------------------------------------------------------------------------
+// Box Helpers
+//------------------------------------------------------------------------------------
+
+static inline BoundingBox GetEmptyBox()
+{
+    return BoundingBox{{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+// Plain compares rather than Vector3Min/Max: fminf/fmaxf are library calls unless NaNs are ruled
+// out, and the build grows boxes for every item on every level
+static inline void GrowBox(BoundingBox &box, Vector3 min, Vector3 max)
+{
+    box.min.x = (min.x < box.min.x) ? min.x : box.min.x;
+    box.min.y = (min.y < box.min.y) ? min.y : box.min.y;
+    box.min.z = (min.z < box.min.z) ? min.z : box.min.z;
+    box.max.x = (max.x > box.max.x) ? max.x : box.max.x;
+    box.max.y = (max.y > box.max.y) ? max.y : box.max.y;
+    box.max.z = (max.z > box.max.z) ? max.z : box.max.z;
+}
+
+static inline void GrowBox(BoundingBox &box, const BoundingBox &other)
+{
+    GrowBox(box, other.min, other.max);
+}
+
+static inline void GrowBox(BoundingBox &box, Vector3 point)
+{
+    GrowBox(box, point, point);
+}
+
+// Half the surface area (the SAH only compares ratios)
+static inline float GetHalfArea(const BoundingBox &box)
+{
+    Vector3 size = Vector3Subtract(box.max, box.min);
+    if (size.x < 0.0f || size.y < 0.0f || size.z < 0.0f)
+        return 0.0f;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+static inline bool BoxContainsPoint(Vector3 min, Vector3 max, Vector3 point)
+{
+    return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y && point.z >= min.z && point.z <= max.z;
+}
+
+static inline float GetAxis(Vector3 v, int axis)
+{
+    return (axis == 0) ? v.x : (axis == 1) ? v.y : v.z;
+}
+
+// Segment origin + t * direction with its reciprocal direction; axes it runs parallel to keep an
+// inverse of 0 and only check the origin against the slab
+typedef struct
+{
+    Vector3 origin;
+    Vector3 inverse;
+    bool parallel[3];
+} BvhSegment;
+
+static inline BvhSegment MakeSegment(Vector3 origin, Vector3 direction)
+{
+    BvhSegment segment;
+    segment.origin = origin;
+    const float d[3] = {direction.x, direction.y, direction.z};
+    float inverse[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        segment.parallel[axis] = fabsf(d[axis]) < 1e-12f;
+        inverse[axis] = segment.parallel[axis] ? 0.0f : 1.0f / d[axis];
+    }
+    segment.inverse = Vector3{inverse[0], inverse[1], inverse[2]};
+    return segment;
+}
+
+// Entry t of the segment into [min - grow, max + grow] within [0, maxT], false if it misses
+static inline bool SegmentEntersBox(const BvhSegment &segment, Vector3 min, Vector3 max, float grow, float maxT, float &tEnter)
+{
+    if (min.x > max.x)
+        return false; // Emptied by a refit
+    float t0 = 0.0f;
+    float t1 = maxT;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        float origin = GetAxis(segment.origin, axis);
+        float lo = GetAxis(min, axis) - grow;
+        float hi = GetAxis(max, axis) + grow;
+        if (segment.parallel[axis])
+        {
+            if (origin < lo || origin > hi)
+                return false;
+            continue;
+        }
+        float inverse = GetAxis(segment.inverse, axis);
+        float a = (lo - origin) * inverse;
+        float b = (hi - origin) * inverse;
+        if (a > b)
+            std::swap(a, b);
+        t0 = (a > t0) ? a : t0;
+        t1 = (b < t1) ? b : t1;
+        if (t0 > t1)
+            return false;
+    }
+    tEnter = t0;
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// BvhIndex Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+BvhIndex::BvhIndex()
+    : treeInstances(0), tombstones(0), treeDepth(0), refitDirty(false), queryStats{0}
+{
+}
+
+void BvhIndex::Clear()
+{
+    nodes.clear();
+    slotInstances.clear();
+    slotBounds.clear();
+    instanceSlots.clear();
+    instanceBounds.clear();
+    pendingInstances.clear();
+    treeInstances = 0;
+    tombstones = 0;
+    treeDepth = 0;
+    refitDirty = false;
+}
+
+void BvhIndex::BuildInstanced(const AsteroidStore &instances)
+{
+    double buildStart = GetTime();
+    Clear();
+    instanceSlots.assign(instances.Size(), BVH_SLOT_NONE);
+    instanceBounds.resize(instances.Size());
+    for (size_t i = 0; i < instances.Size(); ++i)
+    {
+        if (!instances.IsActive(i))
+            continue;
+        instanceBounds[i] = GetInstanceBounds(instances, i);
+        instanceSlots[i] = BVH_SLOT_PENDING; // Collected by Build()
+    }
+    Build();
+    TraceLog(LOG_INFO, "BVH build complete: %d instances, %zu nodes, depth %d (%.2f ms).", treeInstances, nodes.size(),
+             treeDepth, (GetTime() - buildStart) * 1000.0);
+}
+
+void BvhIndex::Add(int instanceIndex, BoundingBox worldBounds)
+{
+    if (instanceIndex < 0)
+        return;
+    if ((size_t)instanceIndex >= instanceSlots.size())
+    {
+        instanceSlots.resize((size_t)instanceIndex + 1, BVH_SLOT_NONE);
+        instanceBounds.resize((size_t)instanceIndex + 1);
+    }
+    if (instanceSlots[instanceIndex] != BVH_SLOT_NONE)
+    {
+        Move(instanceIndex, instanceBounds[instanceIndex], worldBounds); // Already tracked
+        return;
+    }
+    instanceBounds[instanceIndex] = worldBounds;
+    instanceSlots[instanceIndex] = BVH_SLOT_PENDING;
+    pendingInstances.push_back(instanceIndex);
+}
+
+void BvhIndex::Remove(int instanceIndex)
+{
+    if (instanceIndex < 0 || (size_t)instanceIndex >= instanceSlots.size() || instanceSlots[instanceIndex] == BVH_SLOT_NONE)
+        return;
+
+    int slot = instanceSlots[instanceIndex];
+    if (slot >= 0)
+    {
+        slotInstances[slot] = -1; // Tombstone, the node boxes stay conservative until the next build
+        tombstones++;
+        treeInstances--;
+    }
+    else
+    {
+        for (size_t p = 0; p < pendingInstances.size(); ++p)
+        {
+            if (pendingInstances[p] == instanceIndex)
+            {
+                pendingInstances[p] = pendingInstances.back();
+                pendingInstances.pop_back();
+                break;
+            }
+        }
+    }
+    instanceSlots[instanceIndex] = BVH_SLOT_NONE;
+}
+
+void BvhIndex::Move(int instanceIndex, BoundingBox oldBounds, BoundingBox newBounds)
+{
+    if (instanceIndex < 0 || (size_t)instanceIndex >= instanceSlots.size() || instanceSlots[instanceIndex] == BVH_SLOT_NONE)
+    {
+        Add(instanceIndex, newBounds); // Not tracked yet
+        return;
+    }
+    instanceBounds[instanceIndex] = newBounds;
+    int slot = instanceSlots[instanceIndex];
+    if (slot >= 0)
+    {
+        slotBounds[slot] = newBounds;
+        refitDirty = true; // Node boxes are refit before the next query
+    }
+}
+
+void BvhIndex::Build()
+{
+    // Everything tracked goes into the new tree: current slots and pending adds alike
+    buildItems.clear();
+    for (size_t i = 0; i < instanceSlots.size(); ++i)
+    {
+        if (instanceSlots[i] == BVH_SLOT_NONE)
+            continue;
+        const BoundingBox &bounds = instanceBounds[i];
+        buildItems.push_back(BvhBuildItem{bounds, Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f), (int)i});
+    }
+
+    nodes.clear();
+    pendingInstances.clear();
+    tombstones = 0;
+    treeDepth = 0;
+    refitDirty = false;
+    treeInstances = (int)buildItems.size();
+    if (buildItems.empty())
+    {
+        slotInstances.clear();
+        slotBounds.clear();
+        return;
+    }
+
+    nodes.reserve(2 * buildItems.size() / BVH_MAX_LEAF_SIZE + 1);
+    BuildNode(0, (int)buildItems.size(), 1);
+
+    // Leaf order is the final item order
+    slotInstances.resize(buildItems.size());
+    slotBounds.resize(buildItems.size());
+    for (size_t s = 0; s < buildItems.size(); ++s)
+    {
+        int instanceIndex = buildItems[s].instanceIndex;
+        slotInstances[s] = instanceIndex;
+        slotBounds[s] = instanceBounds[instanceIndex];
+        instanceSlots[instanceIndex] = (int)s;
+    }
+}
+
+// Depth-first, so the left child always lands right after its parent
+int BvhIndex::BuildNode(int begin, int end, int depth)
+{
+    int nodeIndex = (int)nodes.size();
+    nodes.push_back(BvhNode{});
+    treeDepth = std::max(treeDepth, depth);
+
+    BoundingBox bounds = GetEmptyBox();
+    for (int i = begin; i < end; ++i)
+        GrowBox(bounds, buildItems[i].bounds);
+
+    int mid = (end - begin > BVH_MAX_LEAF_SIZE) ? PartitionSah(begin, end, depth, bounds) : -1;
+    if (mid < 0)
+    {
+        nodes[nodeIndex] = BvhNode{bounds.min, begin, bounds.max, end - begin};
+        return nodeIndex;
+    }
+
+    BuildNode(begin, mid, depth + 1);
+    int right = BuildNode(mid, end, depth + 1);
+    nodes[nodeIndex] = BvhNode{bounds.min, right, bounds.max, 0};
+    return nodeIndex;
+}
+
+// Binned SAH over the centroids, all three axes binned in one pass over the range. Ranges whose
+// centroids coincide, or that sit deeper than BVH_SAH_MAX_DEPTH, are split at the median of the
+// widest axis instead, which keeps the depth within the traversal stack.
+int BvhIndex::PartitionSah(int begin, int end, int depth, const BoundingBox &bounds)
+{
+    BoundingBox centroidBounds = GetEmptyBox();
+    for (int i = begin; i < end; ++i)
+        GrowBox(centroidBounds, buildItems[i].centroid);
+
+    int count = end - begin;
+    float parentArea = GetHalfArea(bounds);
+    Vector3 centroidExtent = Vector3Subtract(centroidBounds.max, centroidBounds.min);
+    int bestAxis = -1;
+    int bestBin = 0;
+    float bestCost = FLT_MAX;
+    if (depth < BVH_SAH_MAX_DEPTH && parentArea > 0.0f)
+    {
+        int binCounts[3][BVH_SAH_BINS] = {{0}};
+        BoundingBox binBounds[3][BVH_SAH_BINS];
+        float scales[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float extent = GetAxis(centroidExtent, axis);
+            scales[axis] = (extent > 1e-6f) ? (float)BVH_SAH_BINS / extent : 0.0f;
+            for (int b = 0; b < BVH_SAH_BINS; ++b)
+                binBounds[axis][b] = GetEmptyBox();
+        }
+        for (int i = begin; i < end; ++i)
+        {
+            const BvhBuildItem &item = buildItems[i];
+            Vector3 offset = Vector3Subtract(item.centroid, centroidBounds.min);
+            int bins[3] = {std::min(BVH_SAH_BINS - 1, (int)(offset.x * scales[0])), std::min(BVH_SAH_BINS - 1, (int)(offset.y * scales[1])),
+                           std::min(BVH_SAH_BINS - 1, (int)(offset.z * scales[2]))};
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                binCounts[axis][bins[axis]]++;
+                GrowBox(binBounds[axis][bins[axis]], item.bounds);
+            }
+        }
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (scales[axis] == 0.0f)
+                continue; // Every centroid in one bin
+
+            // Sweep the planes between bins from both sides
+            float rightAreas[BVH_SAH_BINS];
+            int rightCounts[BVH_SAH_BINS];
+            BoundingBox sweep = GetEmptyBox();
+            int sweepCount = 0;
+            for (int b = BVH_SAH_BINS - 1; b > 0; --b)
+            {
+                GrowBox(sweep, binBounds[axis][b]);
+                sweepCount += binCounts[axis][b];
+                rightAreas[b] = GetHalfArea(sweep);
+                rightCounts[b] = sweepCount;
+            }
+            sweep = GetEmptyBox();
+            sweepCount = 0;
+            for (int b = 0; b < BVH_SAH_BINS - 1; ++b)
+            {
+                GrowBox(sweep, binBounds[axis][b]);
+                sweepCount += binCounts[axis][b];
+                if (sweepCount == 0 || rightCounts[b + 1] == 0)
+                    continue;
+                float cost = BVH_TRAVERSAL_COST + (GetHalfArea(sweep) * sweepCount + rightAreas[b + 1] * rightCounts[b + 1]) / parentArea;
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+    }
+
+    if (bestAxis >= 0)
+    {
+        float axisMin = GetAxis(centroidBounds.min, bestAxis);
+        float scale = (float)BVH_SAH_BINS / GetAxis(centroidExtent, bestAxis);
+        BvhBuildItem *split = std::partition(buildItems.data() + begin, buildItems.data() + end, [=](const BvhBuildItem &item)
+                                             { return std::min(BVH_SAH_BINS - 1, (int)((GetAxis(item.centroid, bestAxis) - axisMin) * scale)) <= bestBin; });
+        int mid = (int)(split - buildItems.data());
+        if (mid > begin && mid < end)
+            return mid;
+    }
+
+    // Median split of the widest centroid axis (any order once the centroids coincide)
+    const Vector3 &extent = centroidExtent;
+    int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z) ? 1 : 2;
+    int mid = begin + count / 2;
+    std::nth_element(buildItems.begin() + begin, buildItems.begin() + mid, buildItems.begin() + end,
+                     [axis](const BvhBuildItem &a, const BvhBuildItem &b)
+                     { return GetAxis(a.centroid, axis) < GetAxis(b.centroid, axis); });
+    return mid;
+}
+
+// Bottom-up: children always come after their parent, so a reverse pass sees them first
+void BvhIndex::Refit()
+{
+    for (size_t n = nodes.size(); n-- > 0;)
+    {
+        BvhNode &node = nodes[n];
+        BoundingBox bounds = GetEmptyBox();
+        if (node.count > 0)
+        {
+            for (int s = node.first; s < node.first + node.count; ++s)
+            {
+                if (slotInstances[s] >= 0)
+                    GrowBox(bounds, slotBounds[s]);
+            }
+        }
+        else
+        {
+            const BvhNode &left = nodes[n + 1];
+            const BvhNode &right = nodes[node.first];
+            GrowBox(bounds, left.min, left.max);
+            GrowBox(bounds, right.min, right.max);
+        }
+        node.min = bounds.min; // Stays inverted (never entered) when only tombstones are left
+        node.max = bounds.max;
+    }
+    refitDirty = false;
+}
+
+// Rebuild once the incremental changes outweigh the tree, refit after moves
+void BvhIndex::EnsureCurrent()
+{
+    int changes = (int)pendingInstances.size() + tombstones;
+    int threshold = std::max(BVH_MIN_REBUILD_CHANGES, (int)(treeInstances * BVH_REBUILD_FRACTION));
+    if (changes > threshold)
+        Build();
+    else if (refitDirty)
+        Refit();
+}
+
+size_t BvhIndex::GetMemoryUsage() const
+{
+    return nodes.capacity() * sizeof(BvhNode) +
+           slotInstances.capacity() * sizeof(int) +
+           slotBounds.capacity() * sizeof(BoundingBox) +
+           instanceSlots.capacity() * sizeof(int) +
+           instanceBounds.capacity() * sizeof(BoundingBox) +
+           pendingInstances.capacity() * sizeof(int) +
+           buildItems.capacity() * sizeof(BvhBuildItem);
+}
+
+void BvhIndex::AppendCandidate(int instanceIndex, FrameVector<int> &outIndices)
+{
+    if (outIndices.size() == outIndices.capacity())
+        queryStats.allocations++; // push_back below will reallocate
+    outIndices.push_back(instanceIndex);
+    queryStats.candidates++;
+}
+
+//------------------------------------------------------------------------------------
+// Queries
+//------------------------------------------------------------------------------------
+
+void BvhIndex::Query(Vector3 worldPos, FrameVector<int> &outIndices)
+{
+    EnsureCurrent();
+    outIndices.clear();
+    queryStats.queries++;
+
+    int stack[BVH_MAX_DEPTH];
+    int top = 0;
+    if (!nodes.empty())
+        stack[top++] = 0;
+    while (top > 0)
+    {
+        int nodeIndex = stack[--top];
+        const BvhNode &node = nodes[nodeIndex];
+        queryStats.cellsVisited++;
+        if (!BoxContainsPoint(node.min, node.max, worldPos))
+            continue;
+        if (node.count > 0)
+        {
+            for (int s = node.first; s < node.first + node.count; ++s)
+            {
+                if (slotInstances[s] >= 0 && BoxContainsPoint(slotBounds[s].min, slotBounds[s].max, worldPos))
+                    AppendCandidate(slotInstances[s], outIndices);
+            }
+            continue;
+        }
+        stack[top++] = node.first;
+        stack[top++] = nodeIndex + 1;
+    }
+
+    for (int instanceIndex : pendingInstances)
+    {
+        if (BoxContainsPoint(instanceBounds[instanceIndex].min, instanceBounds[instanceIndex].max, worldPos))
+            AppendCandidate(instanceIndex, outIndices);
+    }
+}
+
+void BvhIndex::QueryRay(Ray ray, float maxDistance, FrameVector<int> &outIndices)
+{
+    if (Vector3LengthSqr(ray.direction) < 0.0001f)
+    {
+        Query(ray.position, outIndices);
+        return;
+    }
+    EnsureCurrent();
+    outIndices.clear();
+    queryStats.queries++;
+
+    BvhSegment segment = MakeSegment(ray.position, Vector3Normalize(ray.direction));
+    float tEnter;
+    int stack[BVH_MAX_DEPTH];
+    int top = 0;
+    if (!nodes.empty())
+        stack[top++] = 0;
+    while (top > 0)
+    {
+        int nodeIndex = stack[--top];
+        const BvhNode &node = nodes[nodeIndex];
+        queryStats.cellsVisited++;
+        if (!SegmentEntersBox(segment, node.min, node.max, 0.0f, maxDistance, tEnter))
+            continue;
+        if (node.count > 0)
+        {
+            for (int s = node.first; s < node.first + node.count; ++s)
+            {
+                if (slotInstances[s] >= 0 && SegmentEntersBox(segment, slotBounds[s].min, slotBounds[s].max, 0.0f, maxDistance, tEnter))
+                    AppendCandidate(slotInstances[s], outIndices);
+            }
+            continue;
+        }
+        stack[top++] = node.first;
+        stack[top++] = nodeIndex + 1;
+    }
+
+    for (int instanceIndex : pendingInstances)
+    {
+        if (SegmentEntersBox(segment, instanceBounds[instanceIndex].min, instanceBounds[instanceIndex].max, 0.0f, maxDistance, tEnter))
+            AppendCandidate(instanceIndex, outIndices);
+    }
+}
+
+// A subtree owns one contiguous slot range, from its leftmost to its rightmost leaf
+void BvhIndex::GatherSubtree(int nodeIndex, FrameVector<int> &outIndices)
+{
+    int first = nodeIndex;
+    while (nodes[first].count == 0)
+        first = first + 1;
+    int last = nodeIndex;
+    while (nodes[last].count == 0)
+        last = nodes[last].first;
+    for (int s = nodes[first].first; s < nodes[last].first + nodes[last].count; ++s)
+    {
+        if (slotInstances[s] >= 0)
+            AppendCandidate(slotInstances[s], outIndices);
+    }
+}
+
+void BvhIndex::QueryFrustum(const Frustum &frustum, FrameVector<int> &outInside, FrameVector<int> &outIntersecting)
+{
+    EnsureCurrent();
+    outInside.clear();
+    outIntersecting.clear();
+    queryStats.queries++;
+
+    int stack[BVH_MAX_DEPTH];
+    int top = 0;
+    if (!nodes.empty())
+        stack[top++] = 0;
+    while (top > 0)
+    {
+        int nodeIndex = stack[--top];
+        const BvhNode &node = nodes[nodeIndex];
+        queryStats.cellsVisited++;
+        if (node.min.x > node.max.x)
+            continue; // Refit left nothing in it
+        FrustumTestResult result = FrustumTestBox(frustum, BoundingBox{node.min, node.max});
+        if (result == FRUSTUM_OUTSIDE)
+            continue;
+        if (result == FRUSTUM_INSIDE)
+        {
+            GatherSubtree(nodeIndex, outInside); // No further tests below a node fully inside
+            continue;
+        }
+        if (node.count > 0)
+        {
+            // Leaves crossing a plane sort their own instances
+            for (int s = node.first; s < node.first + node.count; ++s)
+            {
+                if (slotInstances[s] < 0)
+                    continue;
+                FrustumTestResult instanceResult = FrustumTestBox(frustum, slotBounds[s]);
+                if (instanceResult != FRUSTUM_OUTSIDE)
+                    AppendCandidate(slotInstances[s], (instanceResult == FRUSTUM_INSIDE) ? outInside : outIntersecting);
+            }
+            continue;
+        }
+        stack[top++] = node.first;
+        stack[top++] = nodeIndex + 1;
+    }
+
+    for (int instanceIndex : pendingInstances)
+    {
+        FrustumTestResult result = FrustumTestBox(frustum, instanceBounds[instanceIndex]);
+        if (result != FRUSTUM_OUTSIDE)
+            AppendCandidate(instanceIndex, (result == FRUSTUM_INSIDE) ? outInside : outIntersecting);
+    }
+}
+
+GridRayHit BvhIndex::Raycast(Ray ray, float maxDistance, const AsteroidStore &asteroids)
+{
+    EnsureCurrent();
+    queryStats.queries++;
+    return TraceRay(ray, maxDistance, asteroids, queryStats.cellsVisited);
+}
+
+void BvhIndex::RaycastBatch(const Ray *rays, int rayCount, float maxDistance, const AsteroidStore &asteroids,
+                            GridRayHit *outHits, JobSystem *jobs)
+{
+    if (rayCount <= 0)
+        return;
+
+    EnsureCurrent(); // TraceRay is read-only on a current tree, so the rays can run in parallel
+    queryStats.queries += rayCount;
+
+    if (jobs == nullptr)
+    {
+        for (int i = 0; i < rayCount; ++i)
+            outHits[i] = TraceRay(rays[i], maxDistance, asteroids, queryStats.cellsVisited);
+        return;
+    }
+
+    std::atomic<int> nodesVisited(0);
+    const BvhIndex *bvh = this;
+    const AsteroidStore *store = &asteroids;
+    std::atomic<int> *visitedCounter = &nodesVisited;
+    jobs->ParallelFor((size_t)rayCount, GRID_RAY_JOB_CHUNK, [=](size_t begin, size_t end) {
+        int chunkNodes = 0;
+        for (size_t i = begin; i < end; ++i)
+            outHits[i] = bvh->TraceRay(rays[i], maxDistance, *store, chunkNodes);
+        visitedCounter->fetch_add(chunkNodes, std::memory_order_relaxed);
+    });
+    jobs->Wait();
+    queryStats.cellsVisited += nodesVisited.load();
+}
+
+// Nearer child first; a node is skipped once it starts beyond the best hit, since a sphere hit
+// lies inside the sphere's bounds and therefore inside every box above it
+GridRayHit BvhIndex::TraceRay(Ray ray, float maxDistance, const AsteroidStore &asteroids, int &nodesVisited) const
+{
+    GridRayHit bestHit = {-1, maxDistance, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    if (Vector3LengthSqr(ray.direction) < 0.0001f)
+        return bestHit;
+    ray.direction = Vector3Normalize(ray.direction); // Distances are measured along a unit direction
+
+    for (int instanceIndex : pendingInstances)
+        TestInstanceSphere(ray, asteroids, instanceIndex, bestHit);
+
+    BvhSegment segment = MakeSegment(ray.position, ray.direction);
+    int stack[BVH_MAX_DEPTH];
+    float stackEnter[BVH_MAX_DEPTH];
+    int top = 0;
+    float tEnter;
+    if (!nodes.empty() && SegmentEntersBox(segment, nodes[0].min, nodes[0].max, 0.0f, bestHit.distance, tEnter))
+    {
+        stack[top] = 0;
+        stackEnter[top++] = tEnter;
+    }
+    while (top > 0)
+    {
+        --top;
+        if (stackEnter[top] > bestHit.distance)
+            continue;
+        int nodeIndex = stack[top];
+        const BvhNode &node = nodes[nodeIndex];
+        nodesVisited++;
+        if (node.count > 0)
+        {
+            for (int s = node.first; s < node.first + node.count; ++s)
+                TestInstanceSphere(ray, asteroids, slotInstances[s], bestHit);
+            continue;
+        }
+
+        int left = nodeIndex + 1;
+        int right = node.first;
+        float tLeft, tRight;
+        bool hitLeft = SegmentEntersBox(segment, nodes[left].min, nodes[left].max, 0.0f, bestHit.distance, tLeft);
+        bool hitRight = SegmentEntersBox(segment, nodes[right].min, nodes[right].max, 0.0f, bestHit.distance, tRight);
+        if (hitLeft && hitRight)
+        {
+            bool leftFirst = tLeft <= tRight;
+            stack[top] = leftFirst ? right : left; // Farther one below, popped last
+            stackEnter[top++] = leftFirst ? tRight : tLeft;
+            stack[top] = leftFirst ? left : right;
+            stackEnter[top++] = leftFirst ? tLeft : tRight;
+        }
+        else if (hitLeft || hitRight)
+        {
+            stack[top] = hitLeft ? left : right;
+            stackEnter[top++] = hitLeft ? tLeft : tRight;
+        }
+    }
+
+    CompleteRayHit(ray, asteroids, bestHit);
+    return bestHit;
+}
+
+GridSweepHit BvhIndex::SweepSphere(Vector3 start, Vector3 end, float radius, const AsteroidStore &asteroids)
+{
+    GridSweepHit bestHit = {-1, 1.0f, end, {0.0f, 0.0f, 0.0f}};
+    EnsureCurrent();
+    queryStats.queries++;
+
+    Vector3 movement = Vector3Subtract(end, start);
+    float length = Vector3Length(movement);
+    Vector3 direction = (length > 0.0001f) ? Vector3Scale(movement, 1.0f / length) : Vector3{0.0f, 0.0f, 0.0f};
+    float bestDistance = length;
+
+    for (int instanceIndex : pendingInstances)
+    {
+        queryStats.candidates++;
+        SweepTestSphere(start, direction, radius, asteroids, instanceIndex, bestHit, bestDistance);
+    }
+
+    // Contacts happen within radius of the center line, so the boxes are grown by radius. Without
+    // movement the segment is a point, tested for containment on every axis.
+    BvhSegment segment = MakeSegment(start, direction);
+    int stack[BVH_MAX_DEPTH];
+    float stackEnter[BVH_MAX_DEPTH];
+    int top = 0;
+    float tEnter;
+    if (!nodes.empty() && SegmentEntersBox(segment, nodes[0].min, nodes[0].max, radius, bestDistance, tEnter))
+    {
+        stack[top] = 0;
+        stackEnter[top++] = tEnter;
+    }
+    while (top > 0)
+    {
+        --top;
+        if (stackEnter[top] > bestDistance)
+            continue;
+        int nodeIndex = stack[top];
+        const BvhNode &node = nodes[nodeIndex];
+        queryStats.cellsVisited++;
+        if (node.count > 0)
+        {
+            for (int s = node.first; s < node.first + node.count; ++s)
+            {
+                if (slotInstances[s] < 0)
+                    continue;
+                queryStats.candidates++;
+                SweepTestSphere(start, direction, radius, asteroids, slotInstances[s], bestHit, bestDistance);
+            }
+            continue;
+        }
+
+        int left = nodeIndex + 1;
+        int right = node.first;
+        float tLeft, tRight;
+        bool hitLeft = SegmentEntersBox(segment, nodes[left].min, nodes[left].max, radius, bestDistance, tLeft);
+        bool hitRight = SegmentEntersBox(segment, nodes[right].min, nodes[right].max, radius, bestDistance, tRight);
+        if (hitLeft && hitRight)
+        {
+            bool leftFirst = tLeft <= tRight;
+            stack[top] = leftFirst ? right : left;
+            stackEnter[top++] = leftFirst ? tRight : tLeft;
+            stack[top] = leftFirst ? left : right;
+            stackEnter[top++] = leftFirst ? tLeft : tRight;
+        }
+        else if (hitLeft || hitRight)
+        {
+            stack[top] = hitLeft ? left : right;
+            stackEnter[top++] = hitLeft ? tLeft : tRight;
+        }
+    }
+
+    CompleteSweepHit(start, direction, length, asteroids, bestDistance, bestHit);
+    return bestHit;
+}
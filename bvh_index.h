@@ -0,0 +1,114 @@
+#ifndef BVH_INDEX_H
+#define BVH_INDEX_H
+
+#include "raylib.h"
+#include <vector>
+
+#include "spatial_index.h"
+
+//------------------------------------------------------------------------------------
+// Bounding Volume Hierarchy
+//------------------------------------------------------------------------------------
+// Binary AABB tree over the instances' bounds, built top-down with a binned surface area
+// heuristic, so it adapts to clustered fields where a uniform grid leaves most cells empty and
+// overfills the rest. Nodes are flattened depth-first into one array: a node's left child is the
+// next node, the right child is stored in the node, and each leaf owns a contiguous range of
+// leaf-ordered instance slots (indices plus their bounds side by side).
+//
+// Updates stay cheap between rebuilds: Remove leaves a tombstone in its leaf, Add appends to a
+// pending list that every query scans linearly, and Move rewrites the slot's bounds and refits
+// the node boxes bottom-up (the topology is kept) before the next query. Once tombstones and
+// pending entries grow past BVH_REBUILD_FRACTION of the tree (and BVH_MIN_REBUILD_CHANGES),
+// the next query rebuilds the whole tree.
+constexpr int BVH_MAX_LEAF_SIZE = 4;           // Largest leaf, bigger ranges are always split
+constexpr int BVH_SAH_BINS = 16;               // Centroid bins per axis considered for each split
+constexpr float BVH_TRAVERSAL_COST = 1.0f;     // Cost of visiting a node, relative to one bounds test
+constexpr int BVH_MAX_DEPTH = 64;              // Traversal stack size (the build never goes deeper)
+constexpr int BVH_SAH_MAX_DEPTH = 40;          // Past this depth splits fall back to the median
+constexpr int BVH_MIN_REBUILD_CHANGES = 256;   // Pending adds + tombstones tolerated before a rebuild
+constexpr float BVH_REBUILD_FRACTION = 0.125f; // ... or this share of the tree, if larger
+
+// Flattened tree node (32 bytes). count > 0: leaf with slots [first, first + count). count == 0:
+// inner node, the left child follows it and first is the right child.
+typedef struct BvhNode
+{
+    Vector3 min;
+    int first;
+    Vector3 max;
+    int count;
+} BvhNode;
+
+class BvhIndex : public SpatialIndex
+{
+public:
+    BvhIndex();
+    const char *GetName() const override { return "BVH"; }
+    void Clear();
+
+    void BuildInstanced(const AsteroidStore &instances) override;
+    void Add(int instanceIndex, BoundingBox worldBounds) override;
+    void Remove(int instanceIndex) override;
+    void Move(int instanceIndex, BoundingBox oldBounds, BoundingBox newBounds) override;
+    // SAH build over every instance added so far (queries call it when the tree is stale)
+    void Build();
+    // Recompute the node boxes from the slot bounds, keeping the topology (after Move)
+    void Refit();
+
+    void Query(Vector3 worldPos, FrameVector<int> &outIndices) override;
+    void QueryRay(Ray ray, float maxDistance, FrameVector<int> &outIndices) override;
+    void QueryFrustum(const Frustum &frustum, FrameVector<int> &outInside, FrameVector<int> &outIntersecting) override;
+
+    // Front to back: the nearer child is visited first and subtrees beyond the best hit are skipped
+    GridRayHit Raycast(Ray ray, float maxDistance, const AsteroidStore &asteroids) override;
+    void RaycastBatch(const Ray *rays, int rayCount, float maxDistance, const AsteroidStore &asteroids,
+                      GridRayHit *outHits, JobSystem *jobs = nullptr) override;
+    // Segment of the center against node boxes grown by radius, earliest contact first
+    GridSweepHit SweepSphere(Vector3 start, Vector3 end, float radius, const AsteroidStore &asteroids) override;
+
+    const GridQueryStats &GetQueryStats() const override { return queryStats; }
+    void ResetQueryStats() override { queryStats = GridQueryStats{0}; }
+    size_t GetMemoryUsage() const override;
+
+    int GetNodeCount() const { return (int)nodes.size(); }
+    int GetDepth() const { return treeDepth; }
+    int GetPendingCount() const { return (int)pendingInstances.size(); }
+
+private:
+    // Per-instance record: where the instance lives (slot in the tree, pending or absent)
+    enum
+    {
+        BVH_SLOT_NONE = -2,
+        BVH_SLOT_PENDING = -1
+    };
+
+    std::vector<BvhNode> nodes;
+    std::vector<int> slotInstances;          // Leaf-ordered instance indices, -1 for tombstones
+    std::vector<BoundingBox> slotBounds;     // Bounds of each slot (same order)
+    std::vector<int> instanceSlots;          // Indexed by instance: slot, BVH_SLOT_PENDING or BVH_SLOT_NONE
+    std::vector<BoundingBox> instanceBounds; // Indexed by instance, source for Build()
+    std::vector<int> pendingInstances;       // Added since the last build, tested linearly
+    int treeInstances;                       // Live instances in the tree (tombstones excluded)
+    int tombstones;
+    int treeDepth;
+    bool refitDirty;
+    GridQueryStats queryStats;
+
+    // Build scratch (kept for reuse)
+    typedef struct
+    {
+        BoundingBox bounds; // Copied, so the splits read the items in order
+        Vector3 centroid;
+        int instanceIndex;
+    } BvhBuildItem;
+    std::vector<BvhBuildItem> buildItems;
+
+    void EnsureCurrent();
+    int BuildNode(int begin, int end, int depth);
+    int PartitionSah(int begin, int end, int depth, const BoundingBox &bounds); // Split point of buildItems[begin, end)
+
+    GridRayHit TraceRay(Ray ray, float maxDistance, const AsteroidStore &asteroids, int &nodesVisited) const;
+    void GatherSubtree(int nodeIndex, FrameVector<int> &outIndices);
+    void AppendCandidate(int instanceIndex, FrameVector<int> &outIndices);
+};
+
+#endif // BVH_INDEX_H
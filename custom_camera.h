@@ -22,7 +22,7 @@ class CustomCamera
 {
 public:
     Camera3D camera;
-    Vector3 moveSpeed;
+    Vector3 moveSpeed; // Units per second along each axis
     Vector2 mouseSensitivity;
 
 private:
@@ -37,7 +37,7 @@ public:
         Vector3 up = {0.0f, 1.0f, 0.0f},
         float fovy = 60.0f,
         int projection = CAMERA_PERSPECTIVE,
-        Vector3 speed = {0.15f, 0.15f, 0.15f},
+        Vector3 speed = {9.0f, 9.0f, 9.0f},
         Vector2 sensitivity = {0.003f, 0.003f} // Sensitivity set in main.cpp
     )
     {
@@ -68,7 +68,7 @@ public:
         camera.target = Vector3Add(camera.position, cameraFront); // Update target based on new orientation AND current position
     }
 
-    // UpdatePosition method... (keep as is)
+    // Moves the camera based on WASD/Space/Ctrl input, scaled by deltaTime (one simulation tick)
     void UpdatePosition(float deltaTime)
     {
         Vector3 moveVector = {0.0f, 0.0f, 0.0f};
@@ -90,7 +90,7 @@ public:
         if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_C))
             moveVector.y -= moveSpeed.y;
 
-        camera.position = Vector3Add(camera.position, moveVector);
+        camera.position = Vector3Add(camera.position, Vector3Scale(moveVector, deltaTime));
         // Update target again after position change to keep it relative
         camera.target = Vector3Add(camera.position, cameraFront);
     }
@@ -112,6 +112,16 @@ public:
         return camera;
     }
 
+    // Camera for rendering between two simulation ticks: position blended from previousPosition
+    // (alpha 0) to the current one (alpha 1), orientation as of the latest look update
+    Camera3D GetInterpolatedCamera(Vector3 previousPosition, float alpha) const
+    {
+        Camera3D renderCamera = camera;
+        renderCamera.position = Vector3Lerp(previousPosition, camera.position, alpha);
+        renderCamera.target = Vector3Add(renderCamera.position, cameraFront);
+        return renderCamera;
+    }
+
     Ray GetForwardRay() const
     {
         Ray forwardRay;
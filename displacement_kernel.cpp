@@ -0,0 +1,393 @@
+#include "displacement_kernel.h"
+#include <cmath>
+#include <cstring> // For memcpy (float bit casts)
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DISPLACEMENT_KERNEL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DISPLACEMENT_KERNEL_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DISPLACEMENT_KERNEL_NEON
+#endif
+
+//------------------------------------------------------------------------------------
+// Approximation Constants (shared by every path)
+//------------------------------------------------------------------------------------
+// pow(d, s) = exp2(s * log2(d)) for d in (0, 1]. log2 uses the atanh series on the mantissa,
+// exp2 a degree 6 polynomial around the nearest integer; both are accurate to ~1e-6.
+static const float LOBE_MIN_DOT = 1e-6f;  // Directions at or behind a lobe contribute ~0
+static const float EXP2_MIN_INPUT = -126.0f;
+static const float INV_LN2 = 1.44269504f;
+static const float LN2 = 0.693147181f;
+static const float SQRT_MIN_LENGTH_SQR = 1e-24f;
+
+//------------------------------------------------------------------------------------
+// Scalar Path (tails and targets without SIMD)
+//------------------------------------------------------------------------------------
+
+static inline float Log2Scalar(float x)
+{
+    unsigned int bits;
+    memcpy(&bits, &x, sizeof(bits));
+    float exponent = (float)((int)(bits >> 23) - 127);
+    bits = (bits & 0x007FFFFFu) | 0x3F800000u; // Mantissa in [1, 2)
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float poly = 1.0f / 9.0f;
+    poly = poly * t2 + 1.0f / 7.0f;
+    poly = poly * t2 + 1.0f / 5.0f;
+    poly = poly * t2 + 1.0f / 3.0f;
+    poly = poly * t2 + 1.0f;
+    return exponent + 2.0f * t * poly * INV_LN2;
+}
+
+static inline float Exp2Scalar(float y)
+{
+    y = (y < EXP2_MIN_INPUT) ? EXP2_MIN_INPUT : y;
+    int n = (int)lrintf(y);
+    float z = (y - (float)n) * LN2;
+    float poly = 1.0f / 720.0f;
+    poly = poly * z + 1.0f / 120.0f;
+    poly = poly * z + 1.0f / 24.0f;
+    poly = poly * z + 1.0f / 6.0f;
+    poly = poly * z + 0.5f;
+    poly = poly * z + 1.0f;
+    poly = poly * z + 1.0f;
+
+    unsigned int bits = (unsigned int)(n + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return poly * scale;
+}
+
+static inline float EvaluateRadiusScalar(const AsteroidShape &shape, float x, float y, float z)
+{
+    float displacement = 0.0f;
+    for (int l = 0; l < SHAPE_LOBE_COUNT; ++l)
+    {
+        float d = x * shape.directions[l].x + y * shape.directions[l].y + z * shape.directions[l].z;
+        d = (d > LOBE_MIN_DOT) ? d : LOBE_MIN_DOT;
+        displacement += shape.amplitudes[l] * Exp2Scalar(shape.sharpness[l] * Log2Scalar(d));
+    }
+    displacement = fminf(fmaxf(displacement, -0.5f), 1.0f);
+    return shape.baseRadius + shape.baseRadius * shape.irregularity * 0.75f * displacement;
+}
+
+//------------------------------------------------------------------------------------
+// AVX2 Path (8 lanes)
+//------------------------------------------------------------------------------------
+#if defined(DISPLACEMENT_KERNEL_AVX2)
+#define KERNEL_WIDTH 8
+
+static inline __m256 Log2Simd(__m256 x)
+{
+    __m256i bits = _mm256_castps_si256(x);
+    __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+    __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 poly = _mm256_set1_ps(1.0f / 9.0f);
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(1.0f / 7.0f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(1.0f / 5.0f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(1.0f / 3.0f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), one);
+    __m256 lnM = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), t), poly);
+    return _mm256_add_ps(exponent, _mm256_mul_ps(lnM, _mm256_set1_ps(INV_LN2)));
+}
+
+static inline __m256 Exp2Simd(__m256 y)
+{
+    y = _mm256_max_ps(y, _mm256_set1_ps(EXP2_MIN_INPUT));
+    __m256i n = _mm256_cvtps_epi32(y); // Round to nearest
+    __m256 z = _mm256_mul_ps(_mm256_sub_ps(y, _mm256_cvtepi32_ps(n)), _mm256_set1_ps(LN2));
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 poly = _mm256_set1_ps(1.0f / 720.0f);
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, z), _mm256_set1_ps(1.0f / 120.0f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, z), _mm256_set1_ps(1.0f / 24.0f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, z), _mm256_set1_ps(1.0f / 6.0f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, z), _mm256_set1_ps(0.5f));
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, z), one);
+    poly = _mm256_add_ps(_mm256_mul_ps(poly, z), one);
+    __m256 scale = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23));
+    return _mm256_mul_ps(poly, scale);
+}
+
+static int EvaluateShapeRadiiSimd(const AsteroidShape &shape, const float *dirX, const float *dirY, const float *dirZ,
+                                  float *outRadius, int count)
+{
+    __m256 minDot = _mm256_set1_ps(LOBE_MIN_DOT);
+    __m256 radiusScale = _mm256_set1_ps(shape.baseRadius * shape.irregularity * 0.75f);
+    __m256 baseRadius = _mm256_set1_ps(shape.baseRadius);
+    int i = 0;
+    for (; i + KERNEL_WIDTH <= count; i += KERNEL_WIDTH)
+    {
+        __m256 x = _mm256_loadu_ps(dirX + i);
+        __m256 y = _mm256_loadu_ps(dirY + i);
+        __m256 z = _mm256_loadu_ps(dirZ + i);
+        __m256 displacement = _mm256_setzero_ps();
+        for (int l = 0; l < SHAPE_LOBE_COUNT; ++l)
+        {
+            __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(shape.directions[l].x)),
+                                                   _mm256_mul_ps(y, _mm256_set1_ps(shape.directions[l].y))),
+                                     _mm256_mul_ps(z, _mm256_set1_ps(shape.directions[l].z)));
+            d = _mm256_max_ps(d, minDot);
+            __m256 lobe = Exp2Simd(_mm256_mul_ps(_mm256_set1_ps(shape.sharpness[l]), Log2Simd(d)));
+            displacement = _mm256_add_ps(displacement, _mm256_mul_ps(_mm256_set1_ps(shape.amplitudes[l]), lobe));
+        }
+        displacement = _mm256_min_ps(_mm256_max_ps(displacement, _mm256_set1_ps(-0.5f)), _mm256_set1_ps(1.0f));
+        _mm256_storeu_ps(outRadius + i, _mm256_add_ps(baseRadius, _mm256_mul_ps(radiusScale, displacement)));
+    }
+    return i;
+}
+
+static int NormalizeVectorsSimd(float *x, float *y, float *z, int count)
+{
+    int i = 0;
+    for (; i + KERNEL_WIDTH <= count; i += KERNEL_WIDTH)
+    {
+        __m256 vx = _mm256_loadu_ps(x + i);
+        __m256 vy = _mm256_loadu_ps(y + i);
+        __m256 vz = _mm256_loadu_ps(z + i);
+        __m256 lengthSqr = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+        __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(_mm256_max_ps(lengthSqr, _mm256_set1_ps(SQRT_MIN_LENGTH_SQR))));
+        _mm256_storeu_ps(x + i, _mm256_mul_ps(vx, invLength));
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(vy, invLength));
+        _mm256_storeu_ps(z + i, _mm256_mul_ps(vz, invLength));
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------------
+// SSE2 Path (4 lanes)
+//------------------------------------------------------------------------------------
+#elif defined(DISPLACEMENT_KERNEL_SSE2)
+#define KERNEL_WIDTH 4
+
+static inline __m128 Log2Simd(__m128 x)
+{
+    __m128i bits = _mm_castps_si128(x);
+    __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    __m128 t2 = _mm_mul_ps(t, t);
+    __m128 poly = _mm_set1_ps(1.0f / 9.0f);
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(1.0f / 7.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(1.0f / 5.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(1.0f / 3.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, t2), one);
+    __m128 lnM = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), t), poly);
+    return _mm_add_ps(exponent, _mm_mul_ps(lnM, _mm_set1_ps(INV_LN2)));
+}
+
+static inline __m128 Exp2Simd(__m128 y)
+{
+    y = _mm_max_ps(y, _mm_set1_ps(EXP2_MIN_INPUT));
+    __m128i n = _mm_cvtps_epi32(y); // Round to nearest
+    __m128 z = _mm_mul_ps(_mm_sub_ps(y, _mm_cvtepi32_ps(n)), _mm_set1_ps(LN2));
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 poly = _mm_set1_ps(1.0f / 720.0f);
+    poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(1.0f / 120.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(1.0f / 24.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(1.0f / 6.0f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(0.5f));
+    poly = _mm_add_ps(_mm_mul_ps(poly, z), one);
+    poly = _mm_add_ps(_mm_mul_ps(poly, z), one);
+    __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(poly, scale);
+}
+
+static int EvaluateShapeRadiiSimd(const AsteroidShape &shape, const float *dirX, const float *dirY, const float *dirZ,
+                                  float *outRadius, int count)
+{
+    __m128 minDot = _mm_set1_ps(LOBE_MIN_DOT);
+    __m128 radiusScale = _mm_set1_ps(shape.baseRadius * shape.irregularity * 0.75f);
+    __m128 baseRadius = _mm_set1_ps(shape.baseRadius);
+    int i = 0;
+    for (; i + KERNEL_WIDTH <= count; i += KERNEL_WIDTH)
+    {
+        __m128 x = _mm_loadu_ps(dirX + i);
+        __m128 y = _mm_loadu_ps(dirY + i);
+        __m128 z = _mm_loadu_ps(dirZ + i);
+        __m128 displacement = _mm_setzero_ps();
+        for (int l = 0; l < SHAPE_LOBE_COUNT; ++l)
+        {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(shape.directions[l].x)),
+                                             _mm_mul_ps(y, _mm_set1_ps(shape.directions[l].y))),
+                                  _mm_mul_ps(z, _mm_set1_ps(shape.directions[l].z)));
+            d = _mm_max_ps(d, minDot);
+            __m128 lobe = Exp2Simd(_mm_mul_ps(_mm_set1_ps(shape.sharpness[l]), Log2Simd(d)));
+            displacement = _mm_add_ps(displacement, _mm_mul_ps(_mm_set1_ps(shape.amplitudes[l]), lobe));
+        }
+        displacement = _mm_min_ps(_mm_max_ps(displacement, _mm_set1_ps(-0.5f)), _mm_set1_ps(1.0f));
+        _mm_storeu_ps(outRadius + i, _mm_add_ps(baseRadius, _mm_mul_ps(radiusScale, displacement)));
+    }
+    return i;
+}
+
+static int NormalizeVectorsSimd(float *x, float *y, float *z, int count)
+{
+    int i = 0;
+    for (; i + KERNEL_WIDTH <= count; i += KERNEL_WIDTH)
+    {
+        __m128 vx = _mm_loadu_ps(x + i);
+        __m128 vy = _mm_loadu_ps(y + i);
+        __m128 vz = _mm_loadu_ps(z + i);
+        __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+        __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSqr, _mm_set1_ps(SQRT_MIN_LENGTH_SQR))));
+        _mm_storeu_ps(x + i, _mm_mul_ps(vx, invLength));
+        _mm_storeu_ps(y + i, _mm_mul_ps(vy, invLength));
+        _mm_storeu_ps(z + i, _mm_mul_ps(vz, invLength));
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------------
+// NEON Path (AArch64, 4 lanes)
+//------------------------------------------------------------------------------------
+#elif defined(DISPLACEMENT_KERNEL_NEON)
+#define KERNEL_WIDTH 4
+
+static inline float32x4_t Log2Simd(float32x4_t x)
+{
+    uint32x4_t bits = vreinterpretq_u32_f32(x);
+    float32x4_t exponent = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127)));
+    float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F800000)));
+
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t t = vdivq_f32(vsubq_f32(m, one), vaddq_f32(m, one));
+    float32x4_t t2 = vmulq_f32(t, t);
+    float32x4_t poly = vdupq_n_f32(1.0f / 9.0f);
+    poly = vaddq_f32(vmulq_f32(poly, t2), vdupq_n_f32(1.0f / 7.0f));
+    poly = vaddq_f32(vmulq_f32(poly, t2), vdupq_n_f32(1.0f / 5.0f));
+    poly = vaddq_f32(vmulq_f32(poly, t2), vdupq_n_f32(1.0f / 3.0f));
+    poly = vaddq_f32(vmulq_f32(poly, t2), one);
+    float32x4_t lnM = vmulq_f32(vmulq_f32(vdupq_n_f32(2.0f), t), poly);
+    return vaddq_f32(exponent, vmulq_f32(lnM, vdupq_n_f32(INV_LN2)));
+}
+
+static inline float32x4_t Exp2Simd(float32x4_t y)
+{
+    y = vmaxq_f32(y, vdupq_n_f32(EXP2_MIN_INPUT));
+    int32x4_t n = vcvtnq_s32_f32(y); // Round to nearest
+    float32x4_t z = vmulq_f32(vsubq_f32(y, vcvtq_f32_s32(n)), vdupq_n_f32(LN2));
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t poly = vdupq_n_f32(1.0f / 720.0f);
+    poly = vaddq_f32(vmulq_f32(poly, z), vdupq_n_f32(1.0f / 120.0f));
+    poly = vaddq_f32(vmulq_f32(poly, z), vdupq_n_f32(1.0f / 24.0f));
+    poly = vaddq_f32(vmulq_f32(poly, z), vdupq_n_f32(1.0f / 6.0f));
+    poly = vaddq_f32(vmulq_f32(poly, z), vdupq_n_f32(0.5f));
+    poly = vaddq_f32(vmulq_f32(poly, z), one);
+    poly = vaddq_f32(vmulq_f32(poly, z), one);
+    float32x4_t scale = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n, vdupq_n_s32(127)), 23));
+    return vmulq_f32(poly, scale);
+}
+
+static int EvaluateShapeRadiiSimd(const AsteroidShape &shape, const float *dirX, const float *dirY, const float *dirZ,
+                                  float *outRadius, int count)
+{
+    float32x4_t minDot = vdupq_n_f32(LOBE_MIN_DOT);
+    float32x4_t radiusScale = vdupq_n_f32(shape.baseRadius * shape.irregularity * 0.75f);
+    float32x4_t baseRadius = vdupq_n_f32(shape.baseRadius);
+    int i = 0;
+    for (; i + KERNEL_WIDTH <= count; i += KERNEL_WIDTH)
+    {
+        float32x4_t x = vld1q_f32(dirX + i);
+        float32x4_t y = vld1q_f32(dirY + i);
+        float32x4_t z = vld1q_f32(dirZ + i);
+        float32x4_t displacement = vdupq_n_f32(0.0f);
+        for (int l = 0; l < SHAPE_LOBE_COUNT; ++l)
+        {
+            float32x4_t d = vaddq_f32(vaddq_f32(vmulq_f32(x, vdupq_n_f32(shape.directions[l].x)),
+                                                vmulq_f32(y, vdupq_n_f32(shape.directions[l].y))),
+                                      vmulq_f32(z, vdupq_n_f32(shape.directions[l].z)));
+            d = vmaxq_f32(d, minDot);
+            float32x4_t lobe = Exp2Simd(vmulq_f32(vdupq_n_f32(shape.sharpness[l]), Log2Simd(d)));
+            displacement = vaddq_f32(displacement, vmulq_f32(vdupq_n_f32(shape.amplitudes[l]), lobe));
+        }
+        displacement = vminq_f32(vmaxq_f32(displacement, vdupq_n_f32(-0.5f)), vdupq_n_f32(1.0f));
+        vst1q_f32(outRadius + i, vaddq_f32(baseRadius, vmulq_f32(radiusScale, displacement)));
+    }
+    return i;
+}
+
+static int NormalizeVectorsSimd(float *x, float *y, float *z, int count)
+{
+    int i = 0;
+    for (; i + KERNEL_WIDTH <= count; i += KERNEL_WIDTH)
+    {
+        float32x4_t vx = vld1q_f32(x + i);
+        float32x4_t vy = vld1q_f32(y + i);
+        float32x4_t vz = vld1q_f32(z + i);
+        float32x4_t lengthSqr = vaddq_f32(vaddq_f32(vmulq_f32(vx, vx), vmulq_f32(vy, vy)), vmulq_f32(vz, vz));
+        float32x4_t invLength = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(vmaxq_f32(lengthSqr, vdupq_n_f32(SQRT_MIN_LENGTH_SQR))));
+        vst1q_f32(x + i, vmulq_f32(vx, invLength));
+        vst1q_f32(y + i, vmulq_f32(vy, invLength));
+        vst1q_f32(z + i, vmulq_f32(vz, invLength));
+    }
+    return i;
+}
+
+//------------------------------------------------------------------------------------
+// No SIMD: everything goes through the scalar loops below
+//------------------------------------------------------------------------------------
+#else
+
+static int EvaluateShapeRadiiSimd(const AsteroidShape &, const float *, const float *, const float *, float *, int)
+{
+    return 0;
+}
+
+static int NormalizeVectorsSimd(float *, float *, float *, int)
+{
+    return 0;
+}
+
+#endif
+
+//------------------------------------------------------------------------------------
+// Kernel Entry Points
+//------------------------------------------------------------------------------------
+
+void EvaluateShapeRadii(const AsteroidShape &shape, const float *dirX, const float *dirY, const float *dirZ,
+                        float *outRadius, int count)
+{
+    int i = EvaluateShapeRadiiSimd(shape, dirX, dirY, dirZ, outRadius, count);
+    for (; i < count; ++i)
+        outRadius[i] = EvaluateRadiusScalar(shape, dirX[i], dirY[i], dirZ[i]);
+}
+
+void NormalizeVectors(float *x, float *y, float *z, int count)
+{
+    int i = NormalizeVectorsSimd(x, y, z, count);
+    for (; i < count; ++i)
+    {
+        float lengthSqr = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        float invLength = 1.0f / sqrtf(fmaxf(lengthSqr, SQRT_MIN_LENGTH_SQR));
+        x[i] *= invLength;
+        y[i] *= invLength;
+        z[i] *= invLength;
+    }
+}
+
+const char *GetDisplacementKernelName()
+{
+#if defined(DISPLACEMENT_KERNEL_AVX2)
+    return "AVX2";
+#elif defined(DISPLACEMENT_KERNEL_SSE2)
+    return "SSE2";
+#elif defined(DISPLACEMENT_KERNEL_NEON)
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
@@ -0,0 +1,40 @@
+#ifndef DISPLACEMENT_KERNEL_H
+#define DISPLACEMENT_KERNEL_H
+
+#include "raylib.h"
+
+//------------------------------------------------------------------------------------
+// Procedural Asteroid Shape
+//------------------------------------------------------------------------------------
+// Radial displacement is a sum of random lobes evaluated on the unit direction of each
+// vertex, so every resolution (and every duplicated seam vertex) is displaced identically.
+constexpr int SHAPE_LOBE_COUNT = 8;
+
+typedef struct
+{
+    Vector3 directions[SHAPE_LOBE_COUNT]; // Lobe centers (unit vectors)
+    float amplitudes[SHAPE_LOBE_COUNT];   // Negative lobes dent, positive lobes bulge
+    float sharpness[SHAPE_LOBE_COUNT];    // Falloff exponent of each lobe
+    float baseRadius;
+    float irregularity;
+} AsteroidShape;
+
+//------------------------------------------------------------------------------------
+// Vectorized Kernels
+//------------------------------------------------------------------------------------
+// Inputs and outputs are structure-of-arrays float streams. The widest instruction set
+// enabled at compile time is used (AVX2: 8 lanes, SSE2/NEON on AArch64: 4 lanes), with a
+// scalar loop for the tail and for other targets. Every path evaluates the same polynomial
+// approximations, so results agree to within float rounding.
+
+// Surface radius of the shape along each unit direction (dirX/dirY/dirZ[i] -> outRadius[i])
+void EvaluateShapeRadii(const AsteroidShape &shape, const float *dirX, const float *dirY, const float *dirZ,
+                        float *outRadius, int count);
+
+// Normalize count vectors in place (zero vectors stay zero)
+void NormalizeVectors(float *x, float *y, float *z, int count);
+
+// Instruction set the kernels were compiled for ("AVX2", "SSE2", "NEON" or "Scalar")
+const char *GetDisplacementKernelName();
+
+#endif // DISPLACEMENT_KERNEL_H
@@ -0,0 +1,354 @@
+#include "field_cache.h"
+#include <cstdio>  // For fopen, snprintf, rename
+#include <cstring> // For memcpy, memset
+#include <vector>
+
+//------------------------------------------------------------------------------------
+// File Layout
+//------------------------------------------------------------------------------------
+// FieldCacheHeader, then the sections at the offsets listed in its section table. Every
+// section starts on a FIELD_CACHE_ALIGNMENT boundary, so the mapped arrays are aligned too.
+typedef enum
+{
+    CACHE_SECTION_MESHES = 0, // FieldCacheMesh records (their blobs follow in CACHE_SECTION_MESH_DATA)
+    CACHE_SECTION_MESH_DATA,
+    CACHE_SECTION_RADII,
+    CACHE_SECTION_POSITIONS,
+    CACHE_SECTION_COLLISION_RADII,
+    CACHE_SECTION_ROTATION_ANGLES,
+    CACHE_SECTION_ROTATION_SPEEDS,
+    CACHE_SECTION_HIT_POINTS,
+    CACHE_SECTION_COLD,
+    CACHE_SECTION_GRID, // UniformGrid::Serialize blob (empty for a streamed field)
+    CACHE_SECTION_COUNT
+} FieldCacheSectionId;
+
+typedef struct
+{
+    uint64_t offset; // From the start of the file
+    uint64_t size;   // Bytes
+} FieldCacheSection;
+
+typedef struct
+{
+    unsigned int magic;
+    unsigned int version;
+    uint64_t fileSize;
+    FieldCacheKey key;
+    int meshCount;
+    int padding;
+    FieldCacheSection sections[CACHE_SECTION_COUNT];
+} FieldCacheHeader;
+
+// Mesh record, blob offsets are from the start of the file
+typedef struct
+{
+    int vertexCount;
+    int triangleCount;
+    uint64_t vertexOffset;   // vertexCount * 3 floats
+    uint64_t normalOffset;   // vertexCount * 3 floats
+    uint64_t texcoordOffset; // vertexCount * 2 floats
+    uint64_t indexOffset;    // triangleCount * 3 unsigned shorts
+} FieldCacheMesh;
+
+static const unsigned int FIELD_CACHE_MAGIC = 0x43464641; // "AFFC"
+static const size_t FIELD_CACHE_ALIGNMENT = 16;
+
+//------------------------------------------------------------------------------------
+// Keys
+//------------------------------------------------------------------------------------
+// FNV-1a, used for the config hash and the file name
+static void HashBytes(uint64_t &hash, const void *bytes, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        hash ^= ((const unsigned char *)bytes)[i];
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+FieldCacheKey MakeFieldCacheKey(uint64_t seed, const FieldConfig &config, bool streamed)
+{
+    FieldCacheKey key;
+    memset(&key, 0, sizeof(key));
+    key.seed = seed;
+    key.variantCount = config.meshVariants;
+    key.lodCount = AsteroidFieldConstants::NUM_LOD_LEVELS;
+    key.asteroidCount = streamed ? 0 : config.asteroidCount;
+    key.streamed = streamed ? 1 : 0;
+    key.cellSize = config.autoCellSize ? Vector3{0.0f, 0.0f, 0.0f} : config.gridCellSize;
+    key.coldDataSize = (int)sizeof(AsteroidColdData);
+
+    // Field by field, FieldConfig has padding (draw distance and seed do not change the field)
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    HashBytes(hash, &config.clusterCount, sizeof(config.clusterCount));
+    HashBytes(hash, &config.clusterSpreadRadius, sizeof(config.clusterSpreadRadius));
+    HashBytes(hash, &config.scatterRadius, sizeof(config.scatterRadius));
+    HashBytes(hash, &config.largeAsteroidChance, sizeof(config.largeAsteroidChance));
+    HashBytes(hash, &config.minRotationSpeed, sizeof(config.minRotationSpeed));
+    HashBytes(hash, &config.maxRotationSpeed, sizeof(config.maxRotationSpeed));
+    HashBytes(hash, &config.initialHitPoints, sizeof(config.initialHitPoints));
+    HashBytes(hash, &config.meshIrregularity, sizeof(config.meshIrregularity));
+    HashBytes(hash, &config.shakeMagnitude, sizeof(config.shakeMagnitude));
+    unsigned char autoCellSize = config.autoCellSize ? 1 : 0;
+    HashBytes(hash, &autoCellSize, sizeof(autoCellSize));
+    key.configHash = hash;
+    return key;
+}
+
+static bool KeysMatch(const FieldCacheKey &a, const FieldCacheKey &b)
+{
+    return a.seed == b.seed && a.variantCount == b.variantCount && a.lodCount == b.lodCount &&
+           a.asteroidCount == b.asteroidCount && a.streamed == b.streamed && a.cellSize.x == b.cellSize.x &&
+           a.cellSize.y == b.cellSize.y && a.cellSize.z == b.cellSize.z && a.coldDataSize == b.coldDataSize &&
+           a.configHash == b.configHash;
+}
+
+// Hash of the key fields (the format version is part of it, old files are simply never opened)
+std::string GetFieldCachePath(const FieldCacheKey &key)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    HashBytes(hash, &FIELD_CACHE_VERSION, sizeof(FIELD_CACHE_VERSION));
+    HashBytes(hash, &key.seed, sizeof(key.seed));
+    HashBytes(hash, &key.variantCount, sizeof(key.variantCount));
+    HashBytes(hash, &key.lodCount, sizeof(key.lodCount));
+    HashBytes(hash, &key.asteroidCount, sizeof(key.asteroidCount));
+    HashBytes(hash, &key.streamed, sizeof(key.streamed));
+    HashBytes(hash, &key.cellSize, sizeof(key.cellSize));
+    HashBytes(hash, &key.coldDataSize, sizeof(key.coldDataSize));
+    HashBytes(hash, &key.configHash, sizeof(key.configHash));
+
+    char path[64];
+    snprintf(path, sizeof(path), "asteroid_field_%016llx.cache", (unsigned long long)hash);
+    return std::string(path);
+}
+
+//------------------------------------------------------------------------------------
+// Saving
+//------------------------------------------------------------------------------------
+static size_t AppendAligned(std::vector<unsigned char> &out, const void *bytes, size_t count)
+{
+    size_t offset = (out.size() + FIELD_CACHE_ALIGNMENT - 1) & ~(FIELD_CACHE_ALIGNMENT - 1);
+    out.resize(offset + count, 0);
+    if (count > 0)
+        memcpy(out.data() + offset, bytes, count);
+    return offset;
+}
+
+template <typename T>
+static void AppendSection(std::vector<unsigned char> &out, FieldCacheHeader &header, FieldCacheSectionId id,
+                          const std::vector<T> &values)
+{
+    header.sections[id].offset = AppendAligned(out, values.data(), values.size() * sizeof(T));
+    header.sections[id].size = values.size() * sizeof(T);
+}
+
+bool SaveFieldCache(const char *path, const FieldCacheKey &key, const AsteroidMeshPool &meshPool,
+                    const AsteroidStore &asteroids, UniformGrid *grid)
+{
+    FieldCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = FIELD_CACHE_MAGIC;
+    header.version = FIELD_CACHE_VERSION;
+    header.key = key;
+    header.meshCount = (int)meshPool.meshes.size();
+
+    std::vector<unsigned char> file(sizeof(header), 0);
+
+    // Mesh blobs first, then the records pointing at them
+    std::vector<FieldCacheMesh> records(meshPool.meshes.size());
+    size_t meshDataStart = (file.size() + FIELD_CACHE_ALIGNMENT - 1) & ~(FIELD_CACHE_ALIGNMENT - 1);
+    for (size_t m = 0; m < meshPool.meshes.size(); ++m)
+    {
+        const Mesh &mesh = meshPool.meshes[m];
+        if (mesh.vertices == nullptr || mesh.normals == nullptr || mesh.texcoords == nullptr || mesh.indices == nullptr)
+        {
+            TraceLog(LOG_WARNING, "CACHE: Mesh %d has no CPU data, field not cached", (int)m);
+            return false;
+        }
+        FieldCacheMesh &record = records[m];
+        record.vertexCount = mesh.vertexCount;
+        record.triangleCount = mesh.triangleCount;
+        record.vertexOffset = AppendAligned(file, mesh.vertices, (size_t)mesh.vertexCount * 3 * sizeof(float));
+        record.normalOffset = AppendAligned(file, mesh.normals, (size_t)mesh.vertexCount * 3 * sizeof(float));
+        record.texcoordOffset = AppendAligned(file, mesh.texcoords, (size_t)mesh.vertexCount * 2 * sizeof(float));
+        record.indexOffset = AppendAligned(file, mesh.indices, (size_t)mesh.triangleCount * 3 * sizeof(unsigned short));
+    }
+    header.sections[CACHE_SECTION_MESH_DATA].offset = meshDataStart;
+    header.sections[CACHE_SECTION_MESH_DATA].size = (file.size() > meshDataStart) ? file.size() - meshDataStart : 0;
+    AppendSection(file, header, CACHE_SECTION_MESHES, records);
+    AppendSection(file, header, CACHE_SECTION_RADII, meshPool.radii);
+
+    AppendSection(file, header, CACHE_SECTION_POSITIONS, asteroids.positions);
+    AppendSection(file, header, CACHE_SECTION_COLLISION_RADII, asteroids.collisionRadii);
+    AppendSection(file, header, CACHE_SECTION_ROTATION_ANGLES, asteroids.rotationAngles);
+    AppendSection(file, header, CACHE_SECTION_ROTATION_SPEEDS, asteroids.rotationSpeeds);
+    AppendSection(file, header, CACHE_SECTION_HIT_POINTS, asteroids.hitPoints);
+    AppendSection(file, header, CACHE_SECTION_COLD, asteroids.cold);
+
+    std::vector<unsigned char> gridBlob;
+    if (grid != nullptr)
+        grid->Serialize(gridBlob);
+    AppendSection(file, header, CACHE_SECTION_GRID, gridBlob);
+
+    header.fileSize = file.size();
+    memcpy(file.data(), &header, sizeof(header));
+
+    // Write next to the target and rename over it once complete
+    std::string tempPath = std::string(path) + ".tmp";
+    FILE *out = fopen(tempPath.c_str(), "wb");
+    if (out == nullptr)
+    {
+        TraceLog(LOG_WARNING, "CACHE: Could not create %s", tempPath.c_str());
+        return false;
+    }
+    bool written = fwrite(file.data(), 1, file.size(), out) == file.size();
+    written = (fclose(out) == 0) && written;
+    remove(path); // rename does not replace an existing file on Windows
+    if (!written || rename(tempPath.c_str(), path) != 0)
+    {
+        TraceLog(LOG_WARNING, "CACHE: Could not write %s", path);
+        remove(tempPath.c_str());
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "CACHE: Saved field to %s (%.2f MB)", path, (double)file.size() / (1024.0 * 1024.0));
+    return true;
+}
+
+//------------------------------------------------------------------------------------
+// Loading
+//------------------------------------------------------------------------------------
+static bool RangeInFile(uint64_t offset, uint64_t size, uint64_t fileSize)
+{
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+// Section as a typed array of exactly count elements (any count if count < 0)
+template <typename T>
+static const T *GetSection(const unsigned char *data, const FieldCacheHeader &header, FieldCacheSectionId id, long long count)
+{
+    const FieldCacheSection &section = header.sections[id];
+    if (section.offset % alignof(T) != 0 || section.size % sizeof(T) != 0)
+        return nullptr;
+    if (count >= 0 && section.size != (uint64_t)count * sizeof(T))
+        return nullptr;
+    return (const T *)(data + section.offset);
+}
+
+bool LoadFieldCache(const char *path, const FieldCacheKey &key, MappedFile &mapping, AsteroidMeshPool &outPool,
+                    AsteroidStore &outAsteroids, UniformGrid *&outGrid)
+{
+    if (!mapping.Open(path))
+        return false; // No cache yet
+
+    const unsigned char *data = mapping.GetData();
+    FieldCacheHeader header;
+    bool valid = mapping.GetSize() >= sizeof(header);
+    if (valid)
+        memcpy(&header, data, sizeof(header));
+    valid = valid && header.magic == FIELD_CACHE_MAGIC && header.version == FIELD_CACHE_VERSION &&
+            header.fileSize == mapping.GetSize() && KeysMatch(header.key, key) &&
+            header.meshCount == key.variantCount * key.lodCount;
+    for (int s = 0; valid && s < CACHE_SECTION_COUNT; ++s)
+        valid = RangeInFile(header.sections[s].offset, header.sections[s].size, header.fileSize);
+
+    int asteroidCount = key.asteroidCount;
+    const FieldCacheMesh *records = valid ? GetSection<FieldCacheMesh>(data, header, CACHE_SECTION_MESHES, header.meshCount) : nullptr;
+    const float *radii = valid ? GetSection<float>(data, header, CACHE_SECTION_RADII, key.variantCount) : nullptr;
+    const Vector3 *positions = valid ? GetSection<Vector3>(data, header, CACHE_SECTION_POSITIONS, asteroidCount) : nullptr;
+    const float *collisionRadii = valid ? GetSection<float>(data, header, CACHE_SECTION_COLLISION_RADII, asteroidCount) : nullptr;
+    const float *rotationAngles = valid ? GetSection<float>(data, header, CACHE_SECTION_ROTATION_ANGLES, asteroidCount) : nullptr;
+    const float *rotationSpeeds = valid ? GetSection<float>(data, header, CACHE_SECTION_ROTATION_SPEEDS, asteroidCount) : nullptr;
+    const int *hitPoints = valid ? GetSection<int>(data, header, CACHE_SECTION_HIT_POINTS, asteroidCount) : nullptr;
+    const AsteroidColdData *cold = valid ? GetSection<AsteroidColdData>(data, header, CACHE_SECTION_COLD, asteroidCount) : nullptr;
+    valid = records != nullptr && radii != nullptr && positions != nullptr && collisionRadii != nullptr &&
+            rotationAngles != nullptr && rotationSpeeds != nullptr && hitPoints != nullptr && cold != nullptr;
+
+    // Every mesh blob must lie inside the file and be aligned for its element type
+    for (int m = 0; valid && m < header.meshCount; ++m)
+    {
+        const FieldCacheMesh &record = records[m];
+        uint64_t vertexBytes = (uint64_t)record.vertexCount * 3 * sizeof(float);
+        valid = record.vertexCount > 0 && record.vertexCount <= 65536 && record.triangleCount > 0 &&
+                record.vertexOffset % 4 == 0 && record.normalOffset % 4 == 0 && record.texcoordOffset % 4 == 0 &&
+                record.indexOffset % 2 == 0 && RangeInFile(record.vertexOffset, vertexBytes, header.fileSize) &&
+                RangeInFile(record.normalOffset, vertexBytes, header.fileSize) &&
+                RangeInFile(record.texcoordOffset, (uint64_t)record.vertexCount * 2 * sizeof(float), header.fileSize) &&
+                RangeInFile(record.indexOffset, (uint64_t)record.triangleCount * 3 * sizeof(unsigned short), header.fileSize);
+    }
+    for (int m = 0; valid && m < header.meshCount; ++m)
+    {
+        // Out of range indices would make the GPU read past the vertex buffers
+        const unsigned short *indices = (const unsigned short *)(data + records[m].indexOffset);
+        for (int t = 0; valid && t < records[m].triangleCount * 3; ++t)
+            valid = indices[t] < records[m].vertexCount;
+    }
+    for (int i = 0; valid && i < asteroidCount; ++i)
+        valid = cold[i].variantIndex >= 0 && cold[i].variantIndex < key.variantCount;
+
+    UniformGrid *grid = nullptr;
+    if (valid && header.sections[CACHE_SECTION_GRID].size > 0)
+    {
+        grid = UniformGrid::Deserialize(data + header.sections[CACHE_SECTION_GRID].offset,
+                                        (size_t)header.sections[CACHE_SECTION_GRID].size);
+        // Move/Remove index the grid's range records by asteroid, so they must cover exactly the cached field
+        valid = grid != nullptr && grid->GetInstanceCapacity() == asteroidCount;
+    }
+    if (!valid)
+    {
+        TraceLog(LOG_WARNING, "CACHE: %s is stale or damaged, regenerating", path);
+        delete grid;
+        mapping.Close();
+        return false;
+    }
+
+    // Meshes reference the mapping directly (read-only pages: UploadMesh only reads them)
+    AsteroidMeshPool pool;
+    pool.lodCount = key.lodCount;
+    pool.meshes.resize(header.meshCount);
+    for (int m = 0; m < header.meshCount; ++m)
+    {
+        const FieldCacheMesh &record = records[m];
+        Mesh mesh = {0};
+        mesh.vertexCount = record.vertexCount;
+        mesh.triangleCount = record.triangleCount;
+        mesh.vertices = (float *)(data + record.vertexOffset);
+        mesh.normals = (float *)(data + record.normalOffset);
+        mesh.texcoords = (float *)(data + record.texcoordOffset);
+        mesh.indices = (unsigned short *)(data + record.indexOffset);
+        pool.meshes[m] = mesh;
+    }
+    pool.radii.assign(radii, radii + key.variantCount);
+
+    // Asteroids restart from their initial state, exactly as InitializeAsteroidField leaves them
+    AsteroidStore store;
+    store.Resize(asteroidCount);
+    for (int i = 0; i < asteroidCount; ++i)
+        store.Set(i, positions[i], collisionRadii[i], rotationAngles[i], rotationSpeeds[i], hitPoints[i], cold[i]);
+
+    outPool = std::move(pool);
+    outAsteroids = std::move(store);
+    outGrid = grid;
+    return true;
+}
+
+void DetachMappedMeshes(AsteroidMeshPool &meshPool)
+{
+    for (size_t m = 0; m < meshPool.meshes.size(); ++m)
+    {
+        Mesh &mesh = meshPool.meshes[m];
+        mesh.vertices = nullptr;
+        mesh.normals = nullptr;
+        mesh.texcoords = nullptr;
+        if (mesh.indices != nullptr)
+        {
+            // DrawMesh and DrawMeshInstanced only take the indexed path while indices is set, so
+            // the (small) index data gets its own copy, released by UnloadMesh
+            size_t indexBytes = (size_t)mesh.triangleCount * 3 * sizeof(unsigned short);
+            unsigned short *indices = (unsigned short *)MemAlloc((unsigned int)indexBytes);
+            memcpy(indices, mesh.indices, indexBytes);
+            mesh.indices = indices;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef FIELD_CACHE_H
+#define FIELD_CACHE_H
+
+#include "raylib.h"
+#include <string>
+#include <cstdint>
+
+#include "asteroid_field.h"
+#include "asteroid_store.h"
+#include "uniform_grid.h"
+#include "mapped_file.h"
+
+//------------------------------------------------------------------------------------
+// Binary Field Cache
+//------------------------------------------------------------------------------------
+// A generated field (mesh vertex/index blobs, initial asteroid state, packed collision grid)
+// written to one file, so a field that was generated before loads without any procedural
+// generation. The file is memory-mapped on load: the meshes point straight into the mapping
+// and are uploaded from there, only asteroid state and grid arrays are copied out.
+// Files are keyed by the seed and generation parameters and carry a format version; bump
+// FIELD_CACHE_VERSION whenever mesh or field generation changes its output.
+constexpr unsigned int FIELD_CACHE_VERSION = 2;
+
+typedef struct
+{
+    uint64_t seed;
+    int variantCount;
+    int lodCount;
+    int asteroidCount; // 0 for a streamed field (meshes only)
+    int streamed;
+    Vector3 cellSize;  // Zero when auto-tuned (the grid in the file has the tuned size)
+    int coldDataSize;  // sizeof(AsteroidColdData), guards against layout changes between builds
+    uint64_t configHash; // The remaining FieldConfig generation parameters
+} FieldCacheKey;
+
+FieldCacheKey MakeFieldCacheKey(uint64_t seed, const FieldConfig &config, bool streamed);
+std::string GetFieldCachePath(const FieldCacheKey &key); // In the working directory, one file per key
+
+// Write the field to path (through a temporary file, so a crash never leaves a torn cache).
+// Mesh CPU buffers must still be present. grid may be nullptr (streamed field).
+bool SaveFieldCache(const char *path, const FieldCacheKey &key, const AsteroidMeshPool &meshPool,
+                    const AsteroidStore &asteroids, UniformGrid *grid);
+// Map path and fill the outputs if it holds a valid cache for key; false on any mismatch or
+// damage (outputs untouched). The pool's meshes point into mapping, which must stay open until
+// they are uploaded and DetachMappedMeshes has been called. outGrid is nullptr if the file has no grid.
+bool LoadFieldCache(const char *path, const FieldCacheKey &key, MappedFile &mapping, AsteroidMeshPool &outPool,
+                    AsteroidStore &outAsteroids, UniformGrid *&outGrid);
+// Forget the mapped CPU buffers of a pool loaded from a cache (UnloadMesh must not free them).
+// Index data is copied to the heap instead, raylib draws a mesh without indices as a triangle list.
+void DetachMappedMeshes(AsteroidMeshPool &meshPool);
+
+#endif // FIELD_CACHE_H
@@ -0,0 +1,308 @@
+#include "field_config.h"
+#include "asteroid_field.h" // Defaults (AsteroidFieldConstants)
+#include "raymath.h"
+#include <algorithm>        // For std::sort, std::unique, std::nth_element
+#include <cmath>            // For floorf, fmaxf
+#include <cstddef>          // For offsetof
+#include <cstdio>           // For sscanf
+#include <cstdlib>          // For strtol, strtof, strtoull
+#include <cstring>          // For strcmp, strchr
+#include <string>
+
+//------------------------------------------------------------------------------------
+// Option Table
+//------------------------------------------------------------------------------------
+typedef enum
+{
+    FIELD_OPTION_INT = 0,
+    FIELD_OPTION_FLOAT,
+    FIELD_OPTION_BOOL,
+    FIELD_OPTION_CELL_SIZE,
+    FIELD_OPTION_SEED
+} FieldOptionType;
+
+typedef struct
+{
+    const char *name;
+    FieldOptionType type;
+    size_t offset; // Into FieldConfig
+    float minValue;
+    float maxValue;
+} FieldOption;
+
+static const FieldOption fieldOptions[] = {
+    {"asteroids", FIELD_OPTION_INT, offsetof(FieldConfig, asteroidCount), 0.0f, 1000000.0f},
+    {"clusters", FIELD_OPTION_INT, offsetof(FieldConfig, clusterCount), 1.0f, 100000.0f},
+    {"cluster_spread", FIELD_OPTION_FLOAT, offsetof(FieldConfig, clusterSpreadRadius), 0.0f, 100000.0f},
+    {"scatter_radius", FIELD_OPTION_FLOAT, offsetof(FieldConfig, scatterRadius), 0.1f, 1000.0f},
+    {"large_chance", FIELD_OPTION_FLOAT, offsetof(FieldConfig, largeAsteroidChance), 0.0f, 1.0f},
+    {"min_rotation_speed", FIELD_OPTION_FLOAT, offsetof(FieldConfig, minRotationSpeed), 0.0f, 3600.0f},
+    {"max_rotation_speed", FIELD_OPTION_FLOAT, offsetof(FieldConfig, maxRotationSpeed), 0.0f, 3600.0f},
+    {"hit_points", FIELD_OPTION_INT, offsetof(FieldConfig, initialHitPoints), 1.0f, 1000.0f},
+    {"mesh_irregularity", FIELD_OPTION_FLOAT, offsetof(FieldConfig, meshIrregularity), 0.0f, 2.0f},
+    {"shake_magnitude", FIELD_OPTION_FLOAT, offsetof(FieldConfig, shakeMagnitude), 0.0f, 10.0f},
+    {"mesh_variants", FIELD_OPTION_INT, offsetof(FieldConfig, meshVariants), 1.0f, 1024.0f},
+    {"cell_size", FIELD_OPTION_CELL_SIZE, offsetof(FieldConfig, gridCellSize), 0.1f, 10000.0f},
+    {"auto_cell_size", FIELD_OPTION_BOOL, offsetof(FieldConfig, autoCellSize), 0.0f, 1.0f},
+    {"draw_distance", FIELD_OPTION_FLOAT, offsetof(FieldConfig, drawDistance), 1.0f, 100000.0f},
+    {"seed", FIELD_OPTION_SEED, offsetof(FieldConfig, seed), 0.0f, 0.0f},
+};
+static const int fieldOptionCount = (int)(sizeof(fieldOptions) / sizeof(fieldOptions[0]));
+
+// Command line spelling ("cell-size") to table spelling ("cell_size")
+static std::string NormalizeOptionName(const char *name)
+{
+    std::string normalized(name);
+    for (char &c : normalized)
+        if (c == '-')
+            c = '_';
+    return normalized;
+}
+
+static float ClampOption(const FieldOption &option, float value)
+{
+    if (value < option.minValue || value > option.maxValue)
+    {
+        float clamped = (value < option.minValue) ? option.minValue : option.maxValue;
+        TraceLog(LOG_WARNING, "CONFIG: %s = %g is out of range [%g, %g], using %g", option.name, value, option.minValue,
+                 option.maxValue, clamped);
+        return clamped;
+    }
+    return value;
+}
+
+//------------------------------------------------------------------------------------
+// Function Definitions
+//------------------------------------------------------------------------------------
+FieldConfig GetDefaultFieldConfig()
+{
+    using namespace AsteroidFieldConstants;
+
+    FieldConfig config;
+    config.asteroidCount = NUM_ASTEROIDS;
+    config.clusterCount = NUM_CLUSTERS;
+    config.clusterSpreadRadius = CLUSTER_SPREAD_RADIUS;
+    config.scatterRadius = ASTEROID_SCATTER_RADIUS;
+    config.largeAsteroidChance = LARGE_ASTEROID_CHANCE;
+    config.minRotationSpeed = MIN_ROTATION_SPEED;
+    config.maxRotationSpeed = MAX_ROTATION_SPEED;
+    config.initialHitPoints = INITIAL_HIT_POINTS;
+    config.meshIrregularity = MESH_IRREGULARITY;
+    config.shakeMagnitude = SHAKE_MAGNITUDE_BASE;
+    config.meshVariants = NUM_MESH_VARIANTS;
+    config.gridCellSize = {10.0f, 10.0f, 10.0f};
+    config.autoCellSize = false;
+    config.drawDistance = 250.0f;
+    config.seed = 0;
+    config.hasSeed = false;
+    return config;
+}
+
+bool SetFieldConfigOption(FieldConfig &config, const char *name, const char *value)
+{
+    std::string key = NormalizeOptionName(name);
+    for (int o = 0; o < fieldOptionCount; ++o)
+    {
+        const FieldOption &option = fieldOptions[o];
+        if (key != option.name)
+            continue;
+
+        char *end = nullptr;
+        unsigned char *field = (unsigned char *)&config + option.offset;
+        switch (option.type)
+        {
+        case FIELD_OPTION_INT:
+        {
+            long parsed = strtol(value, &end, 10);
+            if (end == value || *end != '\0')
+                break;
+            *(int *)field = (int)ClampOption(option, (float)parsed);
+            return true;
+        }
+        case FIELD_OPTION_FLOAT:
+        {
+            float parsed = strtof(value, &end);
+            if (end == value || *end != '\0')
+                break;
+            *(float *)field = ClampOption(option, parsed);
+            return true;
+        }
+        case FIELD_OPTION_BOOL:
+            if (strcmp(value, "1") == 0 || strcmp(value, "true") == 0 || strcmp(value, "on") == 0)
+                *(bool *)field = true;
+            else if (strcmp(value, "0") == 0 || strcmp(value, "false") == 0 || strcmp(value, "off") == 0)
+                *(bool *)field = false;
+            else
+                break;
+            return true;
+        case FIELD_OPTION_CELL_SIZE:
+        {
+            // One value for a cubic cell, or three comma separated ones
+            Vector3 size;
+            char extra;
+            if (sscanf(value, "%f,%f,%f%c", &size.x, &size.y, &size.z, &extra) == 3)
+            {
+                size.x = ClampOption(option, size.x);
+                size.y = ClampOption(option, size.y);
+                size.z = ClampOption(option, size.z);
+            }
+            else if (sscanf(value, "%f%c", &size.x, &extra) == 1)
+            {
+                size.x = ClampOption(option, size.x);
+                size.y = size.z = size.x;
+            }
+            else
+                break;
+            *(Vector3 *)field = size;
+            return true;
+        }
+        case FIELD_OPTION_SEED:
+        {
+            unsigned long long parsed = strtoull(value, &end, 10);
+            if (end == value || *end != '\0')
+                break;
+            config.seed = (uint64_t)parsed;
+            config.hasSeed = true;
+            return true;
+        }
+        }
+        TraceLog(LOG_WARNING, "CONFIG: Invalid value '%s' for %s", value, option.name);
+        return false;
+    }
+    TraceLog(LOG_WARNING, "CONFIG: Unknown option '%s'", name);
+    return false;
+}
+
+bool LoadFieldConfig(const char *path, FieldConfig &config)
+{
+    char *text = LoadFileText(path);
+    if (text == nullptr)
+    {
+        TraceLog(LOG_WARNING, "CONFIG: Could not read %s", path);
+        return false;
+    }
+
+    int lineNumber = 0;
+    for (char *line = text; line != nullptr && *line != '\0';)
+    {
+        char *next = strchr(line, '\n');
+        if (next != nullptr)
+            *next++ = '\0';
+        lineNumber++;
+
+        char *comment = strchr(line, '#');
+        if (comment != nullptr)
+            *comment = '\0';
+        std::string entry(line);
+        size_t first = entry.find_first_not_of(" \t\r");
+        if (first != std::string::npos)
+        {
+            size_t equals = entry.find('=');
+            size_t last = entry.find_last_not_of(" \t\r");
+            if (equals == std::string::npos || equals <= first || equals >= last)
+                TraceLog(LOG_WARNING, "CONFIG: %s:%d: expected 'name = value'", path, lineNumber);
+            else
+            {
+                std::string name = entry.substr(first, entry.find_last_not_of(" \t", equals - 1) - first + 1);
+                size_t valueStart = entry.find_first_not_of(" \t", equals + 1);
+                std::string value = entry.substr(valueStart, last - valueStart + 1);
+                SetFieldConfigOption(config, name.c_str(), value.c_str());
+            }
+        }
+        line = next;
+    }
+
+    UnloadFileText(text);
+    TraceLog(LOG_INFO, "CONFIG: Loaded %s", path);
+    return true;
+}
+
+bool ParseFieldConfigArgs(int argc, char **argv, FieldConfig &config)
+{
+    bool understood = true;
+
+    // Config files first, so the other arguments override them wherever they appear
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (strcmp(argv[i], "--config") == 0)
+            understood = LoadFieldConfig(argv[++i], config) && understood;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        if (strncmp(arg, "--", 2) != 0 || i + 1 >= argc)
+        {
+            TraceLog(LOG_WARNING, "CONFIG: Ignoring argument '%s' (expected --name value)", arg);
+            understood = false;
+            continue;
+        }
+        const char *value = argv[++i];
+        if (strcmp(arg, "--config") != 0)
+            understood = SetFieldConfigOption(config, arg + 2, value) && understood;
+    }
+
+    if (config.minRotationSpeed > config.maxRotationSpeed)
+        std::swap(config.minRotationSpeed, config.maxRotationSpeed);
+    return understood;
+}
+
+void LogFieldConfig(const FieldConfig &config)
+{
+    TraceLog(LOG_INFO, "CONFIG: %d asteroids in %d clusters (spread %.1f, scatter %.1f), %d mesh variants",
+             config.asteroidCount, config.clusterCount, config.clusterSpreadRadius, config.scatterRadius, config.meshVariants);
+    if (config.autoCellSize)
+        TraceLog(LOG_INFO, "CONFIG: Grid cell size auto-tuned, draw distance %.1f", config.drawDistance);
+    else
+        TraceLog(LOG_INFO, "CONFIG: Grid cell size (%.2f, %.2f, %.2f), draw distance %.1f", config.gridCellSize.x,
+                 config.gridCellSize.y, config.gridCellSize.z, config.drawDistance);
+}
+
+Vector3 ComputeAutoCellSize(const std::vector<Vector3> &positions, const std::vector<float> &radii, Vector3 fallback)
+{
+    size_t count = positions.size();
+    if (count == 0 || radii.size() != count)
+        return fallback;
+
+    // Lower bound: the typical large asteroid still spans at most two cells per axis
+    std::vector<float> sortedRadii(radii);
+    size_t p90 = (count * 9) / 10;
+    std::nth_element(sortedRadii.begin(), sortedRadii.begin() + p90, sortedRadii.end());
+    float minEdge = fmaxf(2.0f * sortedRadii[p90], 0.1f);
+
+    Vector3 boundsMin = positions[0];
+    Vector3 boundsMax = positions[0];
+    for (const Vector3 &p : positions)
+    {
+        boundsMin = Vector3Min(boundsMin, p);
+        boundsMax = Vector3Max(boundsMax, p);
+    }
+    Vector3 extent = Vector3Subtract(boundsMax, boundsMin);
+    float maxExtent = fmaxf(fmaxf(extent.x, extent.y), extent.z);
+
+    // Grow the edge until the occupied cells are full enough (or one cell covers everything)
+    std::vector<long long> keys(count);
+    float edge = minEdge;
+    float occupancy = 0.0f;
+    for (;;)
+    {
+        const long long mask = (1LL << 21) - 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            long long ix = (long long)floorf((positions[i].x - boundsMin.x) / edge);
+            long long iy = (long long)floorf((positions[i].y - boundsMin.y) / edge);
+            long long iz = (long long)floorf((positions[i].z - boundsMin.z) / edge);
+            keys[i] = (ix & mask) | ((iy & mask) << 21) | ((iz & mask) << 42);
+        }
+        std::sort(keys.begin(), keys.end());
+        size_t occupied = (size_t)(std::unique(keys.begin(), keys.end()) - keys.begin());
+        occupancy = (float)count / (float)occupied;
+        if (occupancy >= AUTO_CELL_TARGET_OCCUPANCY || edge >= maxExtent)
+            break;
+        edge *= AUTO_CELL_GROWTH;
+    }
+
+    TraceLog(LOG_INFO, "CONFIG: Auto cell size %.2f (p90 diameter %.2f, %.1f asteroids per occupied cell)", edge, minEdge,
+             occupancy);
+    return Vector3{edge, edge, edge};
+}
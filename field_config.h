@@ -0,0 +1,56 @@
+#ifndef FIELD_CONFIG_H
+#define FIELD_CONFIG_H
+
+#include "raylib.h"
+#include <vector>
+#include <cstdint>
+
+//------------------------------------------------------------------------------------
+// Field Configuration (runtime parameters, defaults from AsteroidFieldConstants)
+//------------------------------------------------------------------------------------
+// Everything a density / cell size sweep wants to change without a rebuild. Values come from
+// GetDefaultFieldConfig(), then a config file and the command line (later sources win):
+//   game --config sweep.cfg --asteroids 20000 --cell-size 6 --auto-cell-size 1
+// Config files hold one "name = value" per line ('#' starts a comment), with the option names
+// below; on the command line they are written "--name value" ('-' and '_' are interchangeable).
+// Structural constants (LOD resolutions, sector layout) stay compile-time.
+typedef struct FieldConfig
+{
+    int asteroidCount;         // asteroids
+    int clusterCount;          // clusters
+    float clusterSpreadRadius; // cluster_spread: cluster centers within +-spread on each axis
+    float scatterRadius;       // scatter_radius: asteroids within +-scatter of their cluster center
+    float largeAsteroidChance; // large_chance
+    float minRotationSpeed;    // min_rotation_speed (degrees per second)
+    float maxRotationSpeed;    // max_rotation_speed
+    int initialHitPoints;      // hit_points
+    float meshIrregularity;    // mesh_irregularity: displacement strength of the variant meshes
+    float shakeMagnitude;      // shake_magnitude: hit shake offset at scale 1
+    int meshVariants;          // mesh_variants
+    Vector3 gridCellSize;      // cell_size: cubic ("8") or per axis ("8,8,16")
+    bool autoCellSize;         // auto_cell_size: pick the cell size from the generated field instead
+    float drawDistance;        // draw_distance: far plane of the culling frustum
+    uint64_t seed;             // seed (only meaningful when hasSeed is set)
+    bool hasSeed;
+} FieldConfig;
+
+FieldConfig GetDefaultFieldConfig();
+// Apply one option by name (file or command line spelling); false if the name is unknown or the
+// value does not parse. Out of range values are clamped with a warning.
+bool SetFieldConfigOption(FieldConfig &config, const char *name, const char *value);
+// Read a config file into config; false if it cannot be read (bad lines are skipped with a warning)
+bool LoadFieldConfig(const char *path, FieldConfig &config);
+// Apply the command line: every --config file first, then the other options in order
+// (false if any argument was not understood, it is skipped with a warning)
+bool ParseFieldConfigArgs(int argc, char **argv, FieldConfig &config);
+void LogFieldConfig(const FieldConfig &config);
+
+// Auto-tuned cell edge for the given asteroids: the smallest edge, from the 90th percentile
+// asteroid diameter up, whose occupied cells hold AUTO_CELL_TARGET_OCCUPANCY asteroids on
+// average. Measuring occupied cells (instead of dividing the bounding volume) keeps clustered
+// fields from getting cells sized for the empty space between clusters.
+constexpr float AUTO_CELL_TARGET_OCCUPANCY = 4.0f; // Fewer: more cells walked per query, more: more sphere tests
+constexpr float AUTO_CELL_GROWTH = 1.25f;          // Ratio between the tried edges
+Vector3 ComputeAutoCellSize(const std::vector<Vector3> &positions, const std::vector<float> &radii, Vector3 fallback);
+
+#endif // FIELD_CONFIG_H
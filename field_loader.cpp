@@ -0,0 +1,277 @@
+#include "field_loader.h"
+
+//------------------------------------------------------------------------------------
+// AsteroidFieldLoader Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+AsteroidFieldLoader::AsteroidFieldLoader()
+    : stage(LOAD_STAGE_IDLE), meshesGenerated(0), meshesReady(false), workerDone(false),
+      variantTarget(0), meshesUploaded(0), fieldConfig(GetDefaultFieldConfig()), cellSize({10.0f, 10.0f, 10.0f}), fieldSeed(0), streamedField(false),
+      cacheEnabled(false), loadedFromCache(false), grid(nullptr)
+{
+    meshPool.lodCount = AsteroidFieldConstants::NUM_LOD_LEVELS;
+}
+
+// Destructor
+AsteroidFieldLoader::~AsteroidFieldLoader()
+{
+    if (worker.joinable())
+        worker.join(); // Generation is not interruptible, but it only produces CPU data
+    ReleaseResults();
+}
+
+void AsteroidFieldLoader::Start(const FieldConfig &config, uint64_t seed, bool streamed)
+{
+    if (IsLoading())
+        return;
+    if (worker.joinable())
+        worker.join();
+    ReleaseResults();
+
+    fieldConfig = config;
+    variantTarget = (config.meshVariants > 0) ? config.meshVariants : 1;
+    fieldConfig.meshVariants = variantTarget;
+    cellSize = config.gridCellSize;
+    fieldSeed = seed;
+    streamedField = streamed;
+    meshesGenerated = 0;
+    meshesReady = false;
+    workerDone = false;
+    meshesUploaded = 0;
+    loadedFromCache = false;
+    stage = LOAD_STAGE_MESHES;
+
+    TraceLog(LOG_INFO, "LOADER: Generating asteroid field in the background (seed %llu)...", (unsigned long long)seed);
+    worker = std::thread(&AsteroidFieldLoader::WorkerMain, this);
+}
+
+// Worker thread: everything that does not need the GL context
+void AsteroidFieldLoader::WorkerMain()
+{
+    // 0. A cached copy of this field skips generation entirely
+    if (cacheEnabled && LoadFromCache())
+    {
+        meshesGenerated = variantTarget;
+        meshesReady = true;
+        workerDone = true;
+        return;
+    }
+
+    // Separate streams, so changing the variant count does not reshuffle the field
+    Rng meshRng(fieldSeed, RNG_STREAM_MESHES);
+    Rng fieldRng(fieldSeed, RNG_STREAM_FIELD);
+
+    // Generation jobs get their own short-lived pool: the game's JobSystem belongs to the main thread
+    JobSystem jobs;
+
+    // 1. Mesh variants (CPU buffers only, the main thread reads meshes only after meshesReady)
+    GenerateAsteroidMeshVariants(meshPool, fieldConfig, meshRng, &jobs, &meshesGenerated);
+    meshesReady = true; // From here on the worker only reads meshPool.radii
+
+    // Streamed field: sectors are generated later, around the camera. Only occupied cells are
+    // stored, so the grid can span the whole explorable box.
+    if (streamedField)
+    {
+        stage = LOAD_STAGE_GRID;
+        grid = CreateStreamedGrid();
+        if (cacheEnabled)
+        {
+            FieldCacheKey key = MakeFieldCacheKey(fieldSeed, fieldConfig, true);
+            SaveFieldCache(GetFieldCachePath(key).c_str(), key, meshPool, asteroids, nullptr);
+        }
+        workerDone = true;
+        return;
+    }
+
+    // 2. Asteroid state
+    stage = LOAD_STAGE_FIELD;
+    asteroids = InitializeAsteroidField(meshPool, fieldRng, fieldConfig, &jobs);
+
+    // 3. Collision grid, bounds based on the generation parameters
+    stage = LOAD_STAGE_GRID;
+    if (fieldConfig.autoCellSize)
+        cellSize = ComputeAutoCellSize(asteroids.positions, asteroids.collisionRadii, fieldConfig.gridCellSize);
+    BoundingBox bounds = GetAsteroidFieldBounds(fieldConfig, cellSize.x); // Padding based on cell size
+    TraceLog(LOG_INFO, "LOADER: Calculated Grid Bounds: Min(%.2f) Max(%.2f)", bounds.min.x, bounds.max.x);
+
+    grid = new UniformGrid(bounds.min, bounds.max, cellSize);
+    if (!asteroids.Empty())
+        grid->BuildInstanced(asteroids);
+    else
+        TraceLog(LOG_WARNING, "LOADER: No asteroids generated, grid initialized empty.");
+
+    // Meshes may be uploading meanwhile, which only reads their CPU buffers
+    if (cacheEnabled)
+    {
+        FieldCacheKey key = MakeFieldCacheKey(fieldSeed, fieldConfig, false);
+        SaveFieldCache(GetFieldCachePath(key).c_str(), key, meshPool, asteroids, grid);
+    }
+
+    workerDone = true; // Last store by the worker, results are now readable by the main thread
+}
+
+// Empty hashed grid over the streamed world. Auto-tuning measures the sectors around the origin,
+// a sample of the same generator the streamer will run.
+UniformGrid *AsteroidFieldLoader::CreateStreamedGrid()
+{
+    if (fieldConfig.autoCellSize)
+    {
+        std::vector<Vector3> positions;
+        std::vector<float> radii;
+        AsteroidStore sector;
+        for (int sz = -1; sz <= 1; ++sz)
+            for (int sy = -1; sy <= 1; ++sy)
+                for (int sx = -1; sx <= 1; ++sx)
+                {
+                    GenerateSectorAsteroids(meshPool, fieldConfig, fieldSeed, sx, sy, sz, sector);
+                    positions.insert(positions.end(), sector.positions.begin(), sector.positions.end());
+                    radii.insert(radii.end(), sector.collisionRadii.begin(), sector.collisionRadii.end());
+                }
+        cellSize = ComputeAutoCellSize(positions, radii, fieldConfig.gridCellSize);
+    }
+    BoundingBox bounds = GetStreamedFieldBounds();
+    return new UniformGrid(bounds.min, bounds.max, cellSize, GRID_STORAGE_HASHED);
+}
+
+// Worker thread: take the whole field from its cache file if there is a valid one
+bool AsteroidFieldLoader::LoadFromCache()
+{
+    double loadStart = GetTime();
+    FieldCacheKey key = MakeFieldCacheKey(fieldSeed, fieldConfig, streamedField);
+    std::string path = GetFieldCachePath(key);
+    if (!LoadFieldCache(path.c_str(), key, cacheFile, meshPool, asteroids, grid))
+        return false;
+
+    if (streamedField)
+        grid = CreateStreamedGrid(); // Meshes only in the file, sampling sectors needs just their radii
+    else if (grid == nullptr)
+    {
+        ReleaseMappedMeshes(); // A fixed field without its grid is not usable
+        meshPool.meshes.clear();
+        meshPool.radii.clear();
+        asteroids.Clear();
+        return false;
+    }
+    loadedFromCache = true;
+    TraceLog(LOG_INFO, "LOADER: Field loaded from %s in %.2f ms", path.c_str(), (GetTime() - loadStart) * 1000.0);
+    return true;
+}
+
+// The mapping goes away once every mesh is on the GPU (or the field is dropped)
+void AsteroidFieldLoader::ReleaseMappedMeshes()
+{
+    if (!cacheFile.IsOpen())
+        return;
+    DetachMappedMeshes(meshPool);
+    cacheFile.Close();
+}
+
+bool AsteroidFieldLoader::Update(double uploadBudget)
+{
+    LoadStage currentStage = stage.load();
+    if (currentStage == LOAD_STAGE_IDLE)
+        return false;
+    if (currentStage == LOAD_STAGE_READY)
+        return true;
+
+    // Upload finished meshes while the worker carries on with the field and grid
+    if (meshesReady.load())
+    {
+        double uploadStart = GetTime();
+        while (meshesUploaded < meshPool.meshes.size())
+        {
+            UploadAsteroidMesh(meshPool.meshes[meshesUploaded]);
+            meshesUploaded++;
+            if (GetTime() - uploadStart >= uploadBudget)
+                break; // At least one mesh per frame, then yield back to rendering
+        }
+    }
+
+    if (workerDone.load())
+    {
+        if (worker.joinable())
+            worker.join(); // Only the first frame after the worker finished, uploads may take more
+        if (meshesUploaded < meshPool.meshes.size())
+        {
+            stage = LOAD_STAGE_UPLOAD;
+            return false;
+        }
+        ReleaseMappedMeshes();
+        stage = LOAD_STAGE_READY;
+        TraceLog(LOG_INFO, "LOADER: Asteroid field ready (%d variants, %d asteroids).",
+                 GetMeshPoolVariantCount(meshPool), (int)asteroids.Size());
+        return true;
+    }
+    return false;
+}
+
+void AsteroidFieldLoader::TakeResults(AsteroidMeshPool &outPool, AsteroidStore &outAsteroids, UniformGrid *&outGrid)
+{
+    if (stage.load() != LOAD_STAGE_READY)
+        return;
+
+    outPool = std::move(meshPool);
+    outAsteroids = std::move(asteroids);
+    outGrid = grid;
+
+    meshPool = AsteroidMeshPool();
+    meshPool.lodCount = AsteroidFieldConstants::NUM_LOD_LEVELS;
+    asteroids.Clear();
+    grid = nullptr;
+    stage = LOAD_STAGE_IDLE;
+}
+
+void AsteroidFieldLoader::ReleaseResults()
+{
+    ReleaseMappedMeshes();
+    if (!meshPool.meshes.empty())
+        UnloadAsteroidMeshPool(meshPool);
+    asteroids.Clear();
+    if (grid != nullptr)
+    {
+        delete grid;
+        grid = nullptr;
+    }
+    stage = LOAD_STAGE_IDLE;
+}
+
+float AsteroidFieldLoader::GetProgress() const
+{
+    LoadStage currentStage = stage.load();
+    if (currentStage == LOAD_STAGE_IDLE)
+        return 0.0f;
+    if (currentStage == LOAD_STAGE_READY)
+        return 1.0f;
+
+    float generated = (float)meshesGenerated.load() / (float)variantTarget;
+    float workerProgress = 0.6f * generated;
+    if (currentStage >= LOAD_STAGE_GRID)
+        workerProgress += 0.2f;
+    if (workerDone.load())
+        workerProgress = 1.0f;
+
+    size_t meshTotal = (size_t)variantTarget * AsteroidFieldConstants::NUM_LOD_LEVELS;
+    float uploaded = (meshTotal > 0) ? (float)meshesUploaded / (float)meshTotal : 1.0f;
+
+    return 0.75f * workerProgress + 0.25f * uploaded;
+}
+
+const char *AsteroidFieldLoader::GetStatusText() const
+{
+    switch (stage.load())
+    {
+    case LOAD_STAGE_MESHES:
+        return TextFormat("Generating asteroid meshes %d/%d", meshesGenerated.load(), variantTarget);
+    case LOAD_STAGE_FIELD:
+        return "Placing asteroids";
+    case LOAD_STAGE_GRID:
+        return "Building collision grid";
+    case LOAD_STAGE_UPLOAD:
+        return TextFormat(loadedFromCache.load() ? "Uploading cached meshes %d/%d" : "Uploading meshes %d/%d", (int)meshesUploaded, (int)meshPool.meshes.size());
+    case LOAD_STAGE_READY:
+        return "Ready";
+    default:
+        return "";
+    }
+}
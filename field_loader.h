@@ -0,0 +1,86 @@
+#ifndef FIELD_LOADER_H
+#define FIELD_LOADER_H
+
+#include "raylib.h"
+#include <thread>
+#include <atomic>
+
+#include "asteroid_field.h"
+#include "asteroid_store.h"
+#include "uniform_grid.h"
+#include "field_cache.h"
+
+//------------------------------------------------------------------------------------
+// Asynchronous Asteroid Field Loader
+//------------------------------------------------------------------------------------
+// A worker thread generates the CPU side of a new game (mesh variants, asteroid state,
+// collision grid) while the main thread keeps rendering. The main thread calls Update()
+// once per frame, which uploads finished meshes to the GPU within a time budget.
+// Meshes and asteroids are generated in parallel on a job pool owned by the worker.
+// With the field cache enabled the worker first tries the cache file for the seed; on a hit
+// generation is skipped and the meshes are uploaded straight from the mapped file.
+typedef enum
+{
+    LOAD_STAGE_IDLE = 0,
+    LOAD_STAGE_MESHES,   // Worker: displacing variant LOD meshes
+    LOAD_STAGE_FIELD,    // Worker: placing asteroids
+    LOAD_STAGE_GRID,     // Worker: building the collision grid
+    LOAD_STAGE_UPLOAD,   // Main thread: remaining GPU uploads
+    LOAD_STAGE_READY     // Everything done, waiting for TakeResults()
+} LoadStage;
+
+class AsteroidFieldLoader
+{
+public:
+    AsteroidFieldLoader();
+    ~AsteroidFieldLoader(); // Joins the worker and frees results never taken (main thread)
+
+    // Start generating a new field from seed and config in the background (ignored while a load is
+    // in flight). The same seed and config always produce the same meshes and asteroids. A streamed
+    // field only gets the meshes and an empty hashed grid over GetStreamedFieldBounds(): its sectors
+    // come from a SectorStreamer once the results are taken. With config.autoCellSize the grid cell
+    // size is tuned from the generated asteroids (a sample of sectors for a streamed field).
+    void Start(const FieldConfig &config, uint64_t seed, bool streamed = false);
+    // Load fields from / save them to the binary field cache (off by default; takes effect on the next Start)
+    void SetCacheEnabled(bool enabled) { cacheEnabled = enabled; }
+    bool IsLoadedFromCache() const { return loadedFromCache.load(); }
+    // Main thread, once per frame: upload meshes for up to uploadBudget seconds.
+    // Returns true once the field is complete and ready to be taken.
+    bool Update(double uploadBudget);
+    // Move the finished field to the caller (the loader returns to LOAD_STAGE_IDLE)
+    void TakeResults(AsteroidMeshPool &outPool, AsteroidStore &outAsteroids, UniformGrid *&outGrid);
+
+    bool IsLoading() const { return stage.load() != LOAD_STAGE_IDLE; }
+    LoadStage GetStage() const { return stage.load(); }
+    float GetProgress() const; // 0..1 over all stages
+    const char *GetStatusText() const;
+
+private:
+    std::thread worker;
+    std::atomic<LoadStage> stage;
+    std::atomic<int> meshesGenerated; // Variants finished by the worker
+    std::atomic<bool> meshesReady;    // Worker no longer touches meshPool.meshes
+    std::atomic<bool> workerDone;
+    int variantTarget;
+    size_t meshesUploaded;            // Main thread only
+    FieldConfig fieldConfig;
+    Vector3 cellSize;                 // Resolved (tuned) cell size of the grid being built
+    uint64_t fieldSeed;
+    bool streamedField;
+    bool cacheEnabled;
+    std::atomic<bool> loadedFromCache;
+    MappedFile cacheFile; // Backs the mesh CPU buffers after a cache hit, until they are uploaded
+
+    // Results (owned by the worker until workerDone / meshesReady)
+    AsteroidMeshPool meshPool;
+    AsteroidStore asteroids;
+    UniformGrid *grid;
+
+    void WorkerMain();
+    UniformGrid *CreateStreamedGrid();
+    bool LoadFromCache();
+    void ReleaseMappedMeshes();
+    void ReleaseResults();
+};
+
+#endif // FIELD_LOADER_H
@@ -0,0 +1,100 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <cmath>
+
+//------------------------------------------------------------------------------------
+// Fixed Timestep Clock
+//------------------------------------------------------------------------------------
+// Turns variable frame times into a whole number of constant simulation ticks. The time
+// left over after the last tick stays in the accumulator, and its fraction of a tick
+// (GetAlpha) is how far to blend from the previous to the current tick when rendering.
+// A frame never runs more than maxStepsPerFrame ticks: the excess time is dropped (the
+// simulation slows down instead of falling further behind every frame).
+//
+// In variable mode every frame is exactly one tick of the frame time, with alpha 1.
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(float tickRate = 60.0f, int maxStepsPerFrame = 5)
+        : fixedMode(true), stepTime(1.0f / 60.0f), accumulator(0.0f), alpha(1.0f),
+          maxSteps(maxStepsPerFrame > 0 ? maxStepsPerFrame : 1), droppedSteps(0)
+    {
+        SetTickRate(tickRate);
+    }
+
+    void SetTickRate(float tickRate)
+    {
+        tickHz = (tickRate > 1.0f) ? tickRate : 1.0f;
+        fixedStepTime = 1.0f / tickHz;
+        if (fixedMode)
+            stepTime = fixedStepTime;
+        accumulator = 0.0f;
+    }
+
+    void SetFixed(bool fixed)
+    {
+        fixedMode = fixed;
+        stepTime = fixedStepTime;
+        Reset();
+    }
+
+    // Forget accumulated time (after loading or unpausing, so no catch-up burst follows)
+    void Reset()
+    {
+        accumulator = 0.0f;
+        alpha = 1.0f;
+    }
+
+    // Number of ticks to simulate for a frame of frameTime seconds
+    int Advance(float frameTime)
+    {
+        frameTime = fminf(fmaxf(frameTime, 0.0f), MAX_FRAME_TIME);
+        if (!fixedMode)
+        {
+            stepTime = frameTime;
+            alpha = 1.0f;
+            return 1;
+        }
+
+        accumulator += frameTime;
+        int steps = (int)(accumulator / stepTime);
+        if (steps > maxSteps)
+        {
+            // Too far behind: run the allowed ticks, keep only the fraction of a tick
+            droppedSteps += steps - maxSteps;
+            accumulator = fmodf(accumulator, stepTime) + (float)maxSteps * stepTime;
+            steps = maxSteps;
+        }
+        accumulator -= (float)steps * stepTime;
+        if (accumulator < 0.0f)
+            accumulator = 0.0f; // Float rounding on the subtraction above
+        alpha = accumulator / stepTime;
+        return steps;
+    }
+
+    bool IsFixed() const { return fixedMode; }
+    float GetTickRate() const { return tickHz; }
+    float GetStepTime() const { return stepTime; } // Seconds simulated by each tick of this frame
+    float GetAlpha() const { return alpha; }       // Blend from the previous tick (0) to the last tick (1)
+    int GetMaxStepsPerFrame() const { return maxSteps; }
+    int GetDroppedSteps() const { return droppedSteps; } // Ticks skipped by the clamp since startup
+
+    // Seconds the rendered instant lags the last simulated tick (<= 0), for extrapolating
+    // constant-rate motion (e.g. rotations) back to the interpolated time
+    float GetRenderTimeOffset() const { return -(1.0f - alpha) * stepTime; }
+
+private:
+    static constexpr float MAX_FRAME_TIME = 0.25f; // Longer frames (breakpoints, window drags) are cut short
+
+    bool fixedMode;
+    float tickHz;
+    float fixedStepTime;
+    float stepTime;
+    float accumulator;
+    float alpha;
+    int maxSteps;
+    int droppedSteps;
+};
+
+#endif // FIXED_TIMESTEP_H
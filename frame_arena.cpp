@@ -0,0 +1,166 @@
+#include "frame_arena.h"
+#include <cstdlib> // For malloc, free
+#include <cstdint> // For uintptr_t
+
+#if defined(TRACK_HEAP_ALLOCATIONS)
+#include <atomic>
+#endif
+
+//------------------------------------------------------------------------------------
+// FrameArena Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+FrameArena::FrameArena(size_t initialCapacity)
+    : offset(0), stats{0}
+{
+    AddBlock(initialCapacity > 0 ? initialCapacity : FRAME_ARENA_DEFAULT_CAPACITY);
+}
+
+// Destructor
+FrameArena::~FrameArena()
+{
+    FreeBlocks();
+}
+
+void FrameArena::AddBlock(size_t minimumSize)
+{
+    Block block;
+    block.size = minimumSize;
+    block.data = (unsigned char *)malloc(block.size);
+    if (block.data == nullptr)
+        throw std::bad_alloc();
+    blocks.push_back(block);
+    offset = 0;
+    stats.capacity += block.size;
+    stats.heapBlocks++;
+}
+
+void FrameArena::FreeBlocks()
+{
+    for (const Block &block : blocks)
+        free(block.data);
+    blocks.clear();
+    stats.capacity = 0;
+}
+
+void *FrameArena::Allocate(size_t size, size_t alignment)
+{
+    Block &block = blocks.back();
+    uintptr_t base = (uintptr_t)block.data;
+    size_t aligned = (size_t)(((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+    if (aligned + size > block.size)
+    {
+        // Overflow: chain a block that fits the request, at least doubling the capacity
+        size_t blockSize = stats.capacity;
+        if (blockSize < size + alignment)
+            blockSize = size + alignment;
+        stats.used += block.size - offset; // The unused tail counts, the next frame's block must cover it
+        AddBlock(blockSize);
+        stats.overflowBlocks++;
+        return Allocate(size, alignment);
+    }
+
+    stats.used += aligned + size - offset;
+    offset = aligned + size;
+    if (stats.used > stats.highWater)
+        stats.highWater = stats.used;
+    return block.data + aligned;
+}
+
+void FrameArena::Reset()
+{
+    // Coalesce an overflowed frame into one block, sized for the high-water mark plus headroom
+    if (blocks.size() > 1)
+    {
+        size_t capacity = stats.highWater + stats.highWater / 2;
+        FreeBlocks();
+        AddBlock(capacity);
+    }
+    stats.lastFrame = stats.used;
+    stats.used = 0;
+    stats.overflowBlocks = 0;
+    offset = 0;
+}
+
+//------------------------------------------------------------------------------------
+// Heap allocation counter
+//------------------------------------------------------------------------------------
+#if defined(TRACK_HEAP_ALLOCATIONS)
+
+static std::atomic<long long> heapAllocationCount(0);
+
+// The array and nothrow forms of operator new end up in this one, the aligned forms (C++17) in
+// the overload below
+void *operator new(size_t size)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+#if defined(__cpp_aligned_new)
+// Over-aligned types bypass operator new(size_t) entirely, so they are counted here as well
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    size_t align = (size_t)alignment;
+    if (align < sizeof(void *))
+        align = sizeof(void *);
+#if defined(_WIN32)
+    void *p = _aligned_malloc(size > 0 ? size : 1, align);
+#else
+    void *p = nullptr;
+    if (posix_memalign(&p, align, size > 0 ? size : 1) != 0)
+        p = nullptr;
+#endif
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+static void FreeAligned(void *p)
+{
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    FreeAligned(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept
+{
+    FreeAligned(p);
+}
+#endif
+
+long long GetHeapAllocationCount()
+{
+    return heapAllocationCount.load(std::memory_order_relaxed);
+}
+
+#else
+
+long long GetHeapAllocationCount()
+{
+    return -1;
+}
+
+#endif
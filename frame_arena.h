@@ -0,0 +1,119 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <vector>
+#include <new>         // For std::bad_alloc
+#include <type_traits> // For std::true_type
+
+//------------------------------------------------------------------------------------
+// Frame Arena
+//------------------------------------------------------------------------------------
+// Linear allocator for data that only lives until the end of the frame: grid query results,
+// culling lists, draw buckets. Allocate() bumps a pointer, freeing is a no-op and Reset() at
+// the top of the main loop releases everything at once.
+//
+// The arena starts with one block. A frame that outgrows it chains extra heap blocks, and the
+// next Reset() replaces the lot with a single block that fits the high-water mark, so after
+// the first few frames of a scene the arena stops touching the heap altogether.
+//
+// Not thread-safe: allocate on the main thread (jobs may read and write the memory, as they
+// do with any caller-sized buffer). Nothing allocated from the arena may be used after Reset().
+constexpr size_t FRAME_ARENA_DEFAULT_CAPACITY = 1 << 20; // Bytes of the initial block
+constexpr size_t FRAME_ARENA_ALIGNMENT = 16;             // Default alignment (SIMD vectors, Matrix rows)
+
+typedef struct
+{
+    size_t used;        // Bytes handed out this frame (alignment padding included)
+    size_t capacity;    // Bytes in all blocks
+    size_t highWater;   // Most bytes used by any frame since construction
+    size_t lastFrame;   // Bytes used by the previous frame
+    int overflowBlocks; // Extra blocks chained this frame (0 in steady state)
+    int heapBlocks;     // Block allocations since construction
+} FrameArenaStats;
+
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t initialCapacity = FRAME_ARENA_DEFAULT_CAPACITY);
+    ~FrameArena();
+
+    // Aligned uninitialized memory, valid until the next Reset(). Throws std::bad_alloc like operator new.
+    void *Allocate(size_t size, size_t alignment = FRAME_ARENA_ALIGNMENT);
+    // Start a new frame: everything allocated so far is released
+    void Reset();
+
+    FrameArenaStats GetStats() const { return stats; }
+
+private:
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    typedef struct
+    {
+        unsigned char *data;
+        size_t size;
+    } Block;
+
+    void AddBlock(size_t minimumSize);
+    void FreeBlocks();
+
+    std::vector<Block> blocks; // Only the last one is allocated from
+    size_t offset;             // Next free byte in the last block
+    FrameArenaStats stats;
+};
+
+// STL allocator over a FrameArena. A null arena falls back to the general heap, so code that
+// takes frame containers still works without one (tools, long-lived buffers). deallocate() is
+// a no-op for arena memory: a growing vector leaves its old buffers behind until Reset().
+template <typename T>
+class FrameAllocator
+{
+public:
+    typedef T value_type;
+
+    FrameAllocator() noexcept : arena(nullptr) {}
+    explicit FrameAllocator(FrameArena *frameArena) noexcept : arena(frameArena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &other) noexcept : arena(other.GetArena()) {}
+
+    T *allocate(size_t n)
+    {
+        if (arena == nullptr)
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(arena->Allocate(n * sizeof(T), alignof(T) > FRAME_ARENA_ALIGNMENT ? alignof(T) : FRAME_ARENA_ALIGNMENT));
+    }
+    void deallocate(T *p, size_t) noexcept
+    {
+        if (arena == nullptr)
+            ::operator delete(p);
+    }
+
+    FrameArena *GetArena() const noexcept { return arena; }
+
+    // Assigning a container moves its arena along, so a member rebound to this frame's arena
+    // keeps allocating from it
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+private:
+    FrameArena *arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T> &a, const FrameAllocator<U> &b) noexcept { return a.GetArena() == b.GetArena(); }
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T> &a, const FrameAllocator<U> &b) noexcept { return a.GetArena() != b.GetArena(); }
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+// Empty vector that allocates from arena (nullptr: the heap)
+template <typename T>
+FrameVector<T> MakeFrameVector(FrameArena *arena) { return FrameVector<T>(FrameAllocator<T>(arena)); }
+
+// General-heap allocations (operator new) since startup, or -1 unless the build defines
+// TRACK_HEAP_ALLOCATIONS (which replaces the global operator new with a counting one)
+long long GetHeapAllocationCount();
+
+#endif // FRAME_ARENA_H
@@ -0,0 +1,124 @@
+#include "frustum.h"
+#include "raymath.h"
+#include <cmath>
+#include <cfloat> // Required for FLT_MAX
+
+//------------------------------------------------------------------------------------
+// Module Functions Definition
+//------------------------------------------------------------------------------------
+
+// Build a normalized plane from the (a, b, c, d) coefficients of a clip-space row combination
+static FrustumPlane MakePlane(float a, float b, float c, float d)
+{
+    FrustumPlane plane = {{a, b, c}, d};
+    float length = sqrtf(a * a + b * b + c * c);
+    if (length > 0.0f)
+    {
+        float invLength = 1.0f / length;
+        plane.normal = Vector3Scale(plane.normal, invLength);
+        plane.distance *= invLength;
+    }
+    return plane;
+}
+
+static inline float PlaneDistance(const FrustumPlane &plane, Vector3 point)
+{
+    return plane.normal.x * point.x + plane.normal.y * point.y + plane.normal.z * point.z + plane.distance;
+}
+
+Frustum ExtractFrustum(Matrix m)
+{
+    // raylib matrices are column-major: row i of the clip transform is (m[i], m[i+4], m[i+8], m[i+12])
+    Frustum frustum;
+    frustum.planes[FRUSTUM_PLANE_LEFT] = MakePlane(m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8, m.m15 + m.m12);
+    frustum.planes[FRUSTUM_PLANE_RIGHT] = MakePlane(m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8, m.m15 - m.m12);
+    frustum.planes[FRUSTUM_PLANE_BOTTOM] = MakePlane(m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9, m.m15 + m.m13);
+    frustum.planes[FRUSTUM_PLANE_TOP] = MakePlane(m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9, m.m15 - m.m13);
+    frustum.planes[FRUSTUM_PLANE_NEAR] = MakePlane(m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10, m.m15 + m.m14);
+    frustum.planes[FRUSTUM_PLANE_FAR] = MakePlane(m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10, m.m15 - m.m14);
+
+    // Corners: unproject the NDC cube
+    Matrix inverse = MatrixInvert(m);
+    frustum.bounds.min = (Vector3){FLT_MAX, FLT_MAX, FLT_MAX};
+    frustum.bounds.max = (Vector3){-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        float x = (corner & 1) ? 1.0f : -1.0f;
+        float y = (corner & 2) ? 1.0f : -1.0f;
+        float z = (corner & 4) ? 1.0f : -1.0f;
+        float w = inverse.m3 * x + inverse.m7 * y + inverse.m11 * z + inverse.m15;
+        Vector3 p = {
+            (inverse.m0 * x + inverse.m4 * y + inverse.m8 * z + inverse.m12) / w,
+            (inverse.m1 * x + inverse.m5 * y + inverse.m9 * z + inverse.m13) / w,
+            (inverse.m2 * x + inverse.m6 * y + inverse.m10 * z + inverse.m14) / w};
+        frustum.bounds.min = Vector3Min(frustum.bounds.min, p);
+        frustum.bounds.max = Vector3Max(frustum.bounds.max, p);
+    }
+    return frustum;
+}
+
+Frustum GetCameraFrustum(Camera3D camera, float aspect, float nearPlane, float farPlane)
+{
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearPlane, farPlane);
+    return ExtractFrustum(MatrixMultiply(view, projection));
+}
+
+bool FrustumContainsPoint(const Frustum &frustum, Vector3 point)
+{
+    for (int i = 0; i < FRUSTUM_PLANE_COUNT; ++i)
+    {
+        if (PlaneDistance(frustum.planes[i], point) < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+bool FrustumIntersectsSphere(const Frustum &frustum, Vector3 center, float radius)
+{
+    for (int i = 0; i < FRUSTUM_PLANE_COUNT; ++i)
+    {
+        if (PlaneDistance(frustum.planes[i], center) < -radius)
+            return false;
+    }
+    return true;
+}
+
+FrustumTestResult FrustumTestSphere(const Frustum &frustum, Vector3 center, float radius)
+{
+    FrustumTestResult result = FRUSTUM_INSIDE;
+    for (int i = 0; i < FRUSTUM_PLANE_COUNT; ++i)
+    {
+        float distance = PlaneDistance(frustum.planes[i], center);
+        if (distance < -radius)
+            return FRUSTUM_OUTSIDE;
+        if (distance < radius)
+            result = FRUSTUM_INTERSECTS;
+    }
+    return result;
+}
+
+FrustumTestResult FrustumTestBox(const Frustum &frustum, BoundingBox box)
+{
+    FrustumTestResult result = FRUSTUM_INSIDE;
+    for (int i = 0; i < FRUSTUM_PLANE_COUNT; ++i)
+    {
+        const FrustumPlane &plane = frustum.planes[i];
+
+        // Box corner furthest along the plane normal (p-vertex) and its opposite (n-vertex)
+        Vector3 positive = {
+            (plane.normal.x >= 0.0f) ? box.max.x : box.min.x,
+            (plane.normal.y >= 0.0f) ? box.max.y : box.min.y,
+            (plane.normal.z >= 0.0f) ? box.max.z : box.min.z};
+        Vector3 negative = {
+            (plane.normal.x >= 0.0f) ? box.min.x : box.max.x,
+            (plane.normal.y >= 0.0f) ? box.min.y : box.max.y,
+            (plane.normal.z >= 0.0f) ? box.min.z : box.max.z};
+
+        if (PlaneDistance(plane, positive) < 0.0f)
+            return FRUSTUM_OUTSIDE;
+        if (PlaneDistance(plane, negative) < 0.0f)
+            result = FRUSTUM_INTERSECTS;
+    }
+    return result;
+}
@@ -0,0 +1,55 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "raylib.h"
+
+//------------------------------------------------------------------------------------
+// View Frustum
+//------------------------------------------------------------------------------------
+// Six planes extracted from a view-projection matrix (Gribb/Hartmann). Plane normals
+// point inwards and are normalized, so dot(normal, p) + distance is the signed
+// distance of p to the plane (>= 0 means inside).
+typedef enum
+{
+    FRUSTUM_PLANE_LEFT = 0,
+    FRUSTUM_PLANE_RIGHT,
+    FRUSTUM_PLANE_BOTTOM,
+    FRUSTUM_PLANE_TOP,
+    FRUSTUM_PLANE_NEAR,
+    FRUSTUM_PLANE_FAR,
+    FRUSTUM_PLANE_COUNT
+} FrustumPlaneId;
+
+typedef struct
+{
+    Vector3 normal;
+    float distance;
+} FrustumPlane;
+
+typedef struct
+{
+    FrustumPlane planes[FRUSTUM_PLANE_COUNT];
+    BoundingBox bounds; // World-space box around the eight frustum corners
+} Frustum;
+
+// Result of a volume vs frustum test
+typedef enum
+{
+    FRUSTUM_OUTSIDE = 0, // Completely outside at least one plane
+    FRUSTUM_INTERSECTS,  // Straddles one or more planes
+    FRUSTUM_INSIDE       // Completely inside all planes
+} FrustumTestResult;
+
+// Frustum of a raylib view-projection matrix (MatrixMultiply(view, projection))
+Frustum ExtractFrustum(Matrix viewProjection);
+
+// Frustum of a perspective camera with explicit aspect ratio and clip distances.
+// Matches what BeginMode3D uses when aspect is the render width/height.
+Frustum GetCameraFrustum(Camera3D camera, float aspect, float nearPlane, float farPlane);
+
+bool FrustumContainsPoint(const Frustum &frustum, Vector3 point);
+bool FrustumIntersectsSphere(const Frustum &frustum, Vector3 center, float radius);
+FrustumTestResult FrustumTestSphere(const Frustum &frustum, Vector3 center, float radius);
+FrustumTestResult FrustumTestBox(const Frustum &frustum, BoundingBox box);
+
+#endif // FRUSTUM_H
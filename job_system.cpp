@@ -0,0 +1,150 @@
+#include "job_system.h"
+#include "raylib.h" // For TraceLog
+
+//------------------------------------------------------------------------------------
+// JobSystem Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+JobSystem::JobSystem(int workerCount)
+    : nextQueue(0), queuedJobs(0), pendingJobs(0), shuttingDown(false)
+{
+    if (workerCount < 0)
+    {
+        int hardwareThreads = (int)std::thread::hardware_concurrency();
+        workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+    }
+
+    // One queue per worker plus one for the owning (main) thread
+    queues.resize(workerCount + 1);
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        queues[i] = new JobQueue();
+        queues[i]->jobs.resize(JOB_QUEUE_CAPACITY);
+        queues[i]->head = 0;
+        queues[i]->count = 0;
+    }
+
+    workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+        workers.push_back(std::thread(&JobSystem::WorkerLoop, this, (size_t)(i + 1)));
+
+    TraceLog(LOG_INFO, "JobSystem: Started %d worker threads", workerCount);
+}
+
+// Destructor
+JobSystem::~JobSystem()
+{
+    Wait();
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        shuttingDown = true;
+    }
+    wakeCondition.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+
+    for (size_t i = 0; i < queues.size(); ++i)
+        delete queues[i];
+}
+
+void JobSystem::Submit(const Job &job)
+{
+    pendingJobs++;
+
+    JobQueue *queue = queues[nextQueue];
+    nextQueue = (nextQueue + 1) % queues.size();
+
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->count < JOB_QUEUE_CAPACITY)
+        {
+            queue->jobs[(queue->head + queue->count) % JOB_QUEUE_CAPACITY] = job;
+            queue->count++;
+            queued = true;
+        }
+    }
+
+    if (queued)
+        queuedJobs++;
+    else
+        Execute(job); // Queue full, run it on the submitting thread
+}
+
+void JobSystem::WakeWorkers()
+{
+    // Taking the lock orders the queuedJobs update before any sleeping worker re-checks it
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCondition.notify_all();
+}
+
+bool JobSystem::PopJob(size_t queueIndex, Job &outJob)
+{
+    JobQueue *queue = queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->count == 0)
+        return false;
+
+    queue->count--;
+    outJob = queue->jobs[(queue->head + queue->count) % JOB_QUEUE_CAPACITY];
+    queuedJobs--;
+    return true;
+}
+
+bool JobSystem::StealJob(size_t queueIndex, Job &outJob)
+{
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        JobQueue *queue = queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->count == 0)
+            continue;
+
+        outJob = queue->jobs[queue->head];
+        queue->head = (queue->head + 1) % JOB_QUEUE_CAPACITY;
+        queue->count--;
+        queuedJobs--;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(const Job &job)
+{
+    job.invoke(job);
+    pendingJobs--;
+}
+
+void JobSystem::Wait()
+{
+    Job job;
+    while (pendingJobs.load() > 0)
+    {
+        if (PopJob(0, job) || StealJob(0, job))
+            Execute(job);
+        else
+            std::this_thread::yield(); // Remaining jobs are already running on workers
+    }
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex)
+{
+    Job job;
+    while (true)
+    {
+        if (PopJob(queueIndex, job) || StealJob(queueIndex, job))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]
+                           { return shuttingDown || queuedJobs.load() > 0; });
+        if (shuttingDown && queuedJobs.load() == 0)
+            return;
+    }
+}
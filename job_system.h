@@ -0,0 +1,115 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstring>     // For memcpy
+#include <type_traits> // For std::is_trivially_copyable
+
+//------------------------------------------------------------------------------------
+// Job System
+//------------------------------------------------------------------------------------
+// Small work-stealing thread pool for data-parallel loops. Every thread (workers plus
+// the main thread) owns a fixed-size job ring: the owner pops from the back, idle
+// threads steal from the front. ParallelFor only queues work; Wait() is the join point
+// and the calling thread executes queued jobs itself while it waits.
+//
+// Job functors are copied into the job, so a lambda may go out of scope before Wait().
+// They must be small and trivially copyable: capture pointers and values, not containers.
+constexpr size_t JOB_STORAGE_SIZE = 64;      // Max functor size in bytes
+constexpr size_t JOB_QUEUE_CAPACITY = 1024;  // Jobs per thread queue (overflow runs inline)
+
+class JobSystem
+{
+public:
+    // workerCount < 0 picks hardware_concurrency - 1 (the main thread is the extra worker)
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem(); // Finishes queued work and joins the workers
+
+    int GetWorkerCount() const { return (int)workers.size(); }
+    int GetThreadCount() const { return (int)workers.size() + 1; }
+
+    // Split [0, count) into chunks of chunkSize and queue fn(begin, end) for each chunk
+    template <typename Fn>
+    void ParallelFor(size_t count, size_t chunkSize, const Fn &fn);
+
+    // Block until every queued job has finished, helping to execute them meanwhile
+    void Wait();
+
+private:
+    typedef struct Job
+    {
+        void (*invoke)(const struct Job &job);
+        size_t begin;
+        size_t end;
+        alignas(16) unsigned char storage[JOB_STORAGE_SIZE]; // Copy of the functor
+    } Job;
+
+    // Fixed-capacity ring of jobs, guarded by its own mutex
+    typedef struct JobQueue
+    {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        size_t head; // Steal end (oldest job)
+        size_t count;
+    } JobQueue;
+
+    std::vector<std::thread> workers;
+    std::vector<JobQueue *> queues; // queues[0] belongs to the thread that owns the JobSystem
+    size_t nextQueue;               // Round-robin submission target
+
+    std::atomic<int> queuedJobs;  // Jobs sitting in queues
+    std::atomic<int> pendingJobs; // Jobs queued or running
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool shuttingDown;
+
+    template <typename Fn>
+    static void InvokeJob(const Job &job)
+    {
+        const Fn *fn = reinterpret_cast<const Fn *>(job.storage);
+        (*fn)(job.begin, job.end);
+    }
+
+    void Submit(const Job &job);
+    void WakeWorkers();
+    bool PopJob(size_t queueIndex, Job &outJob);   // Back of own queue
+    bool StealJob(size_t queueIndex, Job &outJob); // Front of any other queue
+    void Execute(const Job &job);
+    void WorkerLoop(size_t queueIndex);
+};
+
+template <typename Fn>
+void JobSystem::ParallelFor(size_t count, size_t chunkSize, const Fn &fn)
+{
+    static_assert(sizeof(Fn) <= JOB_STORAGE_SIZE, "Job functor too large: capture pointers instead of values");
+    static_assert(std::is_trivially_copyable<Fn>::value, "Job functor must be trivially copyable");
+
+    if (count == 0)
+        return;
+    if (chunkSize == 0)
+        chunkSize = 1;
+
+    // Nothing to distribute to, run the whole range right here
+    if (workers.empty() || count <= chunkSize)
+    {
+        fn(0, count);
+        return;
+    }
+
+    for (size_t begin = 0; begin < count; begin += chunkSize)
+    {
+        Job job;
+        job.invoke = &InvokeJob<Fn>;
+        job.begin = begin;
+        job.end = (begin + chunkSize < count) ? begin + chunkSize : count;
+        memcpy(job.storage, &fn, sizeof(Fn));
+        Submit(job);
+    }
+    WakeWorkers();
+}
+
+#endif // JOB_SYSTEM_H
@@ -11,7 +11,13 @@
  * - Basic UI (Main Menu, Pause Menu with mouse interaction).
  * - Score system and particle effects for destruction.
  * - Uniform Grid for collision detection optimization.
- * - Simple frustum culling for rendering optimization.
+ * - Six-plane frustum culling, optionally accelerated by culling whole grid cells.
+ * - Instanced rendering from a shared pool of asteroid mesh variants.
+ * - Per-asteroid level of detail (3 mesh LODs + billboard impostors) with hysteresis.
+ * - Work-stealing job system for the per-frame asteroid update and culling loops.
+ * - Non-blocking loading screen: the field is generated on a worker thread.
+ * - Endless mode: sectors around the camera are streamed in and out in the background.
+ * - Frame profiler with an on-screen overlay and Chrome trace export.
  *
  ********************************************************************************************/
 
@@ -23,7 +29,6 @@
 #include <ctime>
 #include <cmath>
 #include <limits>
-#include <cfloat> // Required for FLT_MAX
 #include <string> // Required for std::string, TextFormat
 
 #include "custom_camera.h"
@@ -32,6 +37,18 @@
 #include "background.h"
 #include "particle_system.h"
 #include "uniform_grid.h" // Include the grid header
+#include "bvh_index.h"    // Alternative spatial index (F6)
+#include "asteroid_renderer.h"
+#include "asteroid_systems.h"
+#include "asteroid_effects.h"
+#include "job_system.h"
+#include "field_loader.h"
+#include "profiler.h"
+#include "fixed_timestep.h"
+#include "sector_streamer.h"
+#include "frame_arena.h"
+#include "occlusion_culler.h"
+#include "resource_tracker.h"
 
 // Game Screen Enum
 typedef enum GameScreen
@@ -43,7 +60,7 @@ typedef enum GameScreen
 } GameScreen;
 
 // Program main entry point
-int main(void)
+int main(int argc, char **argv)
 {
     // Initialization
     //--------------------------------------------------------------------------------------
@@ -54,13 +71,27 @@ int main(void)
     SetTraceLogLevel(LOG_INFO); // Show INFO log messages
     InitWindow(screenWidth, screenHeight, "Asteroid Field Demo - A. Belli");
 
-    srand(time(NULL)); // Seed random number generator
+    // Field parameters: defaults, then --config files, then the other command line options
+    FieldConfig fieldConfig = GetDefaultFieldConfig();
+    if (!ParseFieldConfigArgs(argc, argv, fieldConfig))
+        TraceLog(LOG_WARNING, "Some command line arguments were ignored (usage: game [--config file] [--seed N] [--<option> value]...)");
+    LogFieldConfig(fieldConfig);
+
+    // Random streams: one per subsystem, all derived from a per-run seed. "--seed N" fixes it: every
+    // new game then replays that field, and only then are fields cached on disk (fresh time seeds
+    // never repeat, their cache files would just pile up).
+    const bool fixedSeed = fieldConfig.hasSeed;
+    const uint64_t runSeed = fixedSeed ? fieldConfig.seed : (uint64_t)time(NULL);
+    uint64_t fieldsGenerated = 0;                   // Each new game generates from runSeed + this count (unless fixed)
+    Rng particleRng(runSeed, RNG_STREAM_PARTICLES); // Destruction bursts
+    Rng effectsRng(runSeed, RNG_STREAM_EFFECTS);    // Hit shake offsets
+    Rng starRng(runSeed, RNG_STREAM_STARS);
 
     // --- Initialize Game Components ---
     CustomCamera customCamera(
         (Vector3){0.0f, 2.0f, 5.0f}, (Vector3){0.0f, 1.8f, 0.0f},   // Initial position and target
         (Vector3){0.0f, 1.0f, 0.0f}, 60.0f, CAMERA_PERSPECTIVE,     // Up vector, FOV (60 degrees), Projection
-        (Vector3){0.15f, 0.15f, 0.15f}, (Vector2){0.003f, 0.003f}); // Movement speed, Mouse sensitivity
+        (Vector3){9.0f, 9.0f, 9.0f}, (Vector2){0.003f, 0.003f});    // Movement speed (units/s), Mouse sensitivity
     Vector3 initialCameraPos = customCamera.GetCamera().position;
 
     // Background colors
@@ -69,31 +100,55 @@ int main(void)
 
     // Initialize background stars
     const int numStars = 700;
-    std::vector<Star> stars = InitializeStars(screenWidth, screenHeight, numStars);
+    std::vector<Star> stars = InitializeStars(screenWidth, screenHeight, numStars, starRng);
+    // Gradient + stars baked to render textures on first draw (F8 cycles immediate / baked / parallax)
+    StarBackground *background = new StarBackground(std::move(stars), screenWidth, screenHeight, spaceBlueDark, spaceBlueLight);
 
-    // Load default material for asteroids
-    Material defaultMaterial = LoadMaterialDefault();
+    // Asteroid renderer (owns the instancing shader and materials)
+    AsteroidRenderer *asteroidRenderer = new AsteroidRenderer();
+    AsteroidMeshPool meshPool; // Shared mesh variants (generated in LOADING)
 
     // --- Grid Initialization ---
     UniformGrid *collisionGrid = nullptr;         // Pointer for the collision grid (initialized in LOADING)
-    Vector3 gridCellSize = {10.0f, 10.0f, 10.0f}; // Size of each cell in the uniform grid
+    BvhIndex asteroidBvh;                         // Same asteroids in a BVH (built in LOADING, F6 switches)
+
+    // Background field generation for the LOADING screen
+    AsteroidFieldLoader *fieldLoader = new AsteroidFieldLoader();
+    fieldLoader->SetCacheEnabled(fixedSeed);
+    const double MESH_UPLOAD_BUDGET = 0.004;  // Seconds of GPU mesh uploads per loading frame
+    bool streamedField = false;               // Endless field: sectors streamed around the camera
+    uint64_t fieldSeed = 0;                   // Seed of the field being played (streamed sectors hash it)
+    SectorStreamer *sectorStreamer = nullptr; // Only in an endless game, created once the meshes are loaded
+
+    // Worker threads for the per-frame asteroid loops
+    JobSystem *jobSystem = new JobSystem();
+
+    // Per-frame scratch memory (grid queries, culling lists, draw buckets), reset at the top of the loop
+    FrameArena frameArena;
+    // Software depth buffer of the largest nearby asteroids, hides the ones behind them
+    OcclusionCuller occlusionCuller;
+    long long heapAllocationMark = GetHeapAllocationCount(); // -1 unless built with TRACK_HEAP_ALLOCATIONS
+    long long frameHeapAllocations = -1; // -1 while the count is not tracked
 
     // Initialize other systems
     InitializeScore();
     InitializeParticles();
+    InitializeProfiler();
+    InitializeResourceTracker();
     // --- End Initialize Game Components ---
 
     // --- Game State Variables ---
     GameScreen currentScreen = MAIN_MENU; // Start at the main menu
     int mainMenuSelection = 0;            // Currently selected main menu option index
-    const int mainMenuOptions = 2;        // Number of main menu options
+    const int mainMenuOptions = 3;        // Number of main menu options
     const int pauseMenuOptions = 3;       // Number of pause menu options
     bool shouldExit = false;              // Flag to control game loop exit
     // --- End Game State Variables ---
 
     // --- Gameplay State Variables ---
-    std::vector<Asteroid> asteroids; // Vector to hold all asteroid data
-    bool gameInitialized = false;    // Flag: true when asteroids and grid are loaded
+    AsteroidStore asteroids;      // Structure-of-arrays asteroid data
+    AsteroidEffects asteroidEffects; // Asteroids with a running hit or contact effect
+    bool gameInitialized = false; // Flag: true when asteroids and grid are loaded
 
     // Player collision bounce state
     bool isBouncing = false;
@@ -101,6 +156,7 @@ int main(void)
     Vector3 bounceDirection = {0.0f, 0.0f, 0.0f};
     const float BOUNCE_DURATION = 0.4f;       // How long the bounce effect lasts
     const float INITIAL_BOUNCE_SPEED = 10.0f; // Initial speed of the bounce-back
+    const float PLAYER_RADIUS = 0.5f;         // Collision sphere of the player
 
     // Asteroid hit visual effect state
     const float SHAKE_DURATION = 0.25f;   // How long the asteroid shakes after being hit
@@ -108,7 +164,24 @@ int main(void)
 
     // Debugging flag
     bool showDebug = false; // Toggle with F1 to show collision spheres etc.
+    bool useInstancing = true; // Toggle with F2 to compare against one DrawMesh per asteroid
+    bool useGpuAnimation = true; // Toggle with F9: rotations in the vertex shader instead of CPU matrices
+    bool gpuAnimationActive = false; // GPU animation in use (also needs instancing and the shader)
+    double animationClock = 0.0; // Seconds of asteroid rotation simulated, the GPU animation time
+    CullMode cullMode = CULL_MODE_GRID; // Toggle with F4 between grid-accelerated and brute-force culling
+    bool useBvh = false; // Toggle with F6: queries and culling through the BVH instead of the grid
+    bool useOcclusionCulling = true; // Toggle with F10 to draw asteroids hidden behind others too
+    const float MAX_DRAW_DISTANCE = fieldConfig.drawDistance; // Far plane of the culling frustum
     int drawnAsteroids = 0; // Counter for how many asteroids are drawn after culling
+    bool showProfiler = false; // Toggle with F3, F5 writes a Chrome trace of the recent frames
+
+    // Simulation clock: gameplay updates run in fixed ticks (toggle with F7 to the frame time),
+    // rendering blends the camera between the last two ticks
+    const float SIMULATION_TICK_RATE = 60.0f; // Ticks per second, independent of the display rate
+    const int MAX_TICKS_PER_FRAME = 5;         // Slower frames drop time instead of piling up ticks
+    FixedTimestep simClock(SIMULATION_TICK_RATE, MAX_TICKS_PER_FRAME);
+    Vector3 previousTickCameraPos = customCamera.GetCamera().position;
+    bool clickQueued = false; // Left click waiting for the next tick
     // --- End Gameplay State ---
 
     SetTargetFPS(60); // Set desired frame rate
@@ -119,6 +192,13 @@ int main(void)
     // Main game loop - called every frame
     while (!WindowShouldClose() && !shouldExit)
     {
+        ProfilerBeginFrame();
+        frameArena.Reset(); // Nothing from the previous frame is used past this point
+        long long heapAllocations = GetHeapAllocationCount();
+        frameHeapAllocations = (heapAllocations >= 0 && heapAllocationMark >= 0) ? heapAllocations - heapAllocationMark : -1;
+        heapAllocationMark = heapAllocations;
+        AsteroidCullResult cullResult = CreateAsteroidCullResult(&frameArena); // Per-asteroid visibility + transforms
+
         // Update
         //----------------------------------------------------------------------------------
         float deltaTime = GetFrameTime();      // Time since last frame
@@ -139,8 +219,9 @@ int main(void)
             // Handle Main Menu Selection
             if (IsKeyPressed(KEY_ENTER))
             {
-                if (mainMenuSelection == 0) // New Game selected
+                if (mainMenuSelection == 0 || mainMenuSelection == 1) // New Game or Endless Field selected
                 {
+                    streamedField = (mainMenuSelection == 1);
                     InitializeScore();                          // Reset score
                     customCamera.SetPosition(initialCameraPos); // Reset camera position
                     InitializeParticles();                      // Reset particles
@@ -148,7 +229,7 @@ int main(void)
                     gameInitialized = false;                    // Mark game as not initialized yet
                     TraceLog(LOG_INFO, "MENU: Switched to LOADING state");
                 }
-                else if (mainMenuSelection == 1)
+                else if (mainMenuSelection == 2)
                     shouldExit = true; // Quit selected
             }
         }
@@ -156,8 +237,66 @@ int main(void)
 
         case LOADING:
         {
-            // Actual loading happens synchronously after drawing the "Loading..." text
-            // See the block after EndDrawing()
+            bool fieldReady = false;
+            if (sectorStreamer != nullptr)
+            {
+                // Endless field: meshes are in, wait for the sectors around the start position
+                sectorStreamer->Update(customCamera.GetCamera().position, MESH_UPLOAD_BUDGET);
+                fieldReady = sectorStreamer->IsSettled();
+            }
+            else
+            {
+                // First LOADING frame: drop the previous game and start generating in the background
+                if (!fieldLoader->IsLoading())
+                {
+                    if (collisionGrid != nullptr)
+                    {
+                        delete collisionGrid;
+                        collisionGrid = nullptr;
+                        TraceLog(LOG_INFO, "Deleted previous collision grid.");
+                    }
+                    if (!meshPool.meshes.empty())
+                    {
+                        TraceLog(LOG_INFO, "Unloading previous asteroid mesh pool...");
+                        UnloadAsteroidMeshPool(meshPool);
+                    }
+                    asteroids.Clear();
+                    fieldSeed = fixedSeed ? runSeed : runSeed + fieldsGenerated++;
+                    fieldLoader->Start(fieldConfig, fieldSeed, streamedField);
+                }
+
+                // Upload finished meshes within this frame's budget, switch once everything is in place
+                if (fieldLoader->Update(MESH_UPLOAD_BUDGET))
+                {
+                    fieldLoader->TakeResults(meshPool, asteroids, collisionGrid);
+                    asteroidBvh.BuildInstanced(asteroids); // Empty for an endless field, the streamer fills it
+                    if (streamedField)
+                    {
+                        sectorStreamer = new SectorStreamer(fieldSeed, fieldConfig, meshPool, asteroids, *collisionGrid);
+                        sectorStreamer->AttachIndex(asteroidBvh);
+                    }
+                    else
+                        fieldReady = true;
+                }
+            }
+
+            if (fieldReady)
+            {
+                gameInitialized = true; // Mark as initialized
+                simClock.Reset();       // Loading time is not simulated
+                asteroidEffects.Reset(asteroids.Size());
+                occlusionCuller.SetMeshPool(meshPool, fieldConfig.meshIrregularity);
+                animationClock = 0.0;
+                asteroidRenderer->UploadInstances(asteroids, animationClock); // Static instance data, once per field
+                gpuAnimationActive = useGpuAnimation && useInstancing && asteroidRenderer->IsGpuAnimationAvailable();
+                previousTickCameraPos = customCamera.GetCamera().position;
+                clickQueued = false;
+                TraceLog(LOG_INFO, "Asteroid loading complete.");
+
+                // Switch to Gameplay state
+                currentScreen = GAMEPLAY;
+                DisableCursor(); // Hide cursor for gameplay
+            }
         }
         break;
 
@@ -193,8 +332,10 @@ int main(void)
                     DisableCursor();
                     TraceLog(LOG_INFO, "PAUSE: Resumed via Click");
                 }
-                else if (CheckCollisionPointRec(mousePos, newGameRec)) // New Game clicked
+                else if (CheckCollisionPointRec(mousePos, newGameRec)) // New Game clicked (same field mode)
                 {
+                    delete sectorStreamer; // Joins its worker before the store and grid are released
+                    sectorStreamer = nullptr;
                     InitializeScore();
                     customCamera.SetPosition(initialCameraPos);
                     InitializeParticles();
@@ -215,7 +356,10 @@ int main(void)
             if (!gameInitialized)
                 break; // Don't run if assets aren't loaded
 
-            customCamera.UpdateLook(deltaTime); // Update camera orientation based on mouse movement
+            {
+                PROFILE_SCOPE(PROFILE_ZONE_CAMERA_UPDATE);
+                customCamera.UpdateLook(deltaTime); // Update camera orientation based on mouse movement
+            }
 
             // Check for pausing input
             if (IsKeyPressed(KEY_P))
@@ -229,190 +373,193 @@ int main(void)
                 DisableCursor(); // Hide cursor during gameplay
                 if (IsKeyPressed(KEY_F1))
                     showDebug = !showDebug; // Toggle debug view
-
-                // Update Asteroid Shake Timers
-                for (size_t i = 0; i < asteroids.size(); ++i)
+                if (IsKeyPressed(KEY_F2))
+                    useInstancing = !useInstancing; // Toggle instanced rendering
+                if (IsKeyPressed(KEY_F4))
+                    cullMode = (cullMode == CULL_MODE_GRID) ? CULL_MODE_BRUTE_FORCE : CULL_MODE_GRID;
+                if (IsKeyPressed(KEY_F3))
+                    showProfiler = !showProfiler; // Toggle profiler overlay
+                if (IsKeyPressed(KEY_F5))
+                    SaveProfilerTrace("profile_trace.json"); // Open in chrome://tracing or Perfetto
+                if (IsKeyPressed(KEY_F6))
+                    useBvh = !useBvh; // Toggle spatial index backend
+                if (IsKeyPressed(KEY_F7))
+                    simClock.SetFixed(!simClock.IsFixed()); // Toggle fixed / variable timestep
+                if (IsKeyPressed(KEY_F8))
+                    background->SetMode((BackgroundMode)((background->GetMode() + 1) % BACKGROUND_MODE_COUNT));
+                if (IsKeyPressed(KEY_F9))
+                    useGpuAnimation = !useGpuAnimation; // Toggle GPU rotation animation
+                if (IsKeyPressed(KEY_F10))
+                    useOcclusionCulling = !useOcclusionCulling; // Toggle software occlusion culling
+
+                // Switching rotation paths hands the angles over, so asteroids keep their orientation
+                bool animateOnGpu = useGpuAnimation && useInstancing && asteroidRenderer->IsGpuAnimationAvailable();
+                if (animateOnGpu != gpuAnimationActive)
                 {
-                    if (asteroids[i].isShaking)
-                    {
-                        asteroids[i].shakeTimer -= deltaTime;
-                        if (asteroids[i].shakeTimer <= 0.0f)
-                        {
-                            asteroids[i].isShaking = false;
-                            // Consider resetting color here if not bouncing
-                            // asteroids[i].currentColor = asteroids[i].color;
-                        }
-                    }
+                    if (animateOnGpu)
+                        asteroidRenderer->UploadInstances(asteroids, animationClock);
+                    else
+                        asteroidRenderer->ReadBackRotations(asteroids, animationClock);
+                    gpuAnimationActive = animateOnGpu;
                 }
+                if (collisionGrid != nullptr)
+                    collisionGrid->ResetQueryStats(); // Per-frame query counters
+                asteroidBvh.ResetQueryStats();
+
+                // Clicks are latched per frame and handled by the first tick that runs
+                if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+                    clickQueued = true;
+
+                // Simulation ticks: none, one or several per frame in fixed mode, one of the frame time otherwise
+                int simSteps = simClock.Advance(deltaTime);
+                float stepTime = simClock.GetStepTime();
+                for (int step = 0; step < simSteps; ++step)
+                {
+                    previousTickCameraPos = customCamera.GetCamera().position; // Start of this tick, for interpolation
 
-                // Update active particles
-                UpdateParticles(deltaTime);
+                    // Update Asteroid Shake Timers (only the asteroids with a running effect)
+                    asteroidEffects.UpdateShakeTimers(asteroids, stepTime);
 
-                // Handle Player Bounce State OR Normal Movement/Interaction
-                if (isBouncing)
-                {
-                    // Update bounce timer and position
-                    bounceTimer -= deltaTime;
-                    if (bounceTimer <= 0.0f)
+                    // Update active particles
                     {
-                        isBouncing = false;
+                        PROFILE_SCOPE(PROFILE_ZONE_PARTICLE_UPDATE);
+                        UpdateParticles(stepTime);
                     }
-                    else
+
+                    // Handle Player Bounce State OR Normal Movement/Interaction
+                    if (isBouncing)
                     {
-                        // Apply decaying bounce movement
-                        float decayFactor = bounceTimer / BOUNCE_DURATION;
-                        float currentSpeed = INITIAL_BOUNCE_SPEED * decayFactor;
-                        Vector3 bounceMovement = Vector3Scale(bounceDirection, currentSpeed * deltaTime);
-                        customCamera.ApplyBounce(bounceMovement);
+                        // Update bounce timer and position
+                        bounceTimer -= stepTime;
+                        if (bounceTimer <= 0.0f)
+                        {
+                            isBouncing = false;
+                        }
+                        else
+                        {
+                            // Apply decaying bounce movement
+                            float decayFactor = bounceTimer / BOUNCE_DURATION;
+                            float currentSpeed = INITIAL_BOUNCE_SPEED * decayFactor;
+                            Vector3 bounceMovement = Vector3Scale(bounceDirection, currentSpeed * stepTime);
+                            customCamera.ApplyBounce(bounceMovement);
+                        }
                     }
-                }
-                else // Not currently bouncing
-                {
-                    Vector3 previousPlayerPos = customCamera.GetCamera().position;
-                    customCamera.UpdatePosition(deltaTime); // Update player position based on WASD/Ctrl/Space
-                    Vector3 currentPlayerPos = customCamera.GetCamera().position;
+                    else // Not currently bouncing
+                    {
+                        Vector3 previousPlayerPos = customCamera.GetCamera().position;
+                        {
+                            PROFILE_SCOPE(PROFILE_ZONE_CAMERA_UPDATE);
+                            customCamera.UpdatePosition(stepTime); // Update player position based on WASD/Ctrl/Space
+                        }
+                        Vector3 currentPlayerPos = customCamera.GetCamera().position;
 
-                    // Flag to track if a collision occurred this frame (used for Click Miss logic)
-                    bool physicalCollisionOccurred = false;
+                        // Flag to track if a collision occurred this tick (used for Click Miss logic)
+                        bool physicalCollisionOccurred = false;
 
-                    // Physical Collision Check between Player and Asteroids (Uses Grid)
-                    if (collisionGrid != nullptr)
-                    {
-                        // Query the grid for asteroid indices near the player
-                        std::vector<int> nearbyIndices = collisionGrid->Query(currentPlayerPos);
-                        for (int index : nearbyIndices)
+                        // Physical Collision Check between Player and Asteroids (swept along this tick's movement)
+                        SpatialIndex *spatialIndex = useBvh ? (SpatialIndex *)&asteroidBvh : collisionGrid;
+                        if (spatialIndex != nullptr)
                         {
-                            // Validate index
-                            if (index < 0 || index >= asteroids.size())
-                                continue;
-                            const Asteroid &ast = asteroids[index];
-                            if (!ast.isActive)
-                                continue;
-
-                            // Perform detailed sphere check only on nearby candidates
-                            if (CheckCollisionSpheres(currentPlayerPos, 0.5f, ast.position, ast.collisionRadius)) // Added 0.5f player radius
+                            PROFILE_SCOPE(PROFILE_ZONE_PLAYER_COLLISION);
+                            // Earliest asteroid the player sphere touches between the old and new position
+                            GridSweepHit sweepHit = spatialIndex->SweepSphere(previousPlayerPos, currentPlayerPos, PLAYER_RADIUS, asteroids);
+                            if (sweepHit.instanceIndex != -1)
                             {
                                 // Collision detected - start bouncing
+                                int index = sweepHit.instanceIndex;
                                 isBouncing = true;
                                 bounceTimer = BOUNCE_DURATION;
-                                bounceDirection = Vector3Normalize(Vector3Subtract(currentPlayerPos, ast.position));
-                                customCamera.SetPosition(previousPlayerPos); // Move player back to pre-collision position
-                                asteroids[index].currentColor = RED;         // Make the hit asteroid red
+                                bounceDirection = sweepHit.normal;             // Away from the asteroid at the contact point
+                                customCamera.SetPosition(previousPlayerPos);   // Move player back to pre-collision position
+                                asteroidEffects.MarkTouched(asteroids, index); // Make the hit asteroid red
                                 physicalCollisionOccurred = true;
-                                TraceLog(LOG_INFO, "Player collided with nearby Asteroid %d - BOUNCING", index);
-                                break; // Stop checking once a collision is found
+                                TraceLog(LOG_INFO, "Player collided with Asteroid %d at %.0f%% of the move - BOUNCING", index, sweepHit.time * 100.0f);
                             }
                         }
-                    }
-                    else
-                    {
-                        TraceLog(LOG_WARNING, "Collision grid null, skip player collision");
-                    }
+                        else
+                        {
+                            TraceLog(LOG_WARNING, "Collision grid null, skip player collision");
+                        }
 
-                    // Click-to-Hit Logic (Uses Grid Raycast)
-                    if (!isBouncing && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-                    {
-                        Ray actionRay = customCamera.GetForwardRay(); // Get ray from camera center
-                        RayCollision closestHit = {0};
-                        closestHit.hit = false;
-                        closestHit.distance = FLT_MAX;
-                        int closestAsteroidIndex = -1;
-
-                        // Query the grid for asteroid indices along the ray
-                        if (collisionGrid != nullptr)
+                        // Click-to-Hit Logic (Uses Spatial Index Raycast)
+                        if (!isBouncing && clickQueued)
                         {
-                            std::vector<int> potentialHitIndices = collisionGrid->QueryRay(actionRay, HIT_MAX_DISTANCE);
-                            for (int index : potentialHitIndices)
+                            PROFILE_SCOPE(PROFILE_ZONE_RAYCAST);
+                            Ray actionRay = customCamera.GetForwardRay(); // Get ray from camera center
+                            GridRayHit closestHit = {-1, 0.0f, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+
+                            // Walk the index along the ray, stopping at the nearest asteroid hit
+                            if (spatialIndex != nullptr)
+                                closestHit = spatialIndex->Raycast(actionRay, HIT_MAX_DISTANCE, asteroids);
+                            else
+                                TraceLog(LOG_WARNING, "Collision grid null, skip raycast");
+
+                            // Process the closest hit found
+                            int closestAsteroidIndex = closestHit.instanceIndex;
+                            if (closestAsteroidIndex != -1)
                             {
-                                if (index < 0 || index >= asteroids.size())
-                                    continue; // Validate index
-                                const Asteroid &ast = asteroids[index];
-                                if (!ast.isActive)
-                                    continue;
+                                // Apply damage and effects to the hit asteroid
+                                asteroids.hitPoints[closestAsteroidIndex]--;
+                                asteroidEffects.StartShake(asteroids, closestAsteroidIndex, SHAKE_DURATION);
+                                TraceLog(LOG_INFO, "Asteroid %d clicked! HP: %d Dist: %.2f", closestAsteroidIndex, asteroids.hitPoints[closestAsteroidIndex], closestHit.distance);
 
-                                // Perform detailed ray-sphere check only on potential candidates
-                                RayCollision hitInfo = GetRayCollisionSphere(actionRay, ast.position, ast.collisionRadius);
-
-                                // Check if hit, within max distance, and closer than previous hits
-                                if (hitInfo.hit && hitInfo.distance < closestHit.distance && hitInfo.distance <= HIT_MAX_DISTANCE)
+                                // Check if asteroid is destroyed
+                                if (asteroids.hitPoints[closestAsteroidIndex] <= 0)
                                 {
-                                    closestHit = hitInfo;
-                                    closestAsteroidIndex = index;
+                                    asteroids.flags[closestAsteroidIndex] &= ~ASTEROID_ACTIVE; // Deactivate asteroid
+                                    collisionGrid->Remove(closestAsteroidIndex);                // Drop it from its cells
+                                    asteroidBvh.Remove(closestAsteroidIndex);                   // ... and its leaf
+                                    AddScore(10);                                              // Add score
+                                    TraceLog(LOG_INFO, "Asteroid %d destroyed!", closestAsteroidIndex);
+                                    // Emit particles at destruction point
+                                    EmitParticles(asteroids.positions[closestAsteroidIndex], 50, 2.0f, 1.0f, asteroids.cold[closestAsteroidIndex].color, particleRng);
                                 }
                             }
-                        }
-                        else
-                        {
-                            TraceLog(LOG_WARNING, "Collision grid null, skip raycast");
-                        }
-
-                        // Process the closest hit found
-                        if (closestHit.hit && closestAsteroidIndex != -1)
-                        {
-                            // Apply damage and effects to the hit asteroid
-                            asteroids[closestAsteroidIndex].hitPoints--;
-                            asteroids[closestAsteroidIndex].isShaking = true;
-                            asteroids[closestAsteroidIndex].shakeTimer = SHAKE_DURATION;
-                            asteroids[closestAsteroidIndex].currentColor = RED;
-                            TraceLog(LOG_INFO, "Asteroid %d clicked! HP: %d Dist: %.2f", closestAsteroidIndex, asteroids[closestAsteroidIndex].hitPoints, closestHit.distance);
-
-                            // Check if asteroid is destroyed
-                            if (asteroids[closestAsteroidIndex].hitPoints <= 0)
+                            else
                             {
-                                asteroids[closestAsteroidIndex].isActive = false; // Deactivate asteroid
-                                AddScore(10);                                     // Add score
-                                TraceLog(LOG_INFO, "Asteroid %d destroyed!", closestAsteroidIndex);
-                                // Emit particles at destruction point
-                                EmitParticles(asteroids[closestAsteroidIndex].position, 50, 2.0f, 1.0f, asteroids[closestAsteroidIndex].color);
+                                // Log a miss only if no physical collision happened this tick either
+                                if (!physicalCollisionOccurred)
+                                    TraceLog(LOG_INFO, "Click Miss!");
                             }
                         }
-                        else
-                        {
-                            // Log a miss only if no physical collision happened this frame either
-                            if (!physicalCollisionOccurred)
-                                TraceLog(LOG_INFO, "Click Miss!");
-                        }
-                    }
-
-                } // End else (!isBouncing)
 
-                // Reset Asteroid Colors (Simplified Logic)
-                // Checks if asteroid is not shaking and player isn't currently colliding with it
-                Vector3 finalPlayerPos = customCamera.GetCamera().position;
-                for (size_t i = 0; i < asteroids.size(); ++i)
-                {
-                    if (!asteroids[i].isActive)
-                        continue;
+                    } // End else (!isBouncing)
 
-                    bool currentlyCollidingWithThis = false;
-                    // Rough check if player is colliding with this asteroid 'i'
-                    if (CheckCollisionSpheres(finalPlayerPos, 0.5f, asteroids[i].position, asteroids[i].collisionRadius))
+                    // Update Asteroid Rotations (the drawn angle is extrapolated back to the interpolated time).
+                    // The GPU animation computes them from the clock instead.
+                    animationClock += stepTime;
+                    if (!gpuAnimationActive)
                     {
-                        currentlyCollidingWithThis = true;
+                        PROFILE_SCOPE(PROFILE_ZONE_ROTATION_UPDATE);
+                        UpdateAsteroidRotations(asteroids, stepTime, *jobSystem);
+                        jobSystem->Wait();
                     }
 
-                    // Reset color to default grey if not shaking and player isn't colliding with it
-                    if (!asteroids[i].isShaking && !currentlyCollidingWithThis)
-                    {
-                        asteroids[i].currentColor = asteroids[i].color;
-                    }
-                    else
-                    {
-                        asteroids[i].currentColor = RED; // Keep red if shaking or colliding
-                    }
+                    clickQueued = false; // Input of this frame is consumed by its first tick
                 }
 
-                // Update Asteroid Rotations
-                for (size_t i = 0; i < asteroids.size(); ++i)
+                // Reset Asteroid Colors (red while shaking or while the player is touching the asteroid), once per frame.
+                // Only asteroids registered by a hit or a collision are visited, and dropped once they are back to normal.
                 {
-                    if (!asteroids[i].isActive)
-                        continue;
-                    asteroids[i].rotationAngle += asteroids[i].rotationSpeed * deltaTime;
-                    // Keep angle within 0-360 range
-                    while (asteroids[i].rotationAngle >= 360.0f)
-                        asteroids[i].rotationAngle -= 360.0f;
-                    while (asteroids[i].rotationAngle < 0.0f)
-                        asteroids[i].rotationAngle += 360.0f;
+                    PROFILE_SCOPE(PROFILE_ZONE_COLOR_RESET);
+                    asteroidEffects.UpdateColors(asteroids, customCamera.GetCamera().position, PLAYER_RADIUS);
+                }
+
+                // Endless field: swap sectors in and out around the camera (no asteroid jobs in flight here)
+                if (sectorStreamer != nullptr)
+                {
+                    PROFILE_SCOPE(PROFILE_ZONE_SECTOR_STREAMING);
+                    sectorStreamer->Update(customCamera.GetCamera().position, SECTOR_INSTALL_BUDGET);
+                    // The instance table is rebuilt when GPU animation is switched back on
+                    if (gpuAnimationActive)
+                    {
+                        for (int slot : sectorStreamer->GetInstalledSlots())
+                        {
+                            size_t base = (size_t)slot * AsteroidFieldConstants::SECTOR_MAX_ASTEROIDS;
+                            asteroidRenderer->UpdateInstances(asteroids, base, base + AsteroidFieldConstants::SECTOR_MAX_ASTEROIDS,
+                                                              animationClock);
+                        }
+                    }
                 }
             } // End else (not pausing)
         }
@@ -422,15 +569,51 @@ int main(void)
             break;
         } // End switch (currentScreen) for Update
 
+        // Camera for this frame's rendering, between the last two simulation ticks
+        Camera3D renderCamera = customCamera.GetInterpolatedCamera(previousTickCameraPos, simClock.GetAlpha());
+
+        // Asteroid culling runs on the workers once this frame's updates are done
+        if (currentScreen == GAMEPLAY && gameInitialized)
+        {
+            PROFILE_SCOPE(PROFILE_ZONE_CULLING);
+            // Same aspect and near plane as BeginMode3D, far plane at the draw distance
+            CullView cullView = GetCullView(renderCamera, GetScreenWidth(), GetScreenHeight(), MAX_DRAW_DISTANCE);
+            cullView.rotationTimeOffset = simClock.GetRenderTimeOffset();
+            cullView.buildTransforms = !gpuAnimationActive;
+            SpatialIndex *cullIndex = useBvh ? (SpatialIndex *)&asteroidBvh : collisionGrid;
+            CullAsteroids(asteroids, cullView, cullIndex, cullMode, cullResult, *jobSystem);
+            jobSystem->Wait();
+        }
+        if (currentScreen == GAMEPLAY && gameInitialized && useOcclusionCulling)
+        {
+            PROFILE_SCOPE(PROFILE_ZONE_OCCLUSION);
+            occlusionCuller.Cull(asteroids, renderCamera, GetScreenWidth(), GetScreenHeight(), cullResult, *jobSystem);
+        }
+        jobSystem->Wait(); // Join point: no asteroid jobs in flight while drawing or loading
+
+        // Resource accounting: sample the owners once per frame (F1 overlay, logged on exit)
+        SetResourceBytes(RESOURCE_MESH_CPU, GetMeshPoolCpuMemory(meshPool));
+        SetResourceBytes(RESOURCE_MESH_GPU, GetMeshPoolGpuMemory(meshPool));
+        SetResourceBytes(RESOURCE_INSTANCE_GPU, asteroidRenderer->GetGpuMemoryUsage());
+        SetResourceBytes(RESOURCE_BACKGROUND_GPU, background->GetGpuMemoryUsage());
+        SetResourceBytes(RESOURCE_ASTEROIDS, asteroids.GetMemoryUsage());
+        SetResourceBytes(RESOURCE_SPATIAL_INDEX, ((collisionGrid != nullptr) ? collisionGrid->GetMemoryUsage() : 0) + asteroidBvh.GetMemoryUsage());
+        SetResourceBytes(RESOURCE_RENDERER, asteroidRenderer->GetMemoryUsage());
+        SetResourceBytes(RESOURCE_PARTICLES, GetParticleStats().memoryBytes);
+        SetResourceBytes(RESOURCE_STARS, background->GetMemoryUsage());
+        SetResourceBytes(RESOURCE_FRAME_ARENA, frameArena.GetStats().capacity);
+        ResourceTrackerEndFrame(frameHeapAllocations);
+
         //----------------------------------------------------------------------------------
 
         // Draw
         //----------------------------------------------------------------------------------
         BeginDrawing();
         ClearBackground(spaceBlueDark); // Clear with dark blue
-        // Draw background gradient
-        DrawRectangleGradientV(0, 0, (float)screenWidth, (float)screenHeight, spaceBlueDark, spaceBlueLight);
-        DrawStars(stars); // Draw background stars
+        {
+            PROFILE_SCOPE(PROFILE_ZONE_BACKGROUND_DRAW);
+            background->Draw(customCamera.GetCamera()); // Background gradient and stars
+        }
 
         // Draw UI or 3D Scene based on current screen
         switch (currentScreen)
@@ -442,12 +625,14 @@ int main(void)
             int titleFontSize = 60;
             int titleWidth = MeasureText(title, titleFontSize);
             DrawText(title, screenWidth / 2 - titleWidth / 2, screenHeight / 4, titleFontSize, YELLOW);
-            const char *option1 = "New Game", *option2 = "Quit";
+            const char *option1 = "New Game", *option2 = "Endless Field", *option3 = "Quit";
             int optionFontSize = 40;
             int option1Width = MeasureText(option1, optionFontSize);
             int option2Width = MeasureText(option2, optionFontSize);
-            DrawText(option1, screenWidth / 2 - option1Width / 2, screenHeight / 2 + 0, optionFontSize, mainMenuSelection == 0 ? MAROON : GRAY);  // Highlight selected
-            DrawText(option2, screenWidth / 2 - option2Width / 2, screenHeight / 2 + 50, optionFontSize, mainMenuSelection == 1 ? MAROON : GRAY); // Highlight selected
+            int option3Width = MeasureText(option3, optionFontSize);
+            DrawText(option1, screenWidth / 2 - option1Width / 2, screenHeight / 2 + 0, optionFontSize, mainMenuSelection == 0 ? MAROON : GRAY);   // Highlight selected
+            DrawText(option2, screenWidth / 2 - option2Width / 2, screenHeight / 2 + 50, optionFontSize, mainMenuSelection == 1 ? MAROON : GRAY);  // Highlight selected
+            DrawText(option3, screenWidth / 2 - option3Width / 2, screenHeight / 2 + 100, optionFontSize, mainMenuSelection == 2 ? MAROON : GRAY); // Highlight selected
             DrawText("Use UP/DOWN keys and ENTER", 10, screenHeight - 30, 20, LIGHTGRAY);
         }
         break;
@@ -457,7 +642,18 @@ int main(void)
             const char *loadingText = "Loading Assets...";
             int loadingFontSize = 40;
             int loadingTextWidth = MeasureText(loadingText, loadingFontSize);
-            DrawText(loadingText, screenWidth / 2 - loadingTextWidth / 2, screenHeight / 2 - loadingFontSize / 2, loadingFontSize, RAYWHITE);
+            DrawText(loadingText, screenWidth / 2 - loadingTextWidth / 2, screenHeight / 2 - loadingFontSize / 2 - 40, loadingFontSize, RAYWHITE);
+
+            // Progress bar with the current loading stage below it
+            Rectangle barRec = {screenWidth / 2.0f - 250.0f, screenHeight / 2.0f + 10.0f, 500.0f, 24.0f};
+            float progress = (sectorStreamer != nullptr) ? sectorStreamer->GetProgress() : fieldLoader->GetProgress();
+            DrawRectangleRec((Rectangle){barRec.x, barRec.y, barRec.width * progress, barRec.height}, RAYWHITE);
+            DrawRectangleLinesEx(barRec, 2.0f, LIGHTGRAY);
+            const char *statusText = (sectorStreamer != nullptr)
+                                         ? TextFormat("Streaming sectors %d/%d", sectorStreamer->GetStats().residentSectors,
+                                                      sectorStreamer->GetStats().wantedSectors)
+                                         : fieldLoader->GetStatusText();
+            DrawText(statusText, screenWidth / 2 - MeasureText(statusText, 20) / 2, (int)(barRec.y + barRec.height) + 12, 20, LIGHTGRAY);
         }
         break;
         case PAUSE_MENU:
@@ -490,84 +686,150 @@ int main(void)
                 break; // Don't draw if not loaded
 
             // Enter 3D mode
-            BeginMode3D(customCamera.GetCamera());
-
-            // Simple Frustum Culling Setup
-            Camera3D cam = customCamera.GetCamera();
-            Vector3 camPos = cam.position;
-            Vector3 camFwd = Vector3Normalize(Vector3Subtract(cam.target, camPos));
-            float maxDrawDistanceSq = 250.0f * 250.0f;              // Max distance to draw (squared)
-            float minDotProduct = cosf(cam.fovy * DEG2RAD * 0.85f); // Angle threshold based on FOV
-            drawnAsteroids = 0;                                     // Reset drawn counter
-
-            // Draw Asteroids (with Culling)
-            for (size_t i = 0; i < asteroids.size(); ++i)
-            {
-                if (!asteroids[i].isActive)
-                    continue; // Skip inactive asteroids
-
-                // --- Frustum Culling Check ---
-                Vector3 toAsteroid = Vector3Subtract(asteroids[i].position, camPos);
-                float distSq = Vector3LengthSqr(toAsteroid);
+            BeginMode3D(renderCamera);
 
-                // 1. Distance Check
-                if (distSq > maxDrawDistanceSq)
-                    continue; // Skip if too far
+            ProfilerBeginZone(PROFILE_ZONE_ASTEROID_DRAW);
+            drawnAsteroids = 0; // Reset drawn counter
+            int lodCounts[AsteroidFieldConstants::LOD_IMPOSTOR + 1] = {0};
+            asteroidRenderer->BeginFrame((int)meshPool.meshes.size(), &frameArena);
 
-                // 2. Angle Check (skip if very close)
-                if (distSq > 1.0f)
-                {
-                    Vector3 asteroidDir = Vector3Normalize(toAsteroid);
-                    float dotProduct = Vector3DotProduct(camFwd, asteroidDir);
-                    if (dotProduct < minDotProduct)
-                        continue; // Skip if outside rough FOV cone
-                }
-                // --- End Culling Check ---
+            // Draw Asteroids (visibility and transforms come from the culling jobs)
+            for (size_t k = 0; k < cullResult.candidates.size(); ++k)
+            {
+                if (!cullResult.visible[k])
+                    continue; // Inactive or culled
+                int i = cullResult.candidates[k];
 
                 drawnAsteroids++; // Increment count of asteroids actually drawn
+                int lod = asteroids.lodLevels[i];
+                lodCounts[lod]++;
 
-                // Calculate asteroid's transform (rotation, translation with shake)
+                // Shake is applied here, on the main thread, from the effects stream
+                const AsteroidColdData &cold = asteroids.cold[i];
                 Vector3 shakeOffset = {0};
-                if (asteroids[i].isShaking)
+                if (asteroids.IsShaking(i))
+                    effectsRng.FillFloats(&shakeOffset.x, 3, -cold.shakeIntensity, cold.shakeIntensity);
+
+                if (lod == AsteroidFieldConstants::LOD_IMPOSTOR)
                 {
-                    shakeOffset.x = GetRandomFloat(-asteroids[i].shakeIntensity, asteroids[i].shakeIntensity);
-                    shakeOffset.y = GetRandomFloat(-asteroids[i].shakeIntensity, asteroids[i].shakeIntensity);
-                    shakeOffset.z = GetRandomFloat(-asteroids[i].shakeIntensity, asteroids[i].shakeIntensity);
+                    // Too small on screen for a mesh, draw a billboard covering the bounding sphere
+                    asteroidRenderer->SubmitImpostor(Vector3Add(asteroids.positions[i], shakeOffset),
+                                                     2.0f * asteroids.collisionRadii[i], asteroids.currentColors[i]);
                 }
-                Matrix matRotation = MatrixRotate(asteroids[i].rotationAxis, asteroids[i].rotationAngle * DEG2RAD);
-                Matrix matTranslation = MatrixTranslate(asteroids[i].position.x + shakeOffset.x,
-                                                        asteroids[i].position.y + shakeOffset.y,
-                                                        asteroids[i].position.z + shakeOffset.z);
-                Matrix matTransform = MatrixMultiply(matRotation, matTranslation);
+                else if (gpuAnimationActive)
+                {
+                    // Rotation comes from the instance texture, only changed tints and offsets are patched
+                    asteroidRenderer->SetInstanceTint(i, asteroids.currentColors[i]);
+                    asteroidRenderer->SetInstanceOffset(i, shakeOffset);
+                    asteroidRenderer->SubmitAnimated(GetMeshPoolIndex(meshPool, cold.variantIndex, lod), i);
+                }
+                else
+                {
+                    Matrix matTransform = cullResult.transforms[k];
+                    matTransform.m12 += shakeOffset.x;
+                    matTransform.m13 += shakeOffset.y;
+                    matTransform.m14 += shakeOffset.z;
 
-                // Update material color and draw the mesh
-                asteroids[i].material.maps[MATERIAL_MAP_DIFFUSE].color = asteroids[i].currentColor;
-                DrawMesh(asteroids[i].mesh, asteroids[i].material, matTransform);
+                    // Queue the asteroid in its variant + LOD bucket with its current tint
+                    asteroidRenderer->Submit(GetMeshPoolIndex(meshPool, cold.variantIndex, lod), matTransform, asteroids.currentColors[i]);
+                }
 
                 // Draw debug collision spheres if enabled
                 if (showDebug)
                 {
-                    DrawSphereWires(asteroids[i].position, asteroids[i].collisionRadius, 16, 16, YELLOW);
+                    DrawSphereWires(asteroids.positions[i], asteroids.collisionRadii[i], 16, 16, YELLOW);
                 }
             }
 
+            // Draw all queued asteroids (one instanced call per variant LOD, impostors batched)
+            asteroidRenderer->Flush(meshPool, renderCamera, useInstancing, animationClock + simClock.GetRenderTimeOffset());
+            ProfilerEndZone(PROFILE_ZONE_ASTEROID_DRAW);
+
             // Draw active particles
-            DrawParticles();
+            {
+                PROFILE_SCOPE(PROFILE_ZONE_PARTICLE_DRAW);
+                DrawParticles();
+            }
 
             // Exit 3D mode
             EndMode3D();
 
             // Draw Gameplay UI (on top of 3D scene)
+            PROFILE_SCOPE(PROFILE_ZONE_UI);
             DrawFPS(10, 10); // Show FPS
             // Show how many asteroids were drawn after culling vs total active
-            DrawText(TextFormat("Asteroids Drawn: %d/%zu", drawnAsteroids, asteroids.size()), 10, 40, 20, RAYWHITE);
-            DrawText("[LMB] Hit | [P] Menu", 10, 70, 20, RAYWHITE); // Controls help text
+            // (an endless field counts the asteroids of its resident sectors, not the store's slot capacity)
+            size_t fieldAsteroids = (sectorStreamer != nullptr) ? (size_t)sectorStreamer->GetStats().liveAsteroids : asteroids.Size();
+            DrawText(TextFormat("Asteroids Drawn: %d/%zu", drawnAsteroids, fieldAsteroids), 10, 40, 20, RAYWHITE);
+            DrawText(TextFormat("Draw Calls: %d (%s, F2) | Rotation: %s (F9)", asteroidRenderer->GetDrawCallCount(),
+                                (useInstancing && asteroidRenderer->IsInstancingAvailable()) ? "Instanced" : "DrawMesh",
+                                gpuAnimationActive ? TextFormat("GPU, %d rows patched", asteroidRenderer->GetInstanceRowUploads()) : "CPU"),
+                     10, 70, 20, RAYWHITE);
+            OcclusionStats occlusionStats = occlusionCuller.GetStats();
+            DrawText(TextFormat("Culling: %s (F4/F6), %zu candidates | Occlusion: %s (F10)",
+                                (cullMode == CULL_MODE_GRID) ? (useBvh ? "BVH nodes" : "Grid cells") : "Brute force",
+                                cullResult.candidates.size(),
+                                useOcclusionCulling ? TextFormat("%d hidden by %d occluders", occlusionStats.occluded, occlusionStats.occluders) : "OFF"),
+                     10, 100, 20, RAYWHITE);
+            DrawText(TextFormat("LOD 0/1/2: %d/%d/%d | Impostors: %d | Background: %s (F8)", lodCounts[0], lodCounts[1],
+                                lodCounts[2], lodCounts[AsteroidFieldConstants::LOD_IMPOSTOR], background->GetModeName()),
+                     10, 130, 20, RAYWHITE);
+            if (simClock.IsFixed()) // Controls help text with the simulation mode
+                DrawText(TextFormat("[LMB] Hit | [P] Menu | [F3] Profiler | [F7] Sim: %.0f Hz fixed", simClock.GetTickRate()), 10, 160, 20, RAYWHITE);
+            else
+                DrawText("[LMB] Hit | [P] Menu | [F3] Profiler | [F7] Sim: frame time", 10, 160, 20, RAYWHITE);
             DrawScoreUI(screenWidth - 150, 10, 30, YELLOW);         // Draw current score
             // Show debug status
             if (showDebug)
-                DrawText("Debug Spheres: ON (F1)", 10, screenHeight - 30, 20, YELLOW);
+            {
+                ParticleStats particleStats = GetParticleStats();
+                DrawText(TextFormat("Particles: %d live / %d capacity, peak %d, dropped %d", particleStats.live,
+                                    particleStats.capacity, particleStats.peak, particleStats.dropped),
+                         10, screenHeight - 90, 20, YELLOW);
+            }
+            if (showDebug && sectorStreamer != nullptr)
+            {
+                SectorStreamStats streamStats = sectorStreamer->GetStats();
+                DrawText(TextFormat("Sectors: %d resident, %d pending, %d installed, %d evicted, %d budget skips",
+                                    streamStats.residentSectors, streamStats.pendingSectors, streamStats.sectorsInstalled,
+                                    streamStats.sectorsEvicted, streamStats.budgetSkips),
+                         10, screenHeight - 120, 20, YELLOW);
+            }
+            if (showDebug)
+            {
+                FrameArenaStats arenaStats = frameArena.GetStats();
+                const char *heapText = (frameHeapAllocations >= 0) ? TextFormat("%lld", frameHeapAllocations) : "n/a";
+                DrawText(TextFormat("Frame arena: %.0f KB used, high-water %.0f / %.0f KB, %d blocks | Heap allocs/frame: %s",
+                                    arenaStats.lastFrame / 1024.0f, arenaStats.highWater / 1024.0f, arenaStats.capacity / 1024.0f,
+                                    arenaStats.heapBlocks, heapText),
+                         10, screenHeight - 150, 20, YELLOW);
+            }
+            if (showDebug && collisionGrid != nullptr && !useBvh)
+            {
+                const GridQueryStats &gridStats = collisionGrid->GetQueryStats();
+                DrawText(TextFormat("Grid: %d queries, %d cells, %d candidates, %d allocs/frame, %d overflow",
+                                    gridStats.queries, gridStats.cellsVisited, gridStats.candidates, gridStats.allocations,
+                                    collisionGrid->GetOverflowCount()),
+                         10, screenHeight - 60, 20, YELLOW);
+            }
+            if (showDebug && useBvh)
+            {
+                const GridQueryStats &bvhStats = asteroidBvh.GetQueryStats();
+                DrawText(TextFormat("BVH: %d queries, %d nodes visited, %d candidates | %d nodes, depth %d, %d pending",
+                                    bvhStats.queries, bvhStats.cellsVisited, bvhStats.candidates, asteroidBvh.GetNodeCount(),
+                                    asteroidBvh.GetDepth(), asteroidBvh.GetPendingCount()),
+                         10, screenHeight - 60, 20, YELLOW);
+            }
+            if (showDebug)
+                DrawText(TextFormat("Debug Spheres: ON (F1) | Job threads: %d | Ticks dropped: %d | Effects: %d", jobSystem->GetThreadCount(),
+                                    simClock.GetDroppedSteps(), asteroidEffects.GetActiveCount()),
+                         10, screenHeight - 30, 20, YELLOW);
             else
                 DrawText("Debug Spheres: OFF (F1)", 10, screenHeight - 30, 20, GRAY);
+            if (showProfiler)
+                DrawProfilerOverlay(screenWidth - 310, 50);
+            if (showDebug)
+                DrawResourceOverlay(10, 190); // Between the HUD lines and the debug lines
         }
         break;
 
@@ -576,85 +838,41 @@ int main(void)
         } // End switch (currentScreen) for Draw
 
         EndDrawing();
+        ProfilerEndFrame();
         //----------------------------------------------------------------------------------
 
-        // --- State Transition & Heavy Loading ---
-        // This block executes after drawing, primarily for the LOADING state
-        if (currentScreen == LOADING && !gameInitialized)
-        {
-            // Cleanup previous game state if it exists
-            if (collisionGrid != nullptr)
-            {
-                delete collisionGrid;
-                collisionGrid = nullptr;
-                TraceLog(LOG_INFO, "Deleted previous collision grid.");
-            }
-            if (!asteroids.empty())
-            {
-                TraceLog(LOG_INFO, "Unloading previous asteroid meshes...");
-                for (size_t i = 0; i < asteroids.size(); ++i)
-                    if (asteroids[i].mesh.vboId != nullptr)
-                        UnloadMesh(asteroids[i].mesh);
-                asteroids.clear();
-            }
-
-            // Load new game assets
-            TraceLog(LOG_INFO, "Loading asteroids...");
-            asteroids = InitializeAsteroidField(defaultMaterial); // Generate asteroids
-            gameInitialized = true;                               // Mark as initialized
-            TraceLog(LOG_INFO, "Asteroid loading complete.");
-
-            // Initialize Collision Grid based on Asteroid Field Constants
-            using namespace AsteroidFieldConstants;
-            float maxPossibleAsteroidRadius = BASE_MESH_RADIUS * 3.0f;
-            float extraPadding = gridCellSize.x; // Padding based on cell size
-            // Calculate max world extent based on generation parameters
-            float maxExtent = CLUSTER_SPREAD_RADIUS + ASTEROID_SCATTER_RADIUS + maxPossibleAsteroidRadius + extraPadding;
-            Vector3 minBounds = {-maxExtent, -maxExtent, -maxExtent}; // Grid min corner
-            Vector3 maxBounds = {maxExtent, maxExtent, maxExtent};    // Grid max corner
-            TraceLog(LOG_INFO, "Calculated Grid Bounds: Min(%.2f) Max(%.2f)", minBounds.x, maxBounds.x);
-
-            // Create the grid object dynamically
-            collisionGrid = new UniformGrid(minBounds, maxBounds, gridCellSize);
-
-            // Populate the grid with the loaded asteroids
-            if (!asteroids.empty())
-            {
-                TraceLog(LOG_INFO, "Building collision grid...");
-                collisionGrid->BuildInstanced(asteroids); // Add asteroids to grid cells
-                TraceLog(LOG_INFO, "Collision grid built.");
-            }
-            else
-            {
-                TraceLog(LOG_WARNING, "No asteroids loaded, grid initialized empty.");
-            }
-
-            // Switch to Gameplay state
-            currentScreen = GAMEPLAY;
-            DisableCursor(); // Hide cursor for gameplay
-        }
-        // --- End State Transition ---
-
     } // End main game loop
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    LogResourceUsage(); // Peaks of the whole run, before anything is released
+    FrameArenaStats arenaStats = frameArena.GetStats();
+    TraceLog(LOG_INFO, "FRAME ARENA: high-water %.1f KB of %.1f KB, %d block allocations", arenaStats.highWater / 1024.0f,
+             arenaStats.capacity / 1024.0f, arenaStats.heapBlocks);
+
     // Clean up allocated resources
+    delete sectorStreamer; // Joins its worker first, it reads the mesh pool
+    sectorStreamer = nullptr;
     if (collisionGrid != nullptr)
     {
         delete collisionGrid; // Free grid memory
         collisionGrid = nullptr;
         TraceLog(LOG_INFO, "Deleted collision grid.");
     }
-    if (!asteroids.empty())
+    if (!meshPool.meshes.empty())
     {
         // Unload asteroid meshes from GPU memory
-        TraceLog(LOG_INFO, "Unloading final asteroid meshes...");
-        for (size_t i = 0; i < asteroids.size(); ++i)
-            if (asteroids[i].mesh.vboId != nullptr)
-                UnloadMesh(asteroids[i].mesh);
+        TraceLog(LOG_INFO, "Unloading final asteroid mesh pool...");
+        UnloadAsteroidMeshPool(meshPool);
     }
-    UnloadMaterial(defaultMaterial); // Unload default material
+    delete fieldLoader; // Waits for an unfinished load and frees its results
+    fieldLoader = nullptr;
+    delete asteroidRenderer; // Unloads instancing shader and materials
+    asteroidRenderer = nullptr;
+    delete background; // Unloads the baked background textures
+    background = nullptr;
+    delete jobSystem; // Joins worker threads
+    jobSystem = nullptr;
 
     EnableCursor(); // Ensure cursor is visible on exit
     CloseWindow();  // Close window and unload OpenGL context
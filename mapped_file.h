@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+//------------------------------------------------------------------------------------
+// Read-Only Memory-Mapped File
+//------------------------------------------------------------------------------------
+// Maps a whole file into the address space (mmap / MapViewOfFile), so its contents can be
+// used in place: pages are faulted in from the OS file cache on first touch, nothing is
+// copied up front. The view stays valid until Close() or destruction.
+// Kept free of raylib.h: the implementation includes windows.h, which clashes with it.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile(); // Unmaps the view
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool Open(const char *path); // False if the file is missing, empty or cannot be mapped
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const unsigned char *GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    const unsigned char *data;
+    size_t size;
+#if defined(_WIN32)
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+};
+
+#endif // MAPPED_FILE_H
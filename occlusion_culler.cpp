@@ -0,0 +1,194 @@
+#include "occlusion_culler.h"
+#include "raymath.h"
+#include "rlgl.h"     // For RL_CULL_DISTANCE_NEAR
+#include <algorithm> // For std::nth_element, std::fill
+#include <cfloat>    // For FLT_MAX
+#include <cmath>
+
+//------------------------------------------------------------------------------------
+// OcclusionCuller Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+OcclusionCuller::OcclusionCuller(int bufferWidth)
+    : width(bufferWidth > 0 ? bufferWidth : OCCLUSION_BUFFER_WIDTH), height(0), eye{0}, right{0}, up{0}, forward{0},
+      focal(0.0f), nearPlane(0.0f), stats{0}, occludedCount(0)
+{
+    occluders.reserve(OCCLUSION_MAX_OCCLUDERS * 4);
+}
+
+void OcclusionCuller::SetMeshPool(const AsteroidMeshPool &pool, float meshIrregularity)
+{
+    // Occluders are drawn at LOD 0 or 1, the coarser one dents the most
+    float innerRadius = GetAsteroidMeshInnerRadius(meshIrregularity, OCCLUSION_OCCLUDER_MAX_LOD);
+    occluderScales.assign(pool.radii.size(), 0.0f);
+    for (size_t v = 0; v < pool.radii.size(); ++v)
+    {
+        if (pool.radii[v] > 0.0f)
+            occluderScales[v] = fminf(innerRadius / pool.radii[v], 1.0f);
+    }
+}
+
+// Camera basis and a projection to buffer pixels matching BeginMode3D for this screen
+void OcclusionCuller::SetupView(Camera3D camera, int screenWidth, int screenHeight)
+{
+    int bufferHeight = (screenWidth > 0 && screenHeight > 0) ? (int)lroundf((float)width * screenHeight / screenWidth) : width;
+    height = (bufferHeight > 0) ? bufferHeight : 1;
+    if (depthBuffer.size() != (size_t)width * height)
+        depthBuffer.resize((size_t)width * height);
+
+    eye = camera.position;
+    forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    right = Vector3Normalize(Vector3CrossProduct(forward, camera.up));
+    up = Vector3CrossProduct(right, forward);
+    focal = (float)height * 0.5f / tanf(camera.fovy * DEG2RAD * 0.5f);
+    nearPlane = (float)RL_CULL_DISTANCE_NEAR;
+}
+
+// Visible mesh asteroids whose inner sphere covers enough pixels, the largest ones only
+void OcclusionCuller::GatherOccluders(const AsteroidStore &asteroids, const AsteroidCullResult &result)
+{
+    occluders.clear();
+    for (size_t k = 0; k < result.candidates.size(); ++k)
+    {
+        if (!result.visible[k])
+            continue;
+        stats.tested++;
+        int i = result.candidates[k];
+        if (asteroids.lodLevels[i] > OCCLUSION_OCCLUDER_MAX_LOD || asteroids.IsShaking(i))
+            continue; // Shake moves the mesh off its position
+        int variant = asteroids.cold[i].variantIndex;
+        if (variant < 0 || (size_t)variant >= occluderScales.size())
+            continue;
+
+        float radius = asteroids.collisionRadii[i] * occluderScales[variant];
+        Vector3 d = Vector3Subtract(asteroids.positions[i], eye);
+        float z = Vector3DotProduct(d, forward);
+        if (z - radius <= nearPlane)
+            continue;
+        float pixelRadius = radius * focal / z;
+        if (pixelRadius < OCCLUSION_MIN_OCCLUDER_PIXELS)
+            continue;
+
+        Occluder occluder;
+        occluder.screenX = (float)width * 0.5f + Vector3DotProduct(d, right) * focal / z;
+        occluder.screenY = (float)height * 0.5f - Vector3DotProduct(d, up) * focal / z;
+        occluder.pixelRadius = pixelRadius;
+        occluder.depth = z;
+        occluders.push_back(occluder);
+    }
+
+    if (occluders.size() > (size_t)OCCLUSION_MAX_OCCLUDERS)
+    {
+        std::nth_element(occluders.begin(), occluders.begin() + OCCLUSION_MAX_OCCLUDERS, occluders.end(),
+                         [](const Occluder &a, const Occluder &b)
+                         { return a.pixelRadius > b.pixelRadius; });
+        occluders.resize(OCCLUSION_MAX_OCCLUDERS);
+    }
+}
+
+// The sphere's slice through its center, parallel to the screen, projects to exactly this disc and
+// lies inside the sphere, so every covered pixel sees the asteroid at the center depth or nearer
+void OcclusionCuller::RasterizeOccluder(const Occluder &occluder)
+{
+    float radius = occluder.pixelRadius - 0.7072f; // Only pixels the disc covers entirely
+    if (radius <= 0.0f)
+        return;
+
+    int y0 = std::max(0, (int)ceilf(occluder.screenY - radius - 0.5f));
+    int y1 = std::min(height - 1, (int)floorf(occluder.screenY + radius - 0.5f));
+    for (int py = y0; py <= y1; ++py)
+    {
+        float dy = (float)py + 0.5f - occluder.screenY;
+        float spanSq = radius * radius - dy * dy;
+        if (spanSq <= 0.0f)
+            continue;
+        float span = sqrtf(spanSq);
+        int x0 = std::max(0, (int)ceilf(occluder.screenX - span - 0.5f));
+        int x1 = std::min(width - 1, (int)floorf(occluder.screenX + span - 0.5f));
+        float *row = depthBuffer.data() + (size_t)py * width;
+        for (int px = x0; px <= x1; ++px)
+            row[px] = fminf(row[px], occluder.depth);
+    }
+}
+
+// Occluded when every pixel of the sphere's screen rectangle is nearer than the sphere's front
+bool OcclusionCuller::IsSphereOccluded(Vector3 center, float radius) const
+{
+    Vector3 d = Vector3Subtract(center, eye);
+    float z = Vector3DotProduct(d, forward);
+    float zNear = z - radius;
+    if (zNear <= nearPlane)
+        return false;
+    float zFar = z + radius;
+    float x = Vector3DotProduct(d, right);
+    float y = Vector3DotProduct(d, up);
+
+    // Projection of the sphere's view-space box, which contains the sphere's own projection
+    float minX = fminf((x - radius) / zNear, (x - radius) / zFar);
+    float maxX = fmaxf((x + radius) / zNear, (x + radius) / zFar);
+    float minY = fminf((y - radius) / zNear, (y - radius) / zFar);
+    float maxY = fmaxf((y + radius) / zNear, (y + radius) / zFar);
+    int x0 = std::max(0, (int)floorf((float)width * 0.5f + minX * focal));
+    int x1 = std::min(width - 1, (int)floorf((float)width * 0.5f + maxX * focal));
+    int y0 = std::max(0, (int)floorf((float)height * 0.5f - maxY * focal));
+    int y1 = std::min(height - 1, (int)floorf((float)height * 0.5f - minY * focal));
+    if (x0 > x1 || y0 > y1)
+        return false; // Off the buffer, leave it to the frustum test
+
+    for (int py = y0; py <= y1; ++py)
+    {
+        const float *row = depthBuffer.data() + (size_t)py * width;
+        for (int px = x0; px <= x1; ++px)
+        {
+            if (row[px] >= zNear)
+                return false;
+        }
+    }
+    return true;
+}
+
+void OcclusionCuller::Cull(const AsteroidStore &asteroids, Camera3D camera, int screenWidth, int screenHeight,
+                           AsteroidCullResult &result, JobSystem &jobs)
+{
+    stats = OcclusionStats{0};
+    if (result.candidates.empty() || occluderScales.empty())
+        return;
+
+    SetupView(camera, screenWidth, screenHeight);
+    GatherOccluders(asteroids, result);
+    stats.occluders = (int)occluders.size();
+    if (occluders.empty())
+        return;
+
+    std::fill(depthBuffer.begin(), depthBuffer.end(), FLT_MAX);
+    for (const Occluder &occluder : occluders)
+        RasterizeOccluder(occluder);
+
+    // The buffer is read-only from here, each chunk clears the flags of its own candidates
+    occludedCount = 0;
+    const OcclusionCuller *culler = this;
+    const AsteroidStore *store = &asteroids;
+    AsteroidCullResult *cull = &result;
+    std::atomic<int> *counter = &occludedCount;
+    jobs.ParallelFor(result.candidates.size(), ASTEROID_JOB_CHUNK, [=](size_t begin, size_t end)
+                     {
+        int occluded = 0;
+        for (size_t k = begin; k < end; ++k)
+        {
+            if (!cull->visible[k])
+                continue;
+            int i = cull->candidates[k];
+            if (store->IsShaking(i))
+                continue; // Drawn off its position
+            if (culler->IsSphereOccluded(store->positions[i], store->collisionRadii[i]))
+            {
+                cull->visible[k] = 0;
+                occluded++;
+            }
+        }
+        if (occluded > 0)
+            counter->fetch_add(occluded, std::memory_order_relaxed); });
+    jobs.Wait();
+    stats.occluded = occludedCount.load();
+}
@@ -0,0 +1,77 @@
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include "raylib.h"
+#include <atomic>
+#include <vector>
+
+#include "asteroid_field.h"
+#include "asteroid_store.h"
+#include "asteroid_systems.h"
+#include "job_system.h"
+
+//------------------------------------------------------------------------------------
+// Software Occlusion Culling
+//------------------------------------------------------------------------------------
+// Runs after frustum culling. The largest nearby visible asteroids are rasterized as flat discs
+// into a small CPU depth buffer (linear view depth, nearest wins), using a sphere every variant
+// mesh fully covers so an occluder never hides more than the asteroid itself would. Every other
+// visible candidate is then tested on the workers: when the screen rectangle of its bounding
+// sphere only holds occluder depths nearer than the sphere's front, its visible flag is cleared
+// and the draw loop skips it. Asteroids inside clusters, behind their front members, go away.
+constexpr int OCCLUSION_BUFFER_WIDTH = 256;           // Depth buffer width, height follows the screen aspect
+constexpr int OCCLUSION_MAX_OCCLUDERS = 48;           // Largest on-screen asteroids rasterized per frame
+constexpr float OCCLUSION_MIN_OCCLUDER_PIXELS = 3.0f; // Occluder disc radius (buffer pixels) worth rasterizing
+constexpr int OCCLUSION_OCCLUDER_MAX_LOD = 1;         // Coarser levels are too small to hide anything
+
+typedef struct
+{
+    int occluders; // Discs rasterized this frame
+    int tested;    // Visible candidates tested against the buffer
+    int occluded;  // Candidates hidden (visible flag cleared)
+} OcclusionStats;
+
+class OcclusionCuller
+{
+public:
+    explicit OcclusionCuller(int bufferWidth = OCCLUSION_BUFFER_WIDTH);
+
+    // Occluder radius of each variant of the field's mesh pool (call once per loaded field)
+    void SetMeshPool(const AsteroidMeshPool &pool, float meshIrregularity);
+
+    // Clears the visible flag of result's candidates hidden behind the occluders. Must see the
+    // same camera as the culling pass; joins its jobs before returning.
+    void Cull(const AsteroidStore &asteroids, Camera3D camera, int screenWidth, int screenHeight, AsteroidCullResult &result,
+              JobSystem &jobs);
+
+    OcclusionStats GetStats() const { return stats; }
+    int GetBufferWidth() const { return width; }
+    int GetBufferHeight() const { return height; }
+
+private:
+    typedef struct
+    {
+        float screenX, screenY; // Projected center (buffer pixels)
+        float pixelRadius;      // Disc radius (buffer pixels)
+        float depth;            // View depth of the asteroid center
+    } Occluder;
+
+    void SetupView(Camera3D camera, int screenWidth, int screenHeight);
+    void GatherOccluders(const AsteroidStore &asteroids, const AsteroidCullResult &result);
+    void RasterizeOccluder(const Occluder &occluder);
+    bool IsSphereOccluded(Vector3 center, float radius) const;
+
+    int width, height;
+    std::vector<float> depthBuffer;    // Row-major, FLT_MAX where nothing was drawn
+    std::vector<float> occluderScales; // Per variant: occluder radius / collision radius
+    std::vector<Occluder> occluders;
+
+    // This frame's view (camera basis and projection in buffer pixels)
+    Vector3 eye, right, up, forward;
+    float focal, nearPlane;
+
+    OcclusionStats stats;
+    std::atomic<int> occludedCount; // Written by the test jobs
+};
+
+#endif // OCCLUSION_CULLER_H
@@ -1,76 +1,177 @@
 #include "particle_system.h"
-#include "asteroid_field.h" // For GetRandomFloat - Alternatively move GetRandomFloat to its own utils header/cpp
 #include "raymath.h" // For Vector math
+#include "rlgl.h"    // For the batched quad renderer
 #include <vector>
-#include <cstdlib> // For rand()
+#include <algorithm>
 
 //------------------------------------------------------------------------------------
 // Particle System Module Data (Static - internal to this file)
 //------------------------------------------------------------------------------------
-const int MAX_PARTICLES = 500;
-static std::vector<Particle> particles(MAX_PARTICLES);
-static int nextParticleIndex = 0;
+// SoA buffers, all the same length (capacity); only [0, liveCount) holds particles
+static std::vector<float> positionsX, positionsY, positionsZ;
+static std::vector<float> velocitiesX, velocitiesY, velocitiesZ;
+static std::vector<float> lifeTimes; // Seconds left
+static std::vector<float> lifeSpans; // Seconds at emission (for fading by remaining life)
+static std::vector<Color> colors;
+
+static int liveCount = 0;
+static int initialCapacity = PARTICLE_DEFAULT_CAPACITY;
+static int maxCapacity = PARTICLE_DEFAULT_MAX_CAPACITY;
+static int peakCount = 0;
+static int droppedCount = 0;
+
+const float PARTICLE_SIZE = 0.1f;     // Quad edge in world units (the old sphere's diameter)
+const int PARTICLE_DRAW_CHUNK = 1024; // Quads checked against the rlgl batch limit at a time
 
 //------------------------------------------------------------------------------------
-// Particle System Functions - Implementation
+// Particle System Helpers
 //------------------------------------------------------------------------------------
 
-void InitializeParticles()
+static void ResizeBuffers(int capacity)
+{
+    positionsX.resize(capacity);
+    positionsY.resize(capacity);
+    positionsZ.resize(capacity);
+    velocitiesX.resize(capacity);
+    velocitiesY.resize(capacity);
+    velocitiesZ.resize(capacity);
+    lifeTimes.resize(capacity);
+    lifeSpans.resize(capacity);
+    colors.resize(capacity);
+}
+
+// Make room for count more particles (doubling, never past maxCapacity), returns how many fit
+static int ReserveParticles(int count)
 {
-    for (int i = 0; i < MAX_PARTICLES; ++i) {
-        particles[i].isActive = false;
+    int capacity = (int)lifeTimes.size();
+    int needed = liveCount + count;
+    if (needed > capacity && capacity < maxCapacity) {
+        int newCapacity = std::max(capacity, 1);
+        while (newCapacity < needed && newCapacity < maxCapacity) newCapacity *= 2;
+        newCapacity = std::min(newCapacity, maxCapacity);
+        ResizeBuffers(newCapacity);
+        TraceLog(LOG_INFO, "PARTICLES: Pool grown to %d particles", newCapacity);
+        capacity = newCapacity;
     }
-    nextParticleIndex = 0;
+    return std::min(count, capacity - liveCount);
+}
+
+// Move the last live particle into slot i (i is dead)
+static void SwapRemove(int i)
+{
+    int last = --liveCount;
+    positionsX[i] = positionsX[last];
+    positionsY[i] = positionsY[last];
+    positionsZ[i] = positionsZ[last];
+    velocitiesX[i] = velocitiesX[last];
+    velocitiesY[i] = velocitiesY[last];
+    velocitiesZ[i] = velocitiesZ[last];
+    lifeTimes[i] = lifeTimes[last];
+    lifeSpans[i] = lifeSpans[last];
+    colors[i] = colors[last];
+}
+
+//------------------------------------------------------------------------------------
+// Particle System Functions - Implementation
+//------------------------------------------------------------------------------------
+
+void InitializeParticles(int newInitialCapacity, int newMaxCapacity)
+{
+    if (newMaxCapacity > 0) maxCapacity = newMaxCapacity;
+    if (newInitialCapacity > 0) initialCapacity = newInitialCapacity;
+    initialCapacity = std::min(initialCapacity, maxCapacity);
+    if ((int)lifeTimes.size() < initialCapacity) ResizeBuffers(initialCapacity);
+
+    liveCount = 0;
+    peakCount = 0;
+    droppedCount = 0;
 }
 
 void UpdateParticles(float deltaTime)
 {
-    for (int i = 0; i < MAX_PARTICLES; ++i) {
-        if (particles[i].isActive) {
-            particles[i].lifeTime -= deltaTime;
-            if (particles[i].lifeTime <= 0.0f) {
-                particles[i].isActive = false;
-            } else {
-                particles[i].position = Vector3Add(particles[i].position, Vector3Scale(particles[i].velocity, deltaTime));
-                // Optional: Add fade, gravity etc. here
-            }
-        }
+    // Branch-free integration over the live range only (each loop streams a couple of arrays)
+    float *px = positionsX.data(), *py = positionsY.data(), *pz = positionsZ.data();
+    const float *vx = velocitiesX.data(), *vy = velocitiesY.data(), *vz = velocitiesZ.data();
+    float *life = lifeTimes.data();
+    for (int i = 0; i < liveCount; ++i) px[i] += vx[i] * deltaTime;
+    for (int i = 0; i < liveCount; ++i) py[i] += vy[i] * deltaTime;
+    for (int i = 0; i < liveCount; ++i) pz[i] += vz[i] * deltaTime;
+    for (int i = 0; i < liveCount; ++i) life[i] -= deltaTime;
+
+    // Compact: expired particles are replaced by the last live one (order is not kept)
+    for (int i = 0; i < liveCount;) {
+        if (life[i] <= 0.0f) SwapRemove(i); // Re-check slot i, it now holds the moved particle
+        else ++i;
     }
 }
 
 void DrawParticles()
 {
-     // Assumes BeginMode3D has been called
-    for (int i = 0; i < MAX_PARTICLES; ++i) {
-        if (particles[i].isActive) {
-            // Draw particles as small spheres
-            DrawSphere(particles[i].position, 0.05f, particles[i].color);
-            // Or use DrawPoint3D(particles[i].position, particles[i].color);
+    // Assumes BeginMode3D has been called: the quads face the camera of the current view matrix
+    if (liveCount == 0) return;
+    Matrix view = rlGetMatrixModelview();
+    float halfSize = 0.5f * PARTICLE_SIZE;
+    Vector3 right = {view.m0 * halfSize, view.m4 * halfSize, view.m8 * halfSize};
+    Vector3 up = {view.m1 * halfSize, view.m5 * halfSize, view.m9 * halfSize};
+
+    // All live particles go into the rlgl batch as quads (one draw call unless the batch fills up)
+    for (int begin = 0; begin < liveCount; begin += PARTICLE_DRAW_CHUNK) {
+        int end = std::min(begin + PARTICLE_DRAW_CHUNK, liveCount);
+        rlCheckRenderBatchLimit(4 * (end - begin)); // Flush first if the chunk would not fit
+        rlSetTexture(rlGetTextureIdDefault());
+        rlBegin(RL_QUADS);
+        for (int i = begin; i < end; ++i) {
+            // Fade out over the remaining lifetime
+            float fade = (lifeSpans[i] > 0.0f) ? Clamp(lifeTimes[i] / lifeSpans[i], 0.0f, 1.0f) : 0.0f;
+            rlColor4ub(colors[i].r, colors[i].g, colors[i].b, (unsigned char)(colors[i].a * fade));
+
+            float x = positionsX[i], y = positionsY[i], z = positionsZ[i];
+            // Counter-clockwise as seen from the camera (bottom-left, bottom-right, top-right, top-left)
+            rlVertex3f(x - right.x - up.x, y - right.y - up.y, z - right.z - up.z);
+            rlVertex3f(x + right.x - up.x, y + right.y - up.y, z + right.z - up.z);
+            rlVertex3f(x + right.x + up.x, y + right.y + up.y, z + right.z + up.z);
+            rlVertex3f(x - right.x + up.x, y - right.y + up.y, z - right.z + up.z);
         }
+        rlEnd();
+        rlSetTexture(0);
     }
 }
 
-void EmitParticles(Vector3 position, int count, float speed, float duration, Color color)
+void EmitParticles(Vector3 position, int count, float speed, float duration, Color color, Rng &rng)
 {
-     for (int i = 0; i < count; ++i) {
-        int pIndex = nextParticleIndex;
-        particles[pIndex].isActive = true;
-        particles[pIndex].position = position;
-        particles[pIndex].color = color;
-        // Use GetRandomFloat if available, otherwise basic rand
-        particles[pIndex].lifeTime = duration * (0.5f + (float)(rand() % 100) / 100.0f); // Vary lifetime 0.5x to 1.5x
-        // particles[pIndex].lifeTime = duration * GetRandomFloat(0.5f, 1.5f);
+    int emitted = ReserveParticles(count);
+    droppedCount += count - emitted;
 
+    for (int n = 0; n < emitted; ++n) {
+        int pIndex = liveCount++;
+        positionsX[pIndex] = position.x;
+        positionsY[pIndex] = position.y;
+        positionsZ[pIndex] = position.z;
+        colors[pIndex] = color;
+        lifeTimes[pIndex] = duration * rng.Range(0.5f, 1.5f); // Vary lifetime 0.5x to 1.5x
+        lifeSpans[pIndex] = lifeTimes[pIndex];
 
-        Vector3 velocity = { GetRandomFloat(-1.0f, 1.0f), GetRandomFloat(-1.0f, 1.0f), GetRandomFloat(-1.0f, 1.0f) };
+        Vector3 velocity;
+        rng.FillFloats(&velocity.x, 3, -1.0f, 1.0f);
         if (Vector3LengthSqr(velocity) < 0.001f) velocity = {1.0f, 0.0f, 0.0f}; // Default if random is zero
-        // Use GetRandomFloat if available, otherwise basic rand
-        float speedVariation = 0.5f + (float)(rand() % 100) / 100.0f; // Vary speed 0.5x to 1.5x
-        // float speedVariation = GetRandomFloat(0.5f, 1.5f);
-        particles[pIndex].velocity = Vector3Scale(Vector3Normalize(velocity), speed * speedVariation);
-
-        nextParticleIndex++;
-        if (nextParticleIndex >= MAX_PARTICLES) nextParticleIndex = 0; // Wrap around pool
+        float speedVariation = rng.Range(0.5f, 1.5f); // Vary speed 0.5x to 1.5x
+        velocity = Vector3Scale(Vector3Normalize(velocity), speed * speedVariation);
+        velocitiesX[pIndex] = velocity.x;
+        velocitiesY[pIndex] = velocity.y;
+        velocitiesZ[pIndex] = velocity.z;
     }
+    peakCount = std::max(peakCount, liveCount);
 }
 
+ParticleStats GetParticleStats()
+{
+    ParticleStats stats;
+    stats.live = liveCount;
+    stats.capacity = (int)lifeTimes.size();
+    stats.peak = peakCount;
+    stats.dropped = droppedCount;
+    stats.memoryBytes = (positionsX.capacity() + positionsY.capacity() + positionsZ.capacity() + velocitiesX.capacity() +
+                         velocitiesY.capacity() + velocitiesZ.capacity() + lifeTimes.capacity() + lifeSpans.capacity()) * sizeof(float) +
+                        colors.capacity() * sizeof(Color);
+    return stats;
+}
@@ -3,33 +3,45 @@
 
 #include "raylib.h"
 #include <vector>
+#include "rng.h"
 
 //------------------------------------------------------------------------------------
-// Structure Definition for Particles
+// Particle Pool Configuration
 //------------------------------------------------------------------------------------
+// Particles live in structure-of-arrays buffers with every live particle packed at the front
+// ([0, live)); a dying particle is replaced by the last live one. The buffers start at the
+// initial capacity and double on demand up to the max capacity, after which bursts drop
+// the particles that do not fit (see ParticleStats::dropped).
+constexpr int PARTICLE_DEFAULT_CAPACITY = 1024;
+constexpr int PARTICLE_DEFAULT_MAX_CAPACITY = 65536;
+
+// Pool counters (dropped and peak accumulate until the next InitializeParticles)
 typedef struct {
-    Vector3 position;
-    Vector3 velocity;
-    Color color;
-    float lifeTime;
-    bool isActive;
-} Particle;
+    int live;           // Particles currently alive
+    int capacity;       // Allocated slots
+    int peak;           // Highest live count
+    int dropped;        // Particles not emitted because the pool was at max capacity
+    size_t memoryBytes; // Bytes held by the particle buffers (all allocated slots)
+} ParticleStats;
 
 //------------------------------------------------------------------------------------
 // Particle System Functions - Declaration
 //------------------------------------------------------------------------------------
 
-// Initializes the particle pool
-void InitializeParticles();
+// Kills all particles and resets the counters. Capacities <= 0 keep the current setting;
+// allocated buffers are kept (they only grow).
+void InitializeParticles(int initialCapacity = 0, int maxCapacity = 0);
 
-// Updates positions and lifetimes of active particles
+// Updates positions and lifetimes of live particles, compacting out the ones that expired
 void UpdateParticles(float deltaTime);
 
-// Draws active particles
+// Draws live particles as camera-facing quads in one rlgl batch, fading out with their remaining lifetime
 void DrawParticles();
 
-// Emits a burst of particles from a position
-void EmitParticles(Vector3 position, int count, float speed, float duration, Color color);
+// Emits a burst of particles from a position (lifetimes and directions drawn from rng)
+void EmitParticles(Vector3 position, int count, float speed, float duration, Color color, Rng &rng);
+
+ParticleStats GetParticleStats();
 
 
 #endif // PARTICLE_SYSTEM_H
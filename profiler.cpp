@@ -0,0 +1,196 @@
+#include "profiler.h"
+#include <cstdio>
+
+//------------------------------------------------------------------------------------
+// Profiler Module Data (Static - internal to this file)
+//------------------------------------------------------------------------------------
+typedef struct
+{
+    double start; // Seconds (GetTime)
+    double end;
+    unsigned char zone;
+} ProfileEvent;
+
+static const char *zoneNames[PROFILE_ZONE_COUNT] = {
+    "Frame",
+    "Camera Update",
+    "Particle Update",
+    "Player Collision",
+    "Raycast",
+    "Color Reset",
+    "Rotation Update",
+    "Culling",
+    "Occlusion",
+    "Asteroid Draw",
+    "Particle Draw",
+    "Background Draw",
+    "Sector Streaming",
+    "UI",
+};
+
+static double zoneStart[PROFILE_ZONE_COUNT];
+static double zoneFrameTime[PROFILE_ZONE_COUNT];                         // Seconds accumulated this frame
+static float zoneHistory[PROFILE_ZONE_COUNT][PROFILER_HISTORY_FRAMES]; // Milliseconds per frame
+static int historyHead = 0;                                              // Next history slot to write
+static int historyCount = 0;
+
+static ProfileEvent events[PROFILER_MAX_EVENTS];
+static int eventHead = 0; // Next event slot to write (oldest events are overwritten)
+static int eventCount = 0;
+static double traceOrigin = 0.0;
+
+//------------------------------------------------------------------------------------
+// Profiler Functions - Implementation
+//------------------------------------------------------------------------------------
+
+void InitializeProfiler()
+{
+    for (int z = 0; z < PROFILE_ZONE_COUNT; ++z)
+    {
+        zoneStart[z] = 0.0;
+        zoneFrameTime[z] = 0.0;
+        for (int i = 0; i < PROFILER_HISTORY_FRAMES; ++i)
+            zoneHistory[z][i] = 0.0f;
+    }
+    historyHead = 0;
+    historyCount = 0;
+    eventHead = 0;
+    eventCount = 0;
+    traceOrigin = GetTime();
+}
+
+void ProfilerBeginFrame()
+{
+    ProfilerBeginZone(PROFILE_ZONE_FRAME);
+}
+
+void ProfilerEndFrame()
+{
+    ProfilerEndZone(PROFILE_ZONE_FRAME);
+
+    for (int z = 0; z < PROFILE_ZONE_COUNT; ++z)
+    {
+        zoneHistory[z][historyHead] = (float)(zoneFrameTime[z] * 1000.0);
+        zoneFrameTime[z] = 0.0;
+    }
+    historyHead = (historyHead + 1) % PROFILER_HISTORY_FRAMES;
+    if (historyCount < PROFILER_HISTORY_FRAMES)
+        historyCount++;
+}
+
+void ProfilerBeginZone(ProfileZone zone)
+{
+    zoneStart[zone] = GetTime();
+}
+
+void ProfilerEndZone(ProfileZone zone)
+{
+    double end = GetTime();
+    zoneFrameTime[zone] += end - zoneStart[zone];
+
+    ProfileEvent &event = events[eventHead];
+    event.start = zoneStart[zone];
+    event.end = end;
+    event.zone = (unsigned char)zone;
+    eventHead = (eventHead + 1) % PROFILER_MAX_EVENTS;
+    if (eventCount < PROFILER_MAX_EVENTS)
+        eventCount++;
+}
+
+float GetProfilerZoneAverage(ProfileZone zone)
+{
+    if (historyCount == 0)
+        return 0.0f;
+    float sum = 0.0f;
+    for (int i = 0; i < historyCount; ++i)
+        sum += zoneHistory[zone][i];
+    return sum / (float)historyCount;
+}
+
+float GetProfilerZoneMax(ProfileZone zone)
+{
+    float maxTime = 0.0f;
+    for (int i = 0; i < historyCount; ++i)
+    {
+        if (zoneHistory[zone][i] > maxTime)
+            maxTime = zoneHistory[zone][i];
+    }
+    return maxTime;
+}
+
+const char *GetProfilerZoneName(ProfileZone zone)
+{
+    return (zone >= 0 && zone < PROFILE_ZONE_COUNT) ? zoneNames[zone] : "Unknown";
+}
+
+void DrawProfilerOverlay(int posX, int posY)
+{
+    const int fontSize = 10;
+    const int rowHeight = 12;
+    const int panelWidth = 300;
+    const int graphHeight = 60;
+    const float graphMaxMs = 50.0f; // Graph top
+    int panelHeight = 20 + PROFILE_ZONE_COUNT * rowHeight + graphHeight + 10;
+
+    DrawRectangle(posX, posY, panelWidth, panelHeight, Fade(BLACK, 0.7f));
+    DrawText("Zone", posX + 6, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("avg ms", posX + 150, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("max ms", posX + 210, posY + 4, fontSize, LIGHTGRAY);
+
+    // Per-zone table, bar shows the average share of the frame
+    float frameAverage = GetProfilerZoneAverage(PROFILE_ZONE_FRAME);
+    for (int z = 0; z < PROFILE_ZONE_COUNT; ++z)
+    {
+        int rowY = posY + 18 + z * rowHeight;
+        float average = GetProfilerZoneAverage((ProfileZone)z);
+        if (frameAverage > 0.0f)
+            DrawRectangle(posX + 4, rowY, (int)(140.0f * average / frameAverage), rowHeight - 2, Fade(SKYBLUE, 0.35f));
+        DrawText(zoneNames[z], posX + 6, rowY + 1, fontSize, RAYWHITE);
+        DrawText(TextFormat("%6.2f", average), posX + 150, rowY + 1, fontSize, RAYWHITE);
+        DrawText(TextFormat("%6.2f", GetProfilerZoneMax((ProfileZone)z)), posX + 210, rowY + 1, fontSize, RAYWHITE);
+    }
+
+    // Rolling frame-time graph (oldest on the left), with 60 and 30 FPS reference lines
+    int graphX = posX + 4;
+    int graphY = posY + 22 + PROFILE_ZONE_COUNT * rowHeight;
+    int graphWidth = panelWidth - 8;
+    DrawRectangleLines(graphX, graphY, graphWidth, graphHeight, DARKGRAY);
+    int line60 = graphY + graphHeight - (int)(graphHeight * 16.67f / graphMaxMs);
+    int line30 = graphY + graphHeight - (int)(graphHeight * 33.33f / graphMaxMs);
+    DrawLine(graphX, line60, graphX + graphWidth, line60, Fade(GREEN, 0.5f));
+    DrawLine(graphX, line30, graphX + graphWidth, line30, Fade(RED, 0.5f));
+
+    for (int i = 0; i < historyCount; ++i)
+    {
+        int slot = (historyHead - historyCount + i + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES;
+        float frameMs = zoneHistory[PROFILE_ZONE_FRAME][slot];
+        int barHeight = (int)(graphHeight * (frameMs < graphMaxMs ? frameMs : graphMaxMs) / graphMaxMs);
+        int x = graphX + (i * graphWidth) / PROFILER_HISTORY_FRAMES;
+        DrawLine(x, graphY + graphHeight, x, graphY + graphHeight - barHeight, (frameMs > 16.67f) ? ORANGE : LIME);
+    }
+}
+
+bool SaveProfilerTrace(const char *fileName)
+{
+    FILE *file = fopen(fileName, "w");
+    if (file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "PROFILER: Failed to open trace file %s", fileName);
+        return false;
+    }
+
+    // Complete ("X") events in microseconds, oldest first
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (int i = 0; i < eventCount; ++i)
+    {
+        const ProfileEvent &event = events[(eventHead - eventCount + i + PROFILER_MAX_EVENTS) % PROFILER_MAX_EVENTS];
+        fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0}",
+                (i > 0) ? ",\n" : "", zoneNames[event.zone],
+                (event.start - traceOrigin) * 1000000.0, (event.end - event.start) * 1000000.0);
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+
+    TraceLog(LOG_INFO, "PROFILER: Saved %d events to %s", eventCount, fileName);
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "raylib.h"
+
+//------------------------------------------------------------------------------------
+// Frame Profiler
+//------------------------------------------------------------------------------------
+// Scoped wall-clock timers for the main phases of a frame. Zones are recorded on the
+// main thread only, into fixed-size arrays and ring buffers (no allocations while
+// profiling). Per-zone history feeds the overlay, the event ring feeds the trace dump.
+typedef enum
+{
+    PROFILE_ZONE_FRAME = 0, // Whole frame, recorded by ProfilerBeginFrame/ProfilerEndFrame
+    PROFILE_ZONE_CAMERA_UPDATE,
+    PROFILE_ZONE_PARTICLE_UPDATE,
+    PROFILE_ZONE_PLAYER_COLLISION,
+    PROFILE_ZONE_RAYCAST,
+    PROFILE_ZONE_COLOR_RESET,
+    PROFILE_ZONE_ROTATION_UPDATE,
+    PROFILE_ZONE_CULLING,
+    PROFILE_ZONE_OCCLUSION,
+    PROFILE_ZONE_ASTEROID_DRAW,
+    PROFILE_ZONE_PARTICLE_DRAW,
+    PROFILE_ZONE_BACKGROUND_DRAW,
+    PROFILE_ZONE_SECTOR_STREAMING,
+    PROFILE_ZONE_UI,
+    PROFILE_ZONE_COUNT
+} ProfileZone;
+
+constexpr int PROFILER_HISTORY_FRAMES = 240; // Frames kept for averages, maxima and the graph
+constexpr int PROFILER_MAX_EVENTS = 16384;   // Zone events kept for the trace dump
+
+//------------------------------------------------------------------------------------
+// Profiler Functions - Declaration
+//------------------------------------------------------------------------------------
+
+// Resets all history and events
+void InitializeProfiler();
+
+// Frame boundaries (call once per frame, around everything else)
+void ProfilerBeginFrame();
+void ProfilerEndFrame();
+
+// Zone boundaries (prefer PROFILE_SCOPE, zones must not nest with themselves)
+void ProfilerBeginZone(ProfileZone zone);
+void ProfilerEndZone(ProfileZone zone);
+
+// Average and maximum milliseconds per frame of a zone over the history window
+float GetProfilerZoneAverage(ProfileZone zone);
+float GetProfilerZoneMax(ProfileZone zone);
+const char *GetProfilerZoneName(ProfileZone zone);
+
+// Per-zone avg/max table plus a rolling frame-time graph
+void DrawProfilerOverlay(int posX, int posY);
+
+// Write the recorded events as Chrome trace JSON (chrome://tracing, Perfetto)
+bool SaveProfilerTrace(const char *fileName);
+
+//------------------------------------------------------------------------------------
+// RAII Zone Helper
+//------------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileZone zone) : zone(zone) { ProfilerBeginZone(zone); }
+    ~ProfileScope() { ProfilerEndZone(zone); }
+
+private:
+    ProfileZone zone;
+};
+
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_SCOPE_CONCAT(profileScope, __LINE__)(zone)
+
+#endif // PROFILER_H
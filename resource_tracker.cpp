@@ -0,0 +1,172 @@
+#include "resource_tracker.h"
+
+//------------------------------------------------------------------------------------
+// Resource Tracker Module Data (Static - internal to this file)
+//------------------------------------------------------------------------------------
+typedef struct
+{
+    const char *name;
+    bool gpu;
+} ResourceCategoryInfo;
+
+static const ResourceCategoryInfo categoryInfo[RESOURCE_CATEGORY_COUNT] = {
+    {"Mesh arrays", false},
+    {"Mesh buffers", true},
+    {"Instance data", true},
+    {"Background targets", true},
+    {"Asteroid store", false},
+    {"Spatial index", false},
+    {"Renderer", false},
+    {"Particles", false},
+    {"Stars", false},
+    {"Frame arena", false},
+};
+
+static size_t categoryBytes[RESOURCE_CATEGORY_COUNT];
+static size_t categoryPeak[RESOURCE_CATEGORY_COUNT];
+static size_t totals[2]; // [0] CPU, [1] GPU
+static size_t totalPeaks[2];
+static long long frameAllocations = -1; // Last frame, -1 when not tracked
+static long long peakAllocations = -1;
+static int trackedFrames = 0;
+
+// Bytes as KB below 1 MB, else MB (TextFormat only keeps a few buffers, so one value per call)
+static const char *FormatBytes(size_t bytes)
+{
+    if (bytes < 1024 * 1024)
+        return TextFormat("%7.1f KB", bytes / 1024.0);
+    return TextFormat("%7.2f MB", bytes / (1024.0 * 1024.0));
+}
+
+//------------------------------------------------------------------------------------
+// Resource Tracker Functions - Implementation
+//------------------------------------------------------------------------------------
+
+void InitializeResourceTracker()
+{
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; ++c)
+    {
+        categoryBytes[c] = 0;
+        categoryPeak[c] = 0;
+    }
+    totals[0] = totals[1] = 0;
+    totalPeaks[0] = totalPeaks[1] = 0;
+    frameAllocations = -1;
+    peakAllocations = -1;
+    trackedFrames = 0;
+}
+
+void SetResourceBytes(ResourceCategory category, size_t bytes)
+{
+    categoryBytes[category] = bytes;
+    if (bytes > categoryPeak[category])
+        categoryPeak[category] = bytes;
+}
+
+void ResourceTrackerEndFrame(long long heapAllocations)
+{
+    totals[0] = totals[1] = 0;
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; ++c)
+        totals[categoryInfo[c].gpu ? 1 : 0] += categoryBytes[c];
+    for (int g = 0; g < 2; ++g)
+    {
+        if (totals[g] > totalPeaks[g])
+            totalPeaks[g] = totals[g];
+    }
+
+    // -1 (untracked) never becomes the peak, and the first counted frame also holds everything
+    // allocated during initialization, so it is left out of the peak too
+    frameAllocations = heapAllocations;
+    if (heapAllocations < 0)
+        return;
+    if (trackedFrames > 0 && heapAllocations > peakAllocations)
+        peakAllocations = heapAllocations;
+    trackedFrames++;
+}
+
+size_t GetResourceBytes(ResourceCategory category)
+{
+    return categoryBytes[category];
+}
+
+size_t GetResourcePeak(ResourceCategory category)
+{
+    return categoryPeak[category];
+}
+
+bool IsGpuResource(ResourceCategory category)
+{
+    return categoryInfo[category].gpu;
+}
+
+const char *GetResourceCategoryName(ResourceCategory category)
+{
+    return categoryInfo[category].name;
+}
+
+size_t GetResourceTotal(bool gpu)
+{
+    return totals[gpu ? 1 : 0];
+}
+
+size_t GetResourceTotalPeak(bool gpu)
+{
+    return totalPeaks[gpu ? 1 : 0];
+}
+
+void DrawResourceOverlay(int posX, int posY)
+{
+    const int fontSize = 10;
+    const int rowHeight = 12;
+    const int panelWidth = 300;
+    int panelHeight = 20 + (RESOURCE_CATEGORY_COUNT + 3) * rowHeight + 10;
+
+    DrawRectangle(posX, posY, panelWidth, panelHeight, Fade(BLACK, 0.7f));
+    DrawText("Resource", posX + 6, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("current", posX + 140, posY + 4, fontSize, LIGHTGRAY);
+    DrawText("peak", posX + 220, posY + 4, fontSize, LIGHTGRAY);
+
+    // GPU rows in orange, so the VRAM share stands out
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; ++c)
+    {
+        int rowY = posY + 18 + c * rowHeight;
+        Color color = categoryInfo[c].gpu ? ORANGE : RAYWHITE;
+        DrawText(TextFormat("%s%s", categoryInfo[c].name, categoryInfo[c].gpu ? " (GPU)" : ""), posX + 6, rowY + 1, fontSize, color);
+        DrawText(FormatBytes(categoryBytes[c]), posX + 140, rowY + 1, fontSize, color);
+        DrawText(FormatBytes(categoryPeak[c]), posX + 220, rowY + 1, fontSize, color);
+    }
+
+    int totalsY = posY + 22 + RESOURCE_CATEGORY_COUNT * rowHeight;
+    DrawLine(posX + 4, totalsY - 2, posX + panelWidth - 4, totalsY - 2, DARKGRAY);
+    for (int g = 0; g < 2; ++g)
+    {
+        int rowY = totalsY + g * rowHeight;
+        DrawText(g ? "Total GPU (estimate)" : "Total CPU", posX + 6, rowY + 1, fontSize, YELLOW);
+        DrawText(FormatBytes(totals[g]), posX + 140, rowY + 1, fontSize, YELLOW);
+        DrawText(FormatBytes(totalPeaks[g]), posX + 220, rowY + 1, fontSize, YELLOW);
+    }
+    int allocationsY = totalsY + 2 * rowHeight;
+    DrawText("Heap allocs/frame", posX + 6, allocationsY + 1, fontSize, YELLOW);
+    if (frameAllocations >= 0)
+    {
+        DrawText(TextFormat("%10lld", frameAllocations), posX + 140, allocationsY + 1, fontSize, YELLOW);
+        DrawText(TextFormat("%10lld", (peakAllocations >= 0) ? peakAllocations : frameAllocations), posX + 220, allocationsY + 1, fontSize, YELLOW);
+    }
+    else
+        DrawText("n/a", posX + 140, allocationsY + 1, fontSize, GRAY);
+}
+
+void LogResourceUsage()
+{
+    TraceLog(LOG_INFO, "RESOURCES: %-20s %12s %12s", "category", "current KB", "peak KB");
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; ++c)
+        TraceLog(LOG_INFO, "RESOURCES: %-20s %12.1f %12.1f%s", categoryInfo[c].name, categoryBytes[c] / 1024.0,
+                 categoryPeak[c] / 1024.0, categoryInfo[c].gpu ? " (GPU)" : "");
+    TraceLog(LOG_INFO, "RESOURCES: %-20s %12.1f %12.1f", "total CPU", totals[0] / 1024.0, totalPeaks[0] / 1024.0);
+    TraceLog(LOG_INFO, "RESOURCES: %-20s %12.1f %12.1f", "total GPU (estimate)", totals[1] / 1024.0, totalPeaks[1] / 1024.0);
+    if (trackedFrames > 0)
+        TraceLog(LOG_INFO, "RESOURCES: heap allocations per frame: %lld last, %lld peak over %d frames", frameAllocations,
+                 (peakAllocations >= 0) ? peakAllocations : frameAllocations, trackedFrames);
+    else
+        TraceLog(LOG_INFO, "RESOURCES: heap allocations not tracked (build with TRACK_HEAP_ALLOCATIONS)");
+}
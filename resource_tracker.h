@@ -0,0 +1,57 @@
+#ifndef RESOURCE_TRACKER_H
+#define RESOURCE_TRACKER_H
+
+#include "raylib.h"
+#include <cstddef>
+
+//------------------------------------------------------------------------------------
+// Resource Accounting
+//------------------------------------------------------------------------------------
+// Bytes held per category of long-lived CPU and GPU resources. The owners are sampled once a
+// frame (SetResourceBytes with what their memory queries report), and the tracker keeps the
+// peak of every category, of the CPU and GPU totals and of the heap allocations per frame.
+// GPU figures are estimates from buffer and texture sizes: drivers add alignment, mip chains
+// and their own copies on top, so read them as a lower bound of the VRAM in use.
+typedef enum
+{
+    RESOURCE_MESH_CPU = 0,   // Pool mesh vertex and index arrays (heap or mapped cache file)
+    RESOURCE_MESH_GPU,       // Pool mesh vertex and index buffers
+    RESOURCE_INSTANCE_GPU,   // Instance texture, instance index buffer and impostor texture
+    RESOURCE_BACKGROUND_GPU, // Baked background render targets
+    RESOURCE_ASTEROIDS,      // AsteroidStore arrays
+    RESOURCE_SPATIAL_INDEX,  // Grid cells and BVH nodes, with their per-instance records
+    RESOURCE_RENDERER,       // Renderer's CPU copy of the instance table and heap buckets
+    RESOURCE_PARTICLES,      // Particle pool buffers
+    RESOURCE_STARS,          // Background star lists
+    RESOURCE_FRAME_ARENA,    // Frame arena blocks
+    RESOURCE_CATEGORY_COUNT
+} ResourceCategory;
+
+//------------------------------------------------------------------------------------
+// Resource Tracker Functions - Declaration
+//------------------------------------------------------------------------------------
+
+// Resets all counts and peaks
+void InitializeResourceTracker();
+
+// Current bytes of a category (replaces the previous sample)
+void SetResourceBytes(ResourceCategory category, size_t bytes);
+// Close the frame: totals and peaks are updated. heapAllocations is the frame's operator new
+// count, -1 when the build does not track them.
+void ResourceTrackerEndFrame(long long heapAllocations);
+
+size_t GetResourceBytes(ResourceCategory category);
+size_t GetResourcePeak(ResourceCategory category);
+bool IsGpuResource(ResourceCategory category);
+const char *GetResourceCategoryName(ResourceCategory category);
+// Sum over the CPU or the GPU categories, as of the last ResourceTrackerEndFrame
+size_t GetResourceTotal(bool gpu);
+size_t GetResourceTotalPeak(bool gpu);
+
+// Per-category current/peak table with the totals and heap allocations per frame
+void DrawResourceOverlay(int posX, int posY);
+
+// Same table through TraceLog (on exit)
+void LogResourceUsage();
+
+#endif // RESOURCE_TRACKER_H
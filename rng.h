@@ -0,0 +1,101 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <cstddef>
+
+//------------------------------------------------------------------------------------
+// Random Number Streams
+//------------------------------------------------------------------------------------
+// Every subsystem (and every worker thread) owns its own generator, seeded explicitly
+// from one game seed plus a stream id, so results do not depend on call order across
+// subsystems and the same seed always reproduces the same field.
+typedef enum
+{
+    RNG_STREAM_MESHES = 0, // Asteroid mesh variant shapes
+    RNG_STREAM_FIELD,      // Asteroid placement and properties
+    RNG_STREAM_STARS,      // Background starfield
+    RNG_STREAM_PARTICLES,  // Particle bursts
+    RNG_STREAM_EFFECTS,    // Per-frame visual effects (hit shake)
+    RNG_STREAM_COUNT
+} RngStream;
+
+//------------------------------------------------------------------------------------
+// Rng Class (xoshiro128**, seeded through SplitMix64)
+//------------------------------------------------------------------------------------
+// 16 bytes of state, a handful of shifts and multiplies per number. Not thread-safe:
+// give each thread its own instance (see the stream constructor).
+class Rng
+{
+public:
+    explicit Rng(uint64_t seed = 0) { Seed(seed); }
+    Rng(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+    void Seed(uint64_t seed)
+    {
+        uint64_t a = SplitMix64(seed);
+        uint64_t b = SplitMix64(seed);
+        state[0] = (uint32_t)a;
+        state[1] = (uint32_t)(a >> 32);
+        state[2] = (uint32_t)b;
+        state[3] = (uint32_t)(b >> 32);
+        if ((state[0] | state[1] | state[2] | state[3]) == 0)
+            state[0] = 1; // The all-zero state never leaves zero
+    }
+
+    // Independent stream derived from a base seed (e.g. game seed + RngStream, or + thread index)
+    void Seed(uint64_t seed, uint64_t stream) { Seed(seed ^ (0x9E3779B97F4A7C15ull * (stream + 1))); }
+
+    uint64_t NextUInt64()
+    {
+        uint64_t high = NextUInt();
+        return (high << 32) | NextUInt();
+    }
+
+    uint32_t NextUInt()
+    {
+        uint32_t result = RotateLeft(state[1] * 5, 7) * 9;
+        uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = RotateLeft(state[3], 11);
+        return result;
+    }
+
+    // Uniform float in [0, 1) (top 24 bits, every value exactly representable)
+    float NextFloat() { return (float)(NextUInt() >> 8) * (1.0f / 16777216.0f); }
+
+    // Uniform float in [min, max)
+    float Range(float min, float max) { return (max <= min) ? min : min + (max - min) * NextFloat(); }
+
+    // Uniform integer in [0, bound) (bound > 0), multiply-shift instead of a modulo
+    int NextInt(int bound) { return (int)(((uint64_t)NextUInt() * (uint64_t)bound) >> 32); }
+
+    bool NextBool() { return (NextUInt() & 0x80000000u) != 0; }
+
+    // Batch helpers: fill count floats in [min, max)
+    void FillFloats(float *out, size_t count, float min, float max)
+    {
+        float scale = (max > min) ? (max - min) * (1.0f / 16777216.0f) : 0.0f;
+        for (size_t i = 0; i < count; ++i)
+            out[i] = min + (float)(NextUInt() >> 8) * scale;
+    }
+
+private:
+    uint32_t state[4];
+
+    static uint32_t RotateLeft(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    static uint64_t SplitMix64(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif // RNG_H
@@ -0,0 +1,324 @@
+#include "sector_streamer.h"
+#include <algorithm> // For std::sort
+#include <cmath>     // For floorf
+#include <cstdlib>   // For std::abs
+
+//------------------------------------------------------------------------------------
+// SectorStreamer Class - Implementation
+//------------------------------------------------------------------------------------
+
+// Constructor
+SectorStreamer::SectorStreamer(uint64_t seed, const FieldConfig &fieldConfig, const AsteroidMeshPool &pool, AsteroidStore &store,
+                               UniformGrid &collisionGrid, int radius, int maxResidentSectors)
+    : fieldSeed(seed), config(fieldConfig), meshPool(pool), asteroids(store), grid(collisionGrid), loadRadius(radius > 0 ? radius : 1),
+      centerSector{0, 0, 0}, hasCenter(false), stats{0}, stopping(false)
+{
+    using namespace AsteroidFieldConstants;
+
+    int slotCount = (maxResidentSectors > 0) ? maxResidentSectors : 1;
+    int side = 2 * loadRadius + 1;
+    if (slotCount < side * side * side)
+        TraceLog(LOG_WARNING, "STREAMER: %d sector slots cannot hold the %d sectors of the load cube", slotCount, side * side * side);
+
+    slots.assign(slotCount, SectorSlot{SECTOR_SLOT_FREE, {0, 0, 0}, 0});
+    freeSlots.reserve(slotCount);
+    for (int s = slotCount - 1; s >= 0; --s)
+        freeSlots.push_back(s); // Popped from the back, so slot 0 goes first
+    sectorSlots.reserve(slotCount * 2);
+    installedSlots.reserve(slotCount);
+
+    asteroids.Clear();
+    asteroids.Resize((size_t)slotCount * SECTOR_MAX_ASTEROIDS); // All inactive until a sector is installed
+
+    TraceLog(LOG_INFO, "STREAMER: %d sector slots of %d asteroids (%.0f units per sector, load radius %d)",
+             slotCount, SECTOR_MAX_ASTEROIDS, SECTOR_SIZE, loadRadius);
+    worker = std::thread(&SectorStreamer::WorkerMain, this);
+}
+
+// Destructor
+SectorStreamer::~SectorStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable())
+        worker.join();
+}
+
+Vector3Int SectorStreamer::GetSectorCoord(Vector3 worldPosition)
+{
+    using namespace AsteroidFieldConstants;
+    return Vector3Int{(int)floorf(worldPosition.x / SECTOR_SIZE), (int)floorf(worldPosition.y / SECTOR_SIZE),
+                      (int)floorf(worldPosition.z / SECTOR_SIZE)};
+}
+
+// 21 bits per axis, plenty for the sectors inside the streamed world box
+long long SectorStreamer::GetSectorKey(Vector3Int coord)
+{
+    const long long mask = (1LL << 21) - 1;
+    return ((long long)coord.x & mask) | (((long long)coord.y & mask) << 21) | (((long long)coord.z & mask) << 42);
+}
+
+int SectorStreamer::GetSectorDistance(Vector3Int a, Vector3Int b)
+{
+    return std::max(std::abs(a.x - b.x), std::max(std::abs(a.y - b.y), std::abs(a.z - b.z)));
+}
+
+// The sector and the scatter that can spill out of it must stay inside the grid bounds
+bool SectorStreamer::IsSectorInWorld(Vector3Int coord) const
+{
+    using namespace AsteroidFieldConstants;
+    float reach = STREAMED_WORLD_EXTENT - config.scatterRadius;
+    return coord.x * SECTOR_SIZE >= -reach && (coord.x + 1) * SECTOR_SIZE <= reach &&
+           coord.y * SECTOR_SIZE >= -reach && (coord.y + 1) * SECTOR_SIZE <= reach &&
+           coord.z * SECTOR_SIZE >= -reach && (coord.z + 1) * SECTOR_SIZE <= reach;
+}
+
+// Load cube around the camera sector, sorted so the closest sectors are requested first
+void SectorStreamer::RebuildWanted()
+{
+    wanted.clear();
+    for (int dz = -loadRadius; dz <= loadRadius; ++dz)
+        for (int dy = -loadRadius; dy <= loadRadius; ++dy)
+            for (int dx = -loadRadius; dx <= loadRadius; ++dx)
+            {
+                Vector3Int coord = {centerSector.x + dx, centerSector.y + dy, centerSector.z + dz};
+                if (IsSectorInWorld(coord))
+                    wanted.push_back(coord);
+            }
+
+    Vector3Int center = centerSector;
+    std::sort(wanted.begin(), wanted.end(), [center](const Vector3Int &a, const Vector3Int &b)
+              {
+        int da = (a.x - center.x) * (a.x - center.x) + (a.y - center.y) * (a.y - center.y) + (a.z - center.z) * (a.z - center.z);
+        int db = (b.x - center.x) * (b.x - center.x) + (b.y - center.y) * (b.y - center.y) + (b.z - center.z) * (b.z - center.z);
+        if (da != db)
+            return da < db;
+        return GetSectorKey(a) < GetSectorKey(b); // Same order every run
+    });
+    stats.wantedSectors = (int)wanted.size();
+}
+
+// A free slot, or the one of the farthest resident sector outside the load cube; -1 if every
+// slot holds a wanted or pending sector
+int SectorStreamer::AcquireSlot()
+{
+    if (freeSlots.empty())
+    {
+        int farthestSlot = -1;
+        int farthestDistance = loadRadius;
+        for (size_t s = 0; s < slots.size(); ++s)
+        {
+            if (slots[s].state != SECTOR_SLOT_RESIDENT)
+                continue;
+            int distance = GetSectorDistance(slots[s].coord, centerSector);
+            if (distance > farthestDistance)
+            {
+                farthestDistance = distance;
+                farthestSlot = (int)s;
+            }
+        }
+        if (farthestSlot < 0)
+            return -1;
+        EvictSlot(farthestSlot);
+    }
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+    return slot;
+}
+
+void SectorStreamer::ReleaseSlot(int slot)
+{
+    sectorSlots.erase(GetSectorKey(slots[slot].coord));
+    slots[slot].state = SECTOR_SLOT_FREE;
+    slots[slot].asteroidCount = 0;
+    freeSlots.push_back(slot);
+}
+
+// Deactivate the slot's asteroids and take them out of the grid (and the attached indexes)
+void SectorStreamer::EvictSlot(int slot)
+{
+    size_t base = (size_t)slot * AsteroidFieldConstants::SECTOR_MAX_ASTEROIDS;
+    for (int i = 0; i < slots[slot].asteroidCount; ++i)
+    {
+        grid.Remove((int)(base + i)); // No-op for asteroids already destroyed
+        for (SpatialIndex *index : extraIndexes)
+            index->Remove((int)(base + i));
+        asteroids.flags[base + i] = 0;
+    }
+    stats.liveAsteroids -= slots[slot].asteroidCount;
+    stats.residentSectors--;
+    stats.sectorsEvicted++;
+    ReleaseSlot(slot);
+}
+
+// Copy a generated sector into its slot and add it to the grid (same bounds as BuildInstanced)
+void SectorStreamer::InstallResult(const SectorResult &result)
+{
+    size_t base = (size_t)result.slot * AsteroidFieldConstants::SECTOR_MAX_ASTEROIDS;
+    const AsteroidStore &sector = result.asteroids;
+    for (size_t i = 0; i < sector.Size(); ++i)
+    {
+        size_t index = base + i;
+        asteroids.Set(index, sector.positions[i], sector.collisionRadii[i], sector.rotationAngles[i], sector.rotationSpeeds[i],
+                      sector.hitPoints[i], sector.cold[i]);
+        BoundingBox bounds = GetInstanceBounds(asteroids, index);
+        grid.Add((int)index, bounds);
+        for (SpatialIndex *extraIndex : extraIndexes)
+            extraIndex->Add((int)index, bounds);
+    }
+
+    SectorSlot &slot = slots[result.slot];
+    slot.state = SECTOR_SLOT_RESIDENT;
+    slot.asteroidCount = (int)sector.Size();
+    stats.liveAsteroids += slot.asteroidCount;
+    stats.residentSectors++;
+    stats.pendingSectors--;
+    stats.sectorsInstalled++;
+}
+
+void SectorStreamer::Update(Vector3 cameraPosition, double installBudget)
+{
+    Vector3Int center = GetSectorCoord(cameraPosition);
+    if (!hasCenter || center.x != centerSector.x || center.y != centerSector.y || center.z != centerSector.z)
+    {
+        centerSector = center;
+        hasCenter = true;
+        RebuildWanted();
+    }
+
+    // 1. Install finished sectors, dropping the ones the camera has left behind meanwhile
+    installedSlots.clear();
+    double installStart = GetTime();
+    for (;;)
+    {
+        SectorResult result;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (results.empty())
+                break;
+            result = std::move(results.front());
+            results.pop_front();
+        }
+        if (GetSectorDistance(result.coord, centerSector) > loadRadius)
+        {
+            stats.pendingSectors--;
+            ReleaseSlot(result.slot);
+            continue;
+        }
+        InstallResult(result);
+        installedSlots.push_back(result.slot);
+        if (GetTime() - installStart >= installBudget)
+            break; // At least one sector per frame, the rest waits for the next frame
+    }
+
+    // 2. Evict resident sectors past the margin (one sector of hysteresis against edge thrashing)
+    for (size_t s = 0; s < slots.size(); ++s)
+    {
+        if (slots[s].state == SECTOR_SLOT_RESIDENT && GetSectorDistance(slots[s].coord, centerSector) > loadRadius + 1)
+            EvictSlot((int)s);
+    }
+
+    // 3. Cancel queued requests that are no longer wanted (the worker has not started them)
+    std::vector<int> cancelledSlots;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (size_t r = 0; r < requests.size();)
+        {
+            if (GetSectorDistance(requests[r].coord, centerSector) > loadRadius)
+            {
+                cancelledSlots.push_back(requests[r].slot);
+                requests.erase(requests.begin() + r);
+            }
+            else
+                ++r;
+        }
+    }
+    for (int slot : cancelledSlots)
+    {
+        stats.pendingSectors--;
+        ReleaseSlot(slot);
+    }
+
+    // 4. Request missing sectors, nearest first, while slots are available
+    std::vector<SectorRequest> newRequests;
+    for (const Vector3Int &coord : wanted)
+    {
+        long long key = GetSectorKey(coord);
+        if (sectorSlots.find(key) != sectorSlots.end())
+            continue;
+        int slot = AcquireSlot();
+        if (slot < 0)
+        {
+            stats.budgetSkips++; // The rest are farther away, they wait for a slot to free up
+            break;
+        }
+        slots[slot].state = SECTOR_SLOT_PENDING;
+        slots[slot].coord = coord;
+        slots[slot].asteroidCount = 0;
+        sectorSlots[key] = slot;
+        stats.pendingSectors++;
+        newRequests.push_back(SectorRequest{coord, slot});
+    }
+    if (!newRequests.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            requests.insert(requests.end(), newRequests.begin(), newRequests.end());
+        }
+        queueCondition.notify_one();
+    }
+}
+
+// Worker thread: generates requested sectors in order (CPU data only)
+void SectorStreamer::WorkerMain()
+{
+    for (;;)
+    {
+        SectorRequest request;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]
+                                { return stopping || !requests.empty(); });
+            if (stopping)
+                return;
+            request = requests.front();
+            requests.pop_front();
+        }
+
+        SectorResult result;
+        result.coord = request.coord;
+        result.slot = request.slot;
+        GenerateSectorAsteroids(meshPool, config, fieldSeed, request.coord.x, request.coord.y, request.coord.z, result.asteroids);
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        results.push_back(std::move(result));
+    }
+}
+
+bool SectorStreamer::IsSettled() const
+{
+    // Update requests everything the slots allow, so nothing pending means nothing more to come
+    return hasCenter && stats.pendingSectors == 0;
+}
+
+float SectorStreamer::GetProgress() const
+{
+    if (!hasCenter || wanted.empty())
+        return 0.0f;
+    int resident = 0;
+    for (const Vector3Int &coord : wanted)
+    {
+        auto it = sectorSlots.find(GetSectorKey(coord));
+        if (it != sectorSlots.end() && slots[it->second].state == SECTOR_SLOT_RESIDENT)
+            resident++;
+    }
+    return (float)resident / (float)wanted.size();
+}
+
+SectorStreamStats SectorStreamer::GetStats() const
+{
+    return stats;
+}
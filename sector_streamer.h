@@ -0,0 +1,131 @@
+#ifndef SECTOR_STREAMER_H
+#define SECTOR_STREAMER_H
+
+#include "raylib.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+
+#include "asteroid_field.h"
+#include "asteroid_store.h"
+#include "uniform_grid.h"
+
+//------------------------------------------------------------------------------------
+// Streamed Sector Field
+//------------------------------------------------------------------------------------
+// Keeps the sectors around the camera resident in a fixed-size AsteroidStore: the store is
+// split into maxResidentSectors slots of SECTOR_MAX_ASTEROIDS asteroids each, so memory stays
+// flat however far the player flies. Sectors within loadRadius (in sectors, on every axis) are
+// requested nearest first and generated on a worker thread; the main thread installs finished
+// sectors into their slot and the grid within a time budget. Sectors that drift past
+// loadRadius + 1 are evicted (slot asteroids deactivated and removed from the grid).
+// Mesh variants are shared by every sector, so eviction has no GPU memory to free.
+constexpr int SECTOR_LOAD_RADIUS = 2;            // 5x5x5 sectors around the camera
+constexpr int SECTOR_DEFAULT_MAX_RESIDENT = 160; // Slots (the load cube plus room for the eviction margin)
+constexpr double SECTOR_INSTALL_BUDGET = 0.001;  // Seconds of sector installs per frame
+
+typedef struct
+{
+    int residentSectors;  // Installed
+    int pendingSectors;   // Requested, not installed yet
+    int wantedSectors;    // Sectors within the load radius of the camera
+    int liveAsteroids;    // Asteroids in resident sectors (destroyed ones included)
+    int sectorsInstalled; // Totals since construction
+    int sectorsEvicted;
+    int budgetSkips;      // Updates that could not request every wanted sector (all slots in use)
+} SectorStreamStats;
+
+class SectorStreamer
+{
+public:
+    // asteroids must be empty and grid an empty grid over GetStreamedFieldBounds(). Both, and the
+    // mesh pool, must outlive the streamer (config is copied). The store is sized once here and
+    // never resized after.
+    SectorStreamer(uint64_t fieldSeed, const FieldConfig &config, const AsteroidMeshPool &meshPool, AsteroidStore &asteroids,
+                   UniformGrid &grid, int loadRadius = SECTOR_LOAD_RADIUS, int maxResidentSectors = SECTOR_DEFAULT_MAX_RESIDENT);
+    ~SectorStreamer(); // Stops and joins the worker; store and grid keep the resident sectors
+
+    // Main thread, with no asteroid jobs in flight: install finished sectors for up to
+    // installBudget seconds (at least one), evict distant ones and request missing ones
+    void Update(Vector3 cameraPosition, double installBudget);
+
+    bool IsSettled() const;    // Every wanted sector that fits the budget is resident
+    float GetProgress() const; // Resident share of the wanted sectors (for the loading screen)
+    SectorStreamStats GetStats() const;
+    // Slots installed by the last Update: their asteroids [slot * SECTOR_MAX_ASTEROIDS, + SECTOR_MAX_ASTEROIDS)
+    // were replaced (copies of per-asteroid data, such as GPU instances, need a refresh)
+    const std::vector<int> &GetInstalledSlots() const { return installedSlots; }
+    // Keep another spatial index (e.g. a BVH) in step with the grid. It must already hold the
+    // resident asteroids (BuildInstanced on the store) and outlive the streamer.
+    void AttachIndex(SpatialIndex &index) { extraIndexes.push_back(&index); }
+    static Vector3Int GetSectorCoord(Vector3 worldPosition);
+
+private:
+    typedef enum
+    {
+        SECTOR_SLOT_FREE = 0,
+        SECTOR_SLOT_PENDING, // Waiting for (or being generated by) the worker
+        SECTOR_SLOT_RESIDENT
+    } SectorSlotState;
+
+    typedef struct
+    {
+        SectorSlotState state;
+        Vector3Int coord;
+        int asteroidCount;
+    } SectorSlot;
+
+    typedef struct
+    {
+        Vector3Int coord;
+        int slot;
+    } SectorRequest;
+
+    typedef struct
+    {
+        Vector3Int coord;
+        int slot;
+        AsteroidStore asteroids;
+    } SectorResult;
+
+    static long long GetSectorKey(Vector3Int coord);
+    static int GetSectorDistance(Vector3Int a, Vector3Int b); // Chebyshev, in sectors
+    bool IsSectorInWorld(Vector3Int coord) const;
+    void RebuildWanted();
+    int AcquireSlot();
+    void ReleaseSlot(int slot);
+    void EvictSlot(int slot);
+    void InstallResult(const SectorResult &result);
+    void WorkerMain();
+
+    uint64_t fieldSeed;
+    FieldConfig config;
+    const AsteroidMeshPool &meshPool;
+    AsteroidStore &asteroids;
+    UniformGrid &grid;
+    std::vector<SpatialIndex *> extraIndexes; // Attached indexes, updated along with the grid
+    int loadRadius;
+
+    // Main thread state
+    std::vector<SectorSlot> slots;
+    std::vector<int> freeSlots;
+    std::unordered_map<long long, int> sectorSlots; // Sector key -> slot (pending or resident)
+    std::vector<Vector3Int> wanted;                 // Load cube around centerSector, nearest first
+    std::vector<int> installedSlots;                // By the last Update
+    Vector3Int centerSector;
+    bool hasCenter;
+    SectorStreamStats stats;
+
+    // Shared with the worker (guarded by queueMutex)
+    std::thread worker;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<SectorRequest> requests;
+    std::deque<SectorResult> results;
+    bool stopping;
+};
+
+#endif // SECTOR_STREAMER_H
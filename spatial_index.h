@@ -0,0 +1,183 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "raylib.h"
+#include "raymath.h"
+#include <cmath>
+
+#include "asteroid_store.h"
+#include "frame_arena.h"
+#include "frustum.h"
+#include "job_system.h"
+
+//------------------------------------------------------------------------------------
+// Spatial Index Results
+//------------------------------------------------------------------------------------
+
+// Cheap per-index query counters (reset by the caller, e.g. once per frame)
+typedef struct GridQueryStats
+{
+    int queries;      // Query/QueryRay/SweepSphere calls, one per ray for Raycast/RaycastBatch
+    int cellsVisited; // Grid cells or BVH nodes whose contents were scanned
+    int candidates;   // Unique indices written to output buffers
+    int allocations;  // Times an output or internal buffer had to grow (0 in steady state)
+} GridQueryStats;
+
+// Closest sphere hit of a raycast (instanceIndex -1 when nothing was hit)
+typedef struct GridRayHit
+{
+    int instanceIndex;
+    float distance; // Along the normalized ray direction
+    Vector3 point;
+    Vector3 normal;
+} GridRayHit;
+
+constexpr size_t GRID_RAY_JOB_CHUNK = 16; // Rays per job in RaycastBatch
+
+// First contact of a swept sphere (instanceIndex -1 when the path is clear)
+typedef struct GridSweepHit
+{
+    int instanceIndex;
+    float time;       // Fraction of the movement [0, 1] at first contact (1 when clear)
+    Vector3 position; // Sphere center at first contact (the end point when clear)
+    Vector3 normal;   // From the asteroid's center towards the sphere at contact
+} GridSweepHit;
+
+//------------------------------------------------------------------------------------
+// Spatial Index Interface
+//------------------------------------------------------------------------------------
+// What gameplay, culling and the bench need from an acceleration structure over the asteroids'
+// bounds, so backends can be swapped at runtime. Implemented by UniformGrid (cells) and
+// BvhIndex (SAH tree). Queries may restructure lazily (pack, rebuild, refit), so they are
+// not const; RaycastBatch prepares first and then traces read-only in parallel.
+class SpatialIndex
+{
+public:
+    virtual ~SpatialIndex() {}
+
+    virtual const char *GetName() const = 0;
+
+    // Whole-store build (active asteroids, bounds from the collision radius)
+    virtual void BuildInstanced(const AsteroidStore &instances) = 0;
+    virtual void Add(int instanceIndex, BoundingBox worldBounds) = 0;
+    virtual void Remove(int instanceIndex) = 0;
+    virtual void Move(int instanceIndex, BoundingBox oldBounds, BoundingBox newBounds) = 0;
+
+    // Clear and fill a caller-owned buffer, each index at most once. Candidates are a superset of
+    // the exact answer: at least every instance whose bounds contain worldPos (the grid adds its
+    // neighbouring cells), or whose bounds the ray crosses within maxDistance.
+    virtual void Query(Vector3 worldPos, FrameVector<int> &outIndices) = 0;
+    virtual void QueryRay(Ray ray, float maxDistance, FrameVector<int> &outIndices) = 0;
+    // Visibility query: indices in outInside are fully inside the frustum and need no further test,
+    // the ones in outIntersecting may cross a plane
+    virtual void QueryFrustum(const Frustum &frustum, FrameVector<int> &outInside, FrameVector<int> &outIntersecting) = 0;
+
+    // Closest hit against the asteroids' collision spheres (inactive asteroids are skipped)
+    virtual GridRayHit Raycast(Ray ray, float maxDistance, const AsteroidStore &asteroids) = 0;
+    // outHits[i] is the hit of rays[i]; with a job system the rays are split across its threads
+    virtual void RaycastBatch(const Ray *rays, int rayCount, float maxDistance, const AsteroidStore &asteroids,
+                              GridRayHit *outHits, JobSystem *jobs = nullptr) = 0;
+    // Moving sphere from start to end: earliest time of impact, 0 if it already overlaps one at start
+    virtual GridSweepHit SweepSphere(Vector3 start, Vector3 end, float radius, const AsteroidStore &asteroids) = 0;
+
+    virtual const GridQueryStats &GetQueryStats() const = 0;
+    virtual void ResetQueryStats() = 0;
+    virtual size_t GetMemoryUsage() const = 0; // Bytes held by the structure and its per-instance records
+};
+
+// Bounds BuildInstanced uses for asteroid i (collision sphere, 0.5 when the radius is not set)
+inline BoundingBox GetInstanceBounds(const AsteroidStore &instances, size_t i)
+{
+    float r = instances.collisionRadii[i];
+    if (r <= 0.0f)
+        r = 0.5f;
+    Vector3 p = instances.positions[i];
+    return BoundingBox{{p.x - r, p.y - r, p.z - r}, {p.x + r, p.y + r, p.z + r}};
+}
+
+//------------------------------------------------------------------------------------
+// Narrow Phase Helpers (shared by the backends, so both report identical hits)
+//------------------------------------------------------------------------------------
+
+// Ray vs collision sphere of one instance, keeping it if it is closer than the best hit so far
+inline void TestInstanceSphere(Ray ray, const AsteroidStore &asteroids, int instanceIndex, GridRayHit &bestHit)
+{
+    if (instanceIndex < 0 || instanceIndex >= (int)asteroids.Size() || !asteroids.IsActive(instanceIndex))
+        return;
+
+    // |origin + t * direction - center| = radius, direction is unit length
+    Vector3 toCenter = Vector3Subtract(asteroids.positions[instanceIndex], ray.position);
+    float radius = asteroids.collisionRadii[instanceIndex];
+    float projection = Vector3DotProduct(toCenter, ray.direction);
+    float discriminant = projection * projection - (Vector3DotProduct(toCenter, toCenter) - radius * radius);
+    if (discriminant < 0.0f)
+        return;
+
+    float halfChord = sqrtf(discriminant);
+    float t = projection - halfChord;
+    if (t < 0.0f)
+        t = projection + halfChord; // Origin inside the sphere
+    if (t < 0.0f || t > bestHit.distance)
+        return; // Behind the origin, or farther than the current best
+    if (t == bestHit.distance && bestHit.instanceIndex >= 0 && instanceIndex > bestHit.instanceIndex)
+        return; // Exact ties resolve to the lowest index, whatever the traversal order
+
+    bestHit.instanceIndex = instanceIndex;
+    bestHit.distance = t;
+}
+
+// Hit point and surface normal of the best hit (ray direction normalized)
+inline void CompleteRayHit(Ray ray, const AsteroidStore &asteroids, GridRayHit &bestHit)
+{
+    if (bestHit.instanceIndex < 0)
+        return;
+    Vector3 center = asteroids.positions[bestHit.instanceIndex];
+    float radius = asteroids.collisionRadii[bestHit.instanceIndex];
+    bestHit.point = Vector3Add(ray.position, Vector3Scale(ray.direction, bestHit.distance));
+    bestHit.normal = Vector3Normalize(Vector3Subtract(bestHit.point, center));
+    if (Vector3DistanceSqr(ray.position, center) < radius * radius)
+        bestHit.normal = Vector3Negate(bestHit.normal); // Origin inside the sphere, hit its far side from within
+}
+
+// Moving sphere (start + distance * direction) against one asteroid, keeping the earliest contact
+inline void SweepTestSphere(Vector3 start, Vector3 direction, float radius, const AsteroidStore &asteroids,
+                            int instanceIndex, GridSweepHit &bestHit, float &bestDistance)
+{
+    if (instanceIndex < 0 || instanceIndex >= (int)asteroids.Size() || !asteroids.IsActive(instanceIndex))
+        return;
+
+    // First distance at which the centers are radius + asteroid radius apart
+    Vector3 fromCenter = Vector3Subtract(start, asteroids.positions[instanceIndex]);
+    float contactRadius = radius + asteroids.collisionRadii[instanceIndex];
+    float c = Vector3DotProduct(fromCenter, fromCenter) - contactRadius * contactRadius;
+    float distance = 0.0f; // Already touching at the start
+    if (c > 0.0f)
+    {
+        float b = Vector3DotProduct(fromCenter, direction);
+        float discriminant = b * b - c;
+        if (b >= 0.0f || discriminant < 0.0f)
+            return; // Moving away, or passing by
+        distance = -b - sqrtf(discriminant);
+    }
+    if (distance > bestDistance)
+        return;
+    if (distance == bestDistance && bestHit.instanceIndex >= 0 && instanceIndex > bestHit.instanceIndex)
+        return; // Exact ties resolve to the lowest index, whatever the traversal order
+
+    bestHit.instanceIndex = instanceIndex;
+    bestDistance = distance;
+}
+
+// Time, position and normal of the earliest contact (length of the movement, direction normalized)
+inline void CompleteSweepHit(Vector3 start, Vector3 direction, float length, const AsteroidStore &asteroids,
+                             float bestDistance, GridSweepHit &bestHit)
+{
+    if (bestHit.instanceIndex < 0)
+        return;
+    bestHit.time = (length > 0.0001f) ? bestDistance / length : 0.0f;
+    bestHit.position = Vector3Add(start, Vector3Scale(direction, bestDistance));
+    Vector3 away = Vector3Subtract(bestHit.position, asteroids.positions[bestHit.instanceIndex]);
+    bestHit.normal = (Vector3LengthSqr(away) > 0.0f) ? Vector3Normalize(away) : Vector3Negate(direction);
+}
+
+#endif // SPATIAL_INDEX_H
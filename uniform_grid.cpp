@@ -1,17 +1,35 @@
 #include "uniform_grid.h"
 #include <cmath> // For floorf, ceilf
 #include <vector>
-#include <set>       // For easily getting unique indices in Query
 #include <algorithm> // For std::max, std::min
 #include <limits>    // Required for QueryRay
+#include <climits>   // For INT_MAX
+#include <atomic>    // RaycastBatch cell counter
+#include <cstring>   // For memcpy (serialization)
+
+//------------------------------------------------------------------------------------
+// Cell Key Hashing (hashed storage mode)
+//------------------------------------------------------------------------------------
+static inline unsigned long long HashCellKey(long long key)
+{
+    // 64-bit finalizer (MurmurHash3 fmix64), spreads neighbouring cell keys across the table
+    unsigned long long h = (unsigned long long)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
 
 //------------------------------------------------------------------------------------
 // UniformGrid Class - Implementation
 //------------------------------------------------------------------------------------
 
 // Constructor
-UniformGrid::UniformGrid(Vector3 worldMin, Vector3 worldMax, Vector3 cellSize)
-    : gridMinBounds(worldMin), gridMaxBounds(worldMax), gridCellSize(cellSize)
+UniformGrid::UniformGrid(Vector3 worldMin, Vector3 worldMax, Vector3 cellSize, GridStorageMode storageMode)
+    : gridMinBounds(worldMin), gridMaxBounds(worldMax), gridCellSize(cellSize), storageMode(storageMode),
+      packDirty(false), queryStamp(0), queryStats{0}, pairStats{0}
 {
     // Ensure cell size is positive
     if (gridCellSize.x <= 0.0f)
@@ -35,21 +53,32 @@ UniformGrid::UniformGrid(Vector3 worldMin, Vector3 worldMax, Vector3 cellSize)
     if (gridDimZ <= 0)
         gridDimZ = 1;
 
-    totalCells = gridDimX * gridDimY * gridDimZ;
+    totalCells = (long long)gridDimX * (long long)gridDimY * (long long)gridDimZ;
 
-    // Resize the main grid vector
-    gridCells.resize(totalCells);
+    // Resolve the storage mode, a dense offsets array must stay addressable with int
+    if (this->storageMode == GRID_STORAGE_AUTO)
+        this->storageMode = (totalCells > GRID_MAX_DENSE_CELLS) ? GRID_STORAGE_HASHED : GRID_STORAGE_DENSE;
+    if (this->storageMode == GRID_STORAGE_DENSE && totalCells >= INT_MAX)
+    {
+        TraceLog(LOG_WARNING, "UniformGrid: %lld cells is too many for dense storage, using hashed cells", totalCells);
+        this->storageMode = GRID_STORAGE_HASHED;
+    }
 
-    TraceLog(LOG_INFO, "UniformGrid initialized: Dims(%d, %d, %d), Cells=%d", gridDimX, gridDimY, gridDimZ, totalCells);
+    TraceLog(LOG_INFO, "UniformGrid initialized: Dims(%d, %d, %d), Cells=%lld, Storage=%s", gridDimX, gridDimY, gridDimZ, totalCells,
+             (this->storageMode == GRID_STORAGE_DENSE) ? "dense CSR" : "hashed CSR");
 }
 
-// Clear grid
+// Clear grid (O(1): the packed arrays are simply emptied, capacity is kept)
 void UniformGrid::Clear()
 {
-    for (int i = 0; i < totalCells; ++i)
-    {
-        gridCells[i].clear(); // Clear the list of indices for each cell
-    }
+    instanceRanges.clear();
+    cellOffsets.clear();
+    cellCounts.clear();
+    cellEntries.clear();
+    hashKeys.clear();
+    hashSlots.clear();
+    overflowEntries.clear();
+    packDirty = false;
 }
 
 // Get integer cell indices from world position
@@ -58,9 +87,10 @@ Vector3Int UniformGrid::GetCellIndices(Vector3 worldPos) const
     Vector3Int indices = {0};
     Vector3 relativePos = Vector3Subtract(worldPos, gridMinBounds);
 
-    indices.x = (int)floorf(relativePos.x / gridCellSize.x);
-    indices.y = (int)floorf(relativePos.y / gridCellSize.y);
-    indices.z = (int)floorf(relativePos.z / gridCellSize.z);
+    // Clamp in float first so far-away positions cannot overflow the int conversion
+    indices.x = (int)Clamp(floorf(relativePos.x / gridCellSize.x), -1.0f, (float)gridDimX);
+    indices.y = (int)Clamp(floorf(relativePos.y / gridCellSize.y), -1.0f, (float)gridDimY);
+    indices.z = (int)Clamp(floorf(relativePos.z / gridCellSize.z), -1.0f, (float)gridDimZ);
 
     // Clamp indices to be within valid grid range
     indices.x = std::max(0, std::min(indices.x, gridDimX - 1));
@@ -86,67 +116,514 @@ int UniformGrid::Get1DIndex(int ix, int iy, int iz) const
     return ix + iy * gridDimX + iz * gridDimX * gridDimY;
 }
 
+// Same as Get1DIndex but in 64-bit, used as the hash key in hashed mode
+long long UniformGrid::GetCellKey(int ix, int iy, int iz) const
+{
+    return (long long)ix + (long long)iy * gridDimX + (long long)iz * gridDimX * gridDimY;
+}
+
+// Find the packed slot of a cell, -1 if it is outside the grid or holds no entries
+int UniformGrid::FindCellSlot(int ix, int iy, int iz) const
+{
+    if (!IsValidIndex(ix, iy, iz) || cellOffsets.empty())
+        return -1;
+
+    if (storageMode == GRID_STORAGE_DENSE)
+        return Get1DIndex(ix, iy, iz);
+
+    long long key = GetCellKey(ix, iy, iz);
+    size_t mask = hashKeys.size() - 1;
+    for (size_t h = HashCellKey(key) & mask;; h = (h + 1) & mask)
+    {
+        if (hashKeys[h] == key)
+            return hashSlots[h];
+        if (hashKeys[h] == -1)
+            return -1;
+    }
+}
+
+// Hashed mode: look up a cell key, appending a new (empty) slot if it is not present yet
+int UniformGrid::InsertHashedCell(long long key)
+{
+    size_t mask = hashKeys.size() - 1;
+    for (size_t h = HashCellKey(key) & mask;; h = (h + 1) & mask)
+    {
+        if (hashKeys[h] == key)
+            return hashSlots[h];
+        if (hashKeys[h] == -1)
+        {
+            int slot = (int)cellOffsets.size() - 1;
+            hashKeys[h] = key;
+            hashSlots[h] = slot;
+            cellOffsets.push_back(0);
+            return slot;
+        }
+    }
+}
+
 // Add an asteroid instance index to all cells its bounds overlap
 void UniformGrid::Add(int instanceIndex, BoundingBox worldBounds)
 {
-    Vector3Int minIndices = GetCellIndices(worldBounds.min);
-    Vector3Int maxIndices = GetCellIndices(worldBounds.max);
+    if (instanceIndex < 0)
+        return;
 
-    for (int iz = minIndices.z; iz <= maxIndices.z; ++iz)
+    // Grow the dedup stamp array so queries never have to bounds-check it
+    if (instanceIndex >= (int)instanceStamps.size())
     {
-        for (int iy = minIndices.y; iy <= maxIndices.y; ++iy)
+        instanceStamps.resize(instanceIndex + 1, 0u);
+        queryStats.allocations++;
+    }
+    if (instanceIndex >= (int)instanceRanges.size())
+        instanceRanges.resize(instanceIndex + 1, GridInstanceRange{{0, 0, 0}, {0, 0, 0}, false});
+
+    GridInstanceRange newRange = {GetCellIndices(worldBounds.min), GetCellIndices(worldBounds.max), true};
+    GridInstanceRange &range = instanceRanges[instanceIndex];
+
+    if (IsPacked())
+    {
+        // Already packed: insert in place (re-adding an instance moves it)
+        GridInstanceRange oldRange = range;
+        range = newRange;
+        ApplyRangeChange(instanceIndex, oldRange, newRange);
+    }
+    else
+    {
+        // Only the overlapped cell range is recorded here, Pack() scatters it into the cells
+        range = newRange;
+        packDirty = true;
+    }
+}
+
+// Remove an instance from all cells it occupies
+void UniformGrid::Remove(int instanceIndex)
+{
+    if (instanceIndex < 0 || instanceIndex >= (int)instanceRanges.size() || !instanceRanges[instanceIndex].inGrid)
+        return;
+
+    GridInstanceRange oldRange = instanceRanges[instanceIndex];
+    instanceRanges[instanceIndex].inGrid = false;
+    if (IsPacked())
+        ApplyRangeChange(instanceIndex, oldRange, instanceRanges[instanceIndex]);
+    // Otherwise the pending Pack() simply skips the instance
+}
+
+// Move an instance to new bounds, touching only the cells it leaves or enters
+void UniformGrid::Move(int instanceIndex, BoundingBox oldBounds, BoundingBox newBounds)
+{
+    if (instanceIndex < 0 || instanceIndex >= (int)instanceRanges.size() || !instanceRanges[instanceIndex].inGrid)
+    {
+        Add(instanceIndex, newBounds); // Not tracked yet
+        return;
+    }
+
+    Vector3Int newMin = GetCellIndices(newBounds.min);
+    Vector3Int newMax = GetCellIndices(newBounds.max);
+    Vector3Int oldMin = GetCellIndices(oldBounds.min);
+    Vector3Int oldMax = GetCellIndices(oldBounds.max);
+    if (newMin.x == oldMin.x && newMin.y == oldMin.y && newMin.z == oldMin.z &&
+        newMax.x == oldMax.x && newMax.y == oldMax.y && newMax.z == oldMax.z)
+        return; // Still in the same cells, nothing to do
+
+    GridInstanceRange oldRange = instanceRanges[instanceIndex];
+    GridInstanceRange newRange = {newMin, newMax, true};
+    instanceRanges[instanceIndex] = newRange;
+    if (IsPacked())
+        ApplyRangeChange(instanceIndex, oldRange, newRange);
+    // Otherwise the pending Pack() picks up the new range
+}
+
+bool UniformGrid::RangeContains(const GridInstanceRange &range, int ix, int iy, int iz)
+{
+    return range.inGrid &&
+           ix >= range.minCell.x && ix <= range.maxCell.x &&
+           iy >= range.minCell.y && iy <= range.maxCell.y &&
+           iz >= range.minCell.z && iz <= range.maxCell.z;
+}
+
+void UniformGrid::ApplyRangeChange(int instanceIndex, const GridInstanceRange &oldRange, const GridInstanceRange &newRange)
+{
+    if (oldRange.inGrid)
+    {
+        for (int iz = oldRange.minCell.z; iz <= oldRange.maxCell.z; ++iz)
+            for (int iy = oldRange.minCell.y; iy <= oldRange.maxCell.y; ++iy)
+                for (int ix = oldRange.minCell.x; ix <= oldRange.maxCell.x; ++ix)
+                    if (!RangeContains(newRange, ix, iy, iz))
+                        RemoveFromCell(ix, iy, iz, instanceIndex);
+    }
+    if (newRange.inGrid)
+    {
+        for (int iz = newRange.minCell.z; iz <= newRange.maxCell.z; ++iz)
+            for (int iy = newRange.minCell.y; iy <= newRange.maxCell.y; ++iy)
+                for (int ix = newRange.minCell.x; ix <= newRange.maxCell.x; ++ix)
+                    if (!RangeContains(oldRange, ix, iy, iz))
+                        InsertIntoCell(ix, iy, iz, instanceIndex);
+    }
+}
+
+// Place an index into a packed cell, reusing a hole left by a removal or spilling to overflow
+void UniformGrid::InsertIntoCell(int ix, int iy, int iz, int instanceIndex)
+{
+    int slot = FindCellSlot(ix, iy, iz);
+    if (slot >= 0 && cellCounts[slot] < cellOffsets[slot + 1] - cellOffsets[slot])
+    {
+        cellEntries[cellOffsets[slot] + cellCounts[slot]] = instanceIndex;
+        cellCounts[slot]++;
+        return;
+    }
+
+    overflowEntries.push_back(GridOverflowEntry{GetCellKey(ix, iy, iz), instanceIndex});
+
+    // Queries scan the overflow linearly, so repack once it stops being small.
+    // instanceRanges is always up to date, so the lazy Pack() rebuilds the exact state.
+    size_t overflowLimit = std::max((size_t)64, cellEntries.size() / 8);
+    if (overflowEntries.size() > overflowLimit)
+        packDirty = true;
+}
+
+// Take an index out of a packed cell (swap with the cell's last live entry) or out of the overflow
+void UniformGrid::RemoveFromCell(int ix, int iy, int iz, int instanceIndex)
+{
+    int slot = FindCellSlot(ix, iy, iz);
+    if (slot >= 0)
+    {
+        int begin = cellOffsets[slot];
+        int last = begin + cellCounts[slot] - 1;
+        for (int e = begin; e <= last; ++e)
         {
-            for (int ix = minIndices.x; ix <= maxIndices.x; ++ix)
+            if (cellEntries[e] == instanceIndex)
             {
-                if (IsValidIndex(ix, iy, iz))
-                {
-                    int cellIndex = Get1DIndex(ix, iy, iz);
-                    // Cast gridCells.size() to int for comparison
-                    if (cellIndex >= 0 && cellIndex < (int)gridCells.size())
-                    { // Safety check
-                        gridCells[cellIndex].push_back(instanceIndex);
-                    }
-                    else
-                    {
-                        TraceLog(LOG_WARNING, "GRID ADD: Calculated invalid cell index %d for coords (%d, %d, %d)", cellIndex, ix, iy, iz);
-                    }
-                }
+                cellEntries[e] = cellEntries[last];
+                cellCounts[slot]--;
+                return;
             }
         }
     }
+
+    long long key = GetCellKey(ix, iy, iz);
+    for (size_t i = 0; i < overflowEntries.size(); ++i)
+    {
+        if (overflowEntries[i].cellKey == key && overflowEntries[i].instanceIndex == instanceIndex)
+        {
+            overflowEntries[i] = overflowEntries.back();
+            overflowEntries.pop_back();
+            return;
+        }
+    }
+}
+
+// Pack all recorded instances into the CSR arrays with a two-pass counting sort
+void UniformGrid::Pack()
+{
+    packDirty = false;
+    cellEntries.clear();
+    overflowEntries.clear();
+
+    if (storageMode == GRID_STORAGE_DENSE)
+    {
+        // Pass 1: count entries per cell (stored shifted by one for the prefix sum)
+        cellOffsets.assign((size_t)totalCells + 1, 0);
+        for (size_t i = 0; i < instanceRanges.size(); ++i)
+        {
+            const GridInstanceRange &range = instanceRanges[i];
+            if (!range.inGrid)
+                continue;
+            for (int iz = range.minCell.z; iz <= range.maxCell.z; ++iz)
+                for (int iy = range.minCell.y; iy <= range.maxCell.y; ++iy)
+                    for (int ix = range.minCell.x; ix <= range.maxCell.x; ++ix)
+                        cellOffsets[Get1DIndex(ix, iy, iz) + 1]++;
+        }
+    }
+    else
+    {
+        // Size the hash table for the worst case (every entry in its own cell) at <= 50% load
+        size_t entryCount = 0;
+        for (size_t i = 0; i < instanceRanges.size(); ++i)
+        {
+            const GridInstanceRange &range = instanceRanges[i];
+            if (range.inGrid)
+                entryCount += (size_t)(range.maxCell.x - range.minCell.x + 1) * (range.maxCell.y - range.minCell.y + 1) * (range.maxCell.z - range.minCell.z + 1);
+        }
+        size_t tableSize = 16;
+        while (tableSize < entryCount * 2)
+            tableSize <<= 1;
+        hashKeys.assign(tableSize, -1);
+        hashSlots.assign(tableSize, -1);
+
+        // Pass 1: create one slot per occupied cell and count its entries
+        cellOffsets.assign(1, 0);
+        for (size_t i = 0; i < instanceRanges.size(); ++i)
+        {
+            const GridInstanceRange &range = instanceRanges[i];
+            if (!range.inGrid)
+                continue;
+            for (int iz = range.minCell.z; iz <= range.maxCell.z; ++iz)
+                for (int iy = range.minCell.y; iy <= range.maxCell.y; ++iy)
+                    for (int ix = range.minCell.x; ix <= range.maxCell.x; ++ix)
+                        cellOffsets[InsertHashedCell(GetCellKey(ix, iy, iz)) + 1]++;
+        }
+    }
+
+    // Prefix sum turns counts into start offsets
+    size_t slotCount = cellOffsets.size() - 1;
+    for (size_t slot = 0; slot < slotCount; ++slot)
+        cellOffsets[slot + 1] += cellOffsets[slot];
+
+    // Every packed cell starts full (count == capacity)
+    cellCounts.resize(slotCount);
+    for (size_t slot = 0; slot < slotCount; ++slot)
+        cellCounts[slot] = cellOffsets[slot + 1] - cellOffsets[slot];
+
+    // Pass 2: scatter instance indices, each cell's list ends up sorted by index
+    packCursor.assign(cellOffsets.begin(), cellOffsets.end() - 1);
+    cellEntries.resize(cellOffsets.back());
+    for (size_t i = 0; i < instanceRanges.size(); ++i)
+    {
+        const GridInstanceRange &range = instanceRanges[i];
+        if (!range.inGrid)
+            continue;
+        for (int iz = range.minCell.z; iz <= range.maxCell.z; ++iz)
+            for (int iy = range.minCell.y; iy <= range.maxCell.y; ++iy)
+                for (int ix = range.minCell.x; ix <= range.maxCell.x; ++ix)
+                    cellEntries[packCursor[FindCellSlot(ix, iy, iz)]++] = (int)i;
+    }
+}
+
+// Bytes held by the packed cells, the hash table and the per-instance records
+size_t UniformGrid::GetMemoryUsage() const
+{
+    return cellOffsets.capacity() * sizeof(int) +
+           cellCounts.capacity() * sizeof(int) +
+           cellEntries.capacity() * sizeof(int) +
+           overflowEntries.capacity() * sizeof(GridOverflowEntry) +
+           packCursor.capacity() * sizeof(int) +
+           hashKeys.capacity() * sizeof(long long) +
+           hashSlots.capacity() * sizeof(int) +
+           instanceRanges.capacity() * sizeof(GridInstanceRange) +
+           instanceStamps.capacity() * sizeof(unsigned int);
+}
+
+//------------------------------------------------------------------------------------
+// Serialization
+//------------------------------------------------------------------------------------
+// Blob layout: GridBlobHeader, then the arrays back to back in header order
+typedef struct GridBlobHeader
+{
+    unsigned int magic;
+    int storageMode;
+    Vector3 minBounds;
+    Vector3 maxBounds;
+    Vector3 cellSize;
+    unsigned long long rangeCount, offsetCount, countCount, entryCount, hashCount;
+} GridBlobHeader;
+
+static const unsigned int GRID_BLOB_MAGIC = 0x44495247; // "GRID"
+
+template <typename T>
+static void AppendArray(std::vector<unsigned char> &out, const std::vector<T> &values)
+{
+    size_t at = out.size();
+    out.resize(at + values.size() * sizeof(T));
+    if (!values.empty())
+        memcpy(out.data() + at, values.data(), values.size() * sizeof(T));
+}
+
+template <typename T>
+static bool ReadArray(const unsigned char *&cursor, const unsigned char *end, unsigned long long count, std::vector<T> &values)
+{
+    if (count > (unsigned long long)(end - cursor) / sizeof(T))
+        return false;
+    values.resize((size_t)count);
+    if (count > 0)
+        memcpy(values.data(), cursor, (size_t)count * sizeof(T));
+    cursor += (size_t)count * sizeof(T);
+    return true;
+}
+
+void UniformGrid::Serialize(std::vector<unsigned char> &out)
+{
+    if (packDirty || !overflowEntries.empty() || cellOffsets.empty())
+        Pack(); // The blob only holds packed cells
+
+    GridBlobHeader header;
+    memset(&header, 0, sizeof(header)); // Zero the padding as well
+    header.magic = GRID_BLOB_MAGIC;
+    header.storageMode = (int)storageMode;
+    header.minBounds = gridMinBounds;
+    header.maxBounds = gridMaxBounds;
+    header.cellSize = gridCellSize;
+    header.rangeCount = instanceRanges.size();
+    header.offsetCount = cellOffsets.size();
+    header.countCount = cellCounts.size();
+    header.entryCount = cellEntries.size();
+    header.hashCount = hashKeys.size();
+    size_t at = out.size();
+    out.resize(at + sizeof(header));
+    memcpy(out.data() + at, &header, sizeof(header));
+    AppendArray(out, instanceRanges);
+    AppendArray(out, cellOffsets);
+    AppendArray(out, cellCounts);
+    AppendArray(out, cellEntries);
+    AppendArray(out, hashKeys);
+    AppendArray(out, hashSlots);
+}
+
+UniformGrid *UniformGrid::Deserialize(const unsigned char *data, size_t size)
+{
+    GridBlobHeader header;
+    if (data == nullptr || size < sizeof(header))
+        return nullptr;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != GRID_BLOB_MAGIC || (header.storageMode != GRID_STORAGE_DENSE && header.storageMode != GRID_STORAGE_HASHED))
+        return nullptr;
+
+    UniformGrid *grid = new UniformGrid(header.minBounds, header.maxBounds, header.cellSize, (GridStorageMode)header.storageMode);
+    const unsigned char *cursor = data + sizeof(header);
+    const unsigned char *end = data + size;
+    bool ok = grid->storageMode == (GridStorageMode)header.storageMode &&
+              ReadArray(cursor, end, header.rangeCount, grid->instanceRanges) &&
+              ReadArray(cursor, end, header.offsetCount, grid->cellOffsets) &&
+              ReadArray(cursor, end, header.countCount, grid->cellCounts) &&
+              ReadArray(cursor, end, header.entryCount, grid->cellEntries) &&
+              ReadArray(cursor, end, header.hashCount, grid->hashKeys) &&
+              ReadArray(cursor, end, header.hashCount, grid->hashSlots);
+
+    // Cheap consistency checks, enough that queries can never index out of range or probe forever
+    size_t slotCount = grid->cellOffsets.empty() ? 0 : grid->cellOffsets.size() - 1;
+    ok = ok && !grid->cellOffsets.empty() && grid->cellCounts.size() == slotCount &&
+         grid->cellOffsets.back() == (int)grid->cellEntries.size();
+    if (ok && grid->storageMode == GRID_STORAGE_DENSE)
+        ok = (long long)slotCount == grid->totalCells;
+    if (ok && grid->storageMode == GRID_STORAGE_HASHED)
+        ok = !grid->hashKeys.empty() && (grid->hashKeys.size() & (grid->hashKeys.size() - 1)) == 0;
+    for (size_t slot = 0; ok && slot < slotCount; ++slot)
+        ok = grid->cellOffsets[slot] <= grid->cellOffsets[slot + 1] && grid->cellCounts[slot] >= 0 &&
+             grid->cellCounts[slot] <= grid->cellOffsets[slot + 1] - grid->cellOffsets[slot];
+    for (size_t e = 0; ok && e < grid->cellEntries.size(); ++e)
+        ok = grid->cellEntries[e] >= 0 && grid->cellEntries[e] < (int)grid->instanceRanges.size();
+    // Linear probing only stops on a hit or an empty (-1) key, so a full table would never end a miss
+    bool hasEmptyKey = grid->storageMode != GRID_STORAGE_HASHED;
+    for (size_t h = 0; ok && h < grid->hashKeys.size(); ++h)
+    {
+        if (grid->hashKeys[h] == -1)
+            hasEmptyKey = true;
+        else
+            ok = grid->hashSlots[h] >= 0 && grid->hashSlots[h] < (int)slotCount;
+    }
+    ok = ok && hasEmptyKey;
+    for (size_t i = 0; ok && i < grid->instanceRanges.size(); ++i)
+    {
+        const GridInstanceRange &range = grid->instanceRanges[i];
+        ok = !range.inGrid || (grid->IsValidIndex(range.minCell.x, range.minCell.y, range.minCell.z) &&
+                               grid->IsValidIndex(range.maxCell.x, range.maxCell.y, range.maxCell.z));
+    }
+    if (!ok)
+    {
+        TraceLog(LOG_WARNING, "UniformGrid: Serialized grid is inconsistent, ignoring it");
+        delete grid;
+        return nullptr;
+    }
+
+    grid->instanceStamps.assign(grid->instanceRanges.size(), 0u);
+    grid->packDirty = false;
+    return grid;
 }
 
 // --- Added BuildInstanced Method Definition ---
-void UniformGrid::BuildInstanced(const std::vector<Asteroid> &instances)
+void UniformGrid::BuildInstanced(const AsteroidStore &instances)
 {
     Clear(); // Clear any previous data
-    TraceLog(LOG_INFO, "Building Uniform Grid with %zu asteroid instances...", instances.size());
+    TraceLog(LOG_INFO, "Building Uniform Grid with %zu asteroid instances...", instances.Size());
 
-    for (size_t i = 0; i < instances.size(); ++i)
+    // Size the dedup stamps and range records once up front instead of growing them per Add
+    if (instanceStamps.size() < instances.Size())
+        instanceStamps.resize(instances.Size(), 0u);
+    instanceRanges.resize(instances.Size(), GridInstanceRange{{0, 0, 0}, {0, 0, 0}, false}); // One record per asteroid, active or not
+
+    for (size_t i = 0; i < instances.Size(); ++i)
     {
-        if (!instances[i].isActive)
+        if (!instances.IsActive(i))
             continue; // Only add active asteroids
 
-        // Approximate world bounds using position and collision radius
-        // This avoids needing access to baseMeshes here and complex scaled bounds calculation
-        float r = instances[i].collisionRadius;
-        if (r <= 0.0f)
-            r = 0.5f; // Use a minimum radius if calculated as zero
-        BoundingBox worldBounds = {
-            (Vector3){instances[i].position.x - r, instances[i].position.y - r, instances[i].position.z - r},
-            (Vector3){instances[i].position.x + r, instances[i].position.y + r, instances[i].position.z + r}};
-
-        // Add the instance's index (i) to the grid cells it overlaps
-        Add((int)i, worldBounds);
+        // Same collision-sphere box as the BVH, so both backends agree on membership
+        Add((int)i, GetInstanceBounds(instances, i));
     }
-    TraceLog(LOG_INFO, "Uniform Grid build complete.");
+    Pack(); // Counting-sort everything into the packed cell arrays
+    TraceLog(LOG_INFO, "Uniform Grid build complete: %zu entries in %zu slots.", cellEntries.size(), cellOffsets.size() - 1);
 }
 // --- End Added BuildInstanced Method ---
 
+// Start a new query: clear the output and advance the dedup stamp
+void UniformGrid::BeginQuery(FrameVector<int> &outIndices)
+{
+    EnsurePacked();     // Pack lazily if Add() was called since the last build
+    outIndices.clear(); // Keeps capacity
+    queryStats.queries++;
+    AdvanceQueryStamp();
+}
+
+void UniformGrid::AdvanceQueryStamp()
+{
+    queryStamp++;
+    if (queryStamp == 0)
+    {
+        // Stamp wrapped around, old stamps could alias the new one
+        std::fill(instanceStamps.begin(), instanceStamps.end(), 0u);
+        queryStamp = 1;
+    }
+}
+
+// Append every index of a cell that is not yet part of the current query
+void UniformGrid::GatherCell(int ix, int iy, int iz, FrameVector<int> &outIndices)
+{
+    int cellSlot = FindCellSlot(ix, iy, iz); // Validates the coordinates, -1 if empty
+    if (cellSlot >= 0)
+    {
+        queryStats.cellsVisited++;
+        int cellEnd = cellOffsets[cellSlot] + cellCounts[cellSlot];
+        for (int e = cellOffsets[cellSlot]; e < cellEnd; ++e)
+        {
+            int instanceIndex = cellEntries[e];
+            if (instanceStamps[instanceIndex] == queryStamp)
+                continue; // Already gathered through another cell
+
+            instanceStamps[instanceIndex] = queryStamp;
+            if (outIndices.size() == outIndices.capacity())
+                queryStats.allocations++; // push_back below will reallocate
+            outIndices.push_back(instanceIndex);
+            queryStats.candidates++;
+        }
+    }
+
+    // Entries inserted after packing that did not fit into their cell
+    if (!overflowEntries.empty() && IsValidIndex(ix, iy, iz))
+    {
+        long long key = GetCellKey(ix, iy, iz);
+        for (size_t i = 0; i < overflowEntries.size(); ++i)
+        {
+            int instanceIndex = overflowEntries[i].instanceIndex;
+            if (overflowEntries[i].cellKey != key || instanceStamps[instanceIndex] == queryStamp)
+                continue;
+
+            instanceStamps[instanceIndex] = queryStamp;
+            if (outIndices.size() == outIndices.capacity())
+                queryStats.allocations++;
+            outIndices.push_back(instanceIndex);
+            queryStats.candidates++;
+        }
+    }
+}
+
 // Query for potential colliders near a world position
 std::vector<int> UniformGrid::Query(Vector3 worldPos)
 {
-    std::set<int> uniqueIndices;
+    FrameVector<int> resultIndices;
+    Query(worldPos, resultIndices);
+    return std::vector<int>(resultIndices.begin(), resultIndices.end());
+}
+
+void UniformGrid::Query(Vector3 worldPos, FrameVector<int> &outIndices)
+{
+    BeginQuery(outIndices);
     Vector3Int centerIndices = GetCellIndices(worldPos);
     for (int dz = -1; dz <= 1; ++dz)
     {
@@ -157,130 +634,463 @@ std::vector<int> UniformGrid::Query(Vector3 worldPos)
                 int checkX = centerIndices.x + dx;
                 int checkY = centerIndices.y + dy;
                 int checkZ = centerIndices.z + dz;
-                if (IsValidIndex(checkX, checkY, checkZ))
-                {
-                    int cellIndex = Get1DIndex(checkX, checkY, checkZ);
-                    // Cast gridCells.size() to int for comparison
-                    if (cellIndex >= 0 && cellIndex < (int)gridCells.size())
-                    { // Safety check
-                        uniqueIndices.insert(gridCells[cellIndex].begin(), gridCells[cellIndex].end());
-                    }
-                    else
-                    {
-                        TraceLog(LOG_WARNING, "GRID QUERY: Calculated invalid cell index %d for coords (%d, %d, %d)", cellIndex, checkX, checkY, checkZ);
-                    }
-                }
+                // GatherCell validates the coordinates and skips empty cells
+                GatherCell(checkX, checkY, checkZ, outIndices);
             }
         }
     }
-    std::vector<int> resultIndices(uniqueIndices.begin(), uniqueIndices.end());
-    return resultIndices;
 }
 
 // QueryRay Implementation
 std::vector<int> UniformGrid::QueryRay(Ray ray, float maxDistance)
 {
-    std::set<int> uniqueIndices;
+    FrameVector<int> resultIndices;
+    QueryRay(ray, maxDistance, resultIndices);
+    return std::vector<int>(resultIndices.begin(), resultIndices.end());
+}
 
+void UniformGrid::QueryRay(Ray ray, float maxDistance, FrameVector<int> &outIndices)
+{
     if (Vector3LengthSqr(ray.direction) < 0.0001f)
     {
-        return Query(ray.position);
+        Query(ray.position, outIndices);
+        return;
     }
 
-    Vector3Int currentIndices = GetCellIndices(ray.position);
-    int ix = currentIndices.x;
-    int iy = currentIndices.y;
-    int iz = currentIndices.z;
-    int stepX = (ray.direction.x >= 0) ? 1 : -1;
-    int stepY = (ray.direction.y >= 0) ? 1 : -1;
-    int stepZ = (ray.direction.z >= 0) ? 1 : -1;
-    float tMaxX = std::numeric_limits<float>::infinity();
-    float tMaxY = std::numeric_limits<float>::infinity();
-    float tMaxZ = std::numeric_limits<float>::infinity();
-    float tDeltaX = std::numeric_limits<float>::infinity();
-    float tDeltaY = std::numeric_limits<float>::infinity();
-    float tDeltaZ = std::numeric_limits<float>::infinity();
+    BeginQuery(outIndices);
+    ray.direction = Vector3Normalize(ray.direction); // maxDistance is measured along a unit direction
+
+    // Same walk as TraceRay: origins outside the grid start at its surface
+    float tEnter = 0.0f;
+    float tExit = maxDistance;
+    if (!ClipToBounds(ray.position, ray.direction, 0.0f, tEnter, tExit))
+        return;
 
-    if (fabsf(ray.direction.x) > 0.0001f)
+    GridCellWalk walk = BeginCellWalk(ray.position, ray.direction, tEnter);
+    float cellEnterT = tEnter;
+    while (cellEnterT < maxDistance && IsValidIndex(walk.cell.x, walk.cell.y, walk.cell.z))
     {
-        float nextBoundXCoord = (stepX > 0) ? (float)(ix + 1) * gridCellSize.x + gridMinBounds.x : (float)(ix)*gridCellSize.x + gridMinBounds.x;
-        tMaxX = (nextBoundXCoord - ray.position.x) / ray.direction.x;
-        tDeltaX = fabsf(gridCellSize.x / ray.direction.x);
+        GatherCell(walk.cell.x, walk.cell.y, walk.cell.z, outIndices);
+        cellEnterT = StepCellWalk(walk);
     }
-    if (fabsf(ray.direction.y) > 0.0001f)
+}
+
+// Clip origin + t * direction (unit length) against the grid bounds grown by padding, narrowing [tEnter, tExit]
+bool UniformGrid::ClipToBounds(Vector3 origin, Vector3 direction, float padding, float &tEnter, float &tExit) const
+{
+    const float start[3] = {origin.x, origin.y, origin.z};
+    const float dir[3] = {direction.x, direction.y, direction.z};
+    const float boundsMin[3] = {gridMinBounds.x - padding, gridMinBounds.y - padding, gridMinBounds.z - padding};
+    const float boundsMax[3] = {gridMaxBounds.x + padding, gridMaxBounds.y + padding, gridMaxBounds.z + padding};
+    for (int axis = 0; axis < 3; ++axis)
     {
-        float nextBoundYCoord = (stepY > 0) ? (float)(iy + 1) * gridCellSize.y + gridMinBounds.y : (float)(iy)*gridCellSize.y + gridMinBounds.y;
-        tMaxY = (nextBoundYCoord - ray.position.y) / ray.direction.y;
-        tDeltaY = fabsf(gridCellSize.y / ray.direction.y);
+        if (fabsf(dir[axis]) < 0.0001f)
+        {
+            if (start[axis] < boundsMin[axis] || start[axis] > boundsMax[axis])
+                return false; // Parallel to this slab and outside it
+            continue;
+        }
+        float t0 = (boundsMin[axis] - start[axis]) / dir[axis];
+        float t1 = (boundsMax[axis] - start[axis]) / dir[axis];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tEnter = std::max(tEnter, t0);
+        tExit = std::min(tExit, t1);
     }
-    if (fabsf(ray.direction.z) > 0.0001f)
+    return tEnter <= tExit;
+}
+
+// 3D DDA set up at origin + tEnter * direction (t relative to origin)
+UniformGrid::GridCellWalk UniformGrid::BeginCellWalk(Vector3 origin, Vector3 direction, float tEnter) const
+{
+    const float infinity = std::numeric_limits<float>::infinity();
+    GridCellWalk walk;
+    walk.cell = GetCellIndices(Vector3Add(origin, Vector3Scale(direction, tEnter)));
+    walk.step = Vector3Int{(direction.x >= 0) ? 1 : -1, (direction.y >= 0) ? 1 : -1, (direction.z >= 0) ? 1 : -1};
+    walk.tMax = Vector3{infinity, infinity, infinity};
+    walk.tDelta = Vector3{infinity, infinity, infinity};
+
+    if (fabsf(direction.x) > 0.0001f)
     {
-        float nextBoundZCoord = (stepZ > 0) ? (float)(iz + 1) * gridCellSize.z + gridMinBounds.z : (float)(iz)*gridCellSize.z + gridMinBounds.z;
-        tMaxZ = (nextBoundZCoord - ray.position.z) / ray.direction.z;
-        tDeltaZ = fabsf(gridCellSize.z / ray.direction.z);
+        float nextBoundXCoord = (float)(walk.cell.x + ((walk.step.x > 0) ? 1 : 0)) * gridCellSize.x + gridMinBounds.x;
+        walk.tMax.x = (nextBoundXCoord - origin.x) / direction.x;
+        walk.tDelta.x = fabsf(gridCellSize.x / direction.x);
     }
+    if (fabsf(direction.y) > 0.0001f)
+    {
+        float nextBoundYCoord = (float)(walk.cell.y + ((walk.step.y > 0) ? 1 : 0)) * gridCellSize.y + gridMinBounds.y;
+        walk.tMax.y = (nextBoundYCoord - origin.y) / direction.y;
+        walk.tDelta.y = fabsf(gridCellSize.y / direction.y);
+    }
+    if (fabsf(direction.z) > 0.0001f)
+    {
+        float nextBoundZCoord = (float)(walk.cell.z + ((walk.step.z > 0) ? 1 : 0)) * gridCellSize.z + gridMinBounds.z;
+        walk.tMax.z = (nextBoundZCoord - origin.z) / direction.z;
+        walk.tDelta.z = fabsf(gridCellSize.z / direction.z);
+    }
+    return walk;
+}
 
-    float currentT = 0.0f;
+// Move to the next cell along the walk, returns the t at which it is entered
+float UniformGrid::StepCellWalk(GridCellWalk &walk)
+{
+    float cellEnterT;
+    if (walk.tMax.x < walk.tMax.y && walk.tMax.x < walk.tMax.z)
+    {
+        cellEnterT = walk.tMax.x;
+        walk.tMax.x += walk.tDelta.x;
+        walk.cell.x += walk.step.x;
+    }
+    else if (walk.tMax.y < walk.tMax.z)
+    {
+        cellEnterT = walk.tMax.y;
+        walk.tMax.y += walk.tDelta.y;
+        walk.cell.y += walk.step.y;
+    }
+    else
+    {
+        cellEnterT = walk.tMax.z;
+        walk.tMax.z += walk.tDelta.z;
+        walk.cell.z += walk.step.z;
+    }
+    return cellEnterT;
+}
+
+// Raycast Implementation
+GridRayHit UniformGrid::Raycast(Ray ray, float maxDistance, const AsteroidStore &asteroids)
+{
+    EnsurePacked();
+    queryStats.queries++;
+    return TraceRay(ray, maxDistance, asteroids, queryStats.cellsVisited);
+}
+
+void UniformGrid::RaycastBatch(const Ray *rays, int rayCount, float maxDistance, const AsteroidStore &asteroids,
+                               GridRayHit *outHits, JobSystem *jobs)
+{
+    if (rayCount <= 0)
+        return;
+
+    EnsurePacked(); // TraceRay is read-only on a packed grid, so the rays can run in parallel
+    queryStats.queries += rayCount;
+
+    if (jobs == nullptr)
+    {
+        for (int i = 0; i < rayCount; ++i)
+            outHits[i] = TraceRay(rays[i], maxDistance, asteroids, queryStats.cellsVisited);
+        return;
+    }
+
+    std::atomic<int> cellsVisited(0);
+    const UniformGrid *grid = this;
+    const AsteroidStore *store = &asteroids;
+    std::atomic<int> *visitedCounter = &cellsVisited;
+    jobs->ParallelFor((size_t)rayCount, GRID_RAY_JOB_CHUNK, [=](size_t begin, size_t end) {
+        int chunkCells = 0;
+        for (size_t i = begin; i < end; ++i)
+            outHits[i] = grid->TraceRay(rays[i], maxDistance, *store, chunkCells);
+        visitedCounter->fetch_add(chunkCells, std::memory_order_relaxed);
+    });
+    jobs->Wait();
+    queryStats.cellsVisited += cellsVisited.load();
+}
+
+// Front-to-back DDA over the cells the ray crosses, testing each cell's spheres as it is reached
+GridRayHit UniformGrid::TraceRay(Ray ray, float maxDistance, const AsteroidStore &asteroids, int &cellsVisited) const
+{
+    GridRayHit bestHit = {-1, maxDistance, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    if (Vector3LengthSqr(ray.direction) < 0.0001f || cellOffsets.empty())
+        return bestHit;
+    ray.direction = Vector3Normalize(ray.direction); // Distances are measured along a unit direction
+
+    // Origins outside the grid start at its surface, t stays relative to the ray origin
+    float tEnter = 0.0f;
+    float tExit = maxDistance;
+    if (!ClipToBounds(ray.position, ray.direction, 0.0f, tEnter, tExit))
+        return bestHit;
 
-    if (IsValidIndex(ix, iy, iz))
+    // A sphere hit lies inside the sphere's bounds, so it is found in a cell the ray enters at or before
+    // the hit distance: once a cell starts beyond the best hit, no later cell can hold a closer one
+    GridCellWalk walk = BeginCellWalk(ray.position, ray.direction, tEnter);
+    float cellEnterT = tEnter;
+    while (cellEnterT <= bestHit.distance && IsValidIndex(walk.cell.x, walk.cell.y, walk.cell.z))
     {
-        int cellIndex = Get1DIndex(ix, iy, iz);
-        // Cast gridCells.size() to int for comparison
-        if (cellIndex >= 0 && cellIndex < (int)gridCells.size())
+        TestCellSpheres(walk.cell.x, walk.cell.y, walk.cell.z, ray, asteroids, bestHit, cellsVisited);
+        cellEnterT = StepCellWalk(walk);
+    }
+
+    CompleteRayHit(ray, asteroids, bestHit);
+    return bestHit;
+}
+
+// Test every instance of one cell. Instances spanning several cells are simply tested again
+// (about as cheap as a dedup stamp lookup, and it keeps the traversal read-only).
+void UniformGrid::TestCellSpheres(int ix, int iy, int iz, Ray ray, const AsteroidStore &asteroids, GridRayHit &bestHit,
+                                  int &cellsVisited) const
+{
+    int cellSlot = FindCellSlot(ix, iy, iz);
+    if (cellSlot >= 0)
+    {
+        cellsVisited++;
+        int cellEnd = cellOffsets[cellSlot] + cellCounts[cellSlot];
+        for (int e = cellOffsets[cellSlot]; e < cellEnd; ++e)
+            TestInstanceSphere(ray, asteroids, cellEntries[e], bestHit);
+    }
+
+    // Entries inserted after packing that did not fit into their cell
+    if (!overflowEntries.empty())
+    {
+        long long key = GetCellKey(ix, iy, iz);
+        for (size_t i = 0; i < overflowEntries.size(); ++i)
         {
-            uniqueIndices.insert(gridCells[cellIndex].begin(), gridCells[cellIndex].end());
+            if (overflowEntries[i].cellKey == key)
+                TestInstanceSphere(ray, asteroids, overflowEntries[i].instanceIndex, bestHit);
         }
     }
+}
+
+// Swept Sphere Implementation
+GridSweepHit UniformGrid::SweepSphere(Vector3 start, Vector3 end, float radius, const AsteroidStore &asteroids)
+{
+    GridSweepHit bestHit = {-1, 1.0f, end, {0.0f, 0.0f, 0.0f}};
+    EnsurePacked();
+    queryStats.queries++;
+    if (cellOffsets.empty())
+        return bestHit;
+    AdvanceQueryStamp(); // Each asteroid is tested once, however many visited cells hold it
+
+    // Walk the cells of the center line in distance units (t = distance / length at the end)
+    Vector3 movement = Vector3Subtract(end, start);
+    float length = Vector3Length(movement);
+    Vector3 direction = (length > 0.0001f) ? Vector3Scale(movement, 1.0f / length) : Vector3{0.0f, 0.0f, 0.0f};
+    float tEnter = 0.0f;
+    float tExit = length;
+    if (!ClipToBounds(start, direction, radius, tEnter, tExit))
+        return bestHit;
 
-    while (currentT < maxDistance)
+    // Contact points lie within radius of the center, so every center line cell also covers the cells
+    // up to radius around it (the asteroid's own bounds reach into at least one of them)
+    Vector3Int reach = {(int)ceilf(radius / gridCellSize.x), (int)ceilf(radius / gridCellSize.y), (int)ceilf(radius / gridCellSize.z)};
+    float bestDistance = length;
+    GridCellWalk walk = BeginCellWalk(start, direction, tEnter);
+    float cellEnterT = tEnter;
+    while (cellEnterT <= bestDistance)
     {
-        if (tMaxX < tMaxY)
+        Vector3Int cell = walk.cell;
+        if (cell.x < -reach.x || cell.x >= gridDimX + reach.x || cell.y < -reach.y || cell.y >= gridDimY + reach.y ||
+            cell.z < -reach.z || cell.z >= gridDimZ + reach.z)
+            break; // The covered block has left the grid
+
+        for (int iz = cell.z - reach.z; iz <= cell.z + reach.z; ++iz)
+            for (int iy = cell.y - reach.y; iy <= cell.y + reach.y; ++iy)
+                for (int ix = cell.x - reach.x; ix <= cell.x + reach.x; ++ix)
+                    SweepCellSpheres(ix, iy, iz, start, direction, radius, asteroids, bestHit, bestDistance);
+
+        if (length <= 0.0001f)
+            break; // Not moving: only the overlap at the start position
+        cellEnterT = StepCellWalk(walk);
+    }
+
+    CompleteSweepHit(start, direction, length, asteroids, bestDistance, bestHit);
+    return bestHit;
+}
+
+// Sweep test for every asteroid of one cell not yet tested by this sweep
+void UniformGrid::SweepCellSpheres(int ix, int iy, int iz, Vector3 start, Vector3 direction, float radius,
+                                   const AsteroidStore &asteroids, GridSweepHit &bestHit, float &bestDistance)
+{
+    int cellSlot = FindCellSlot(ix, iy, iz); // Validates the coordinates, -1 if empty
+    if (cellSlot >= 0)
+    {
+        queryStats.cellsVisited++;
+        int cellEnd = cellOffsets[cellSlot] + cellCounts[cellSlot];
+        for (int e = cellOffsets[cellSlot]; e < cellEnd; ++e)
         {
-            if (tMaxX < tMaxZ)
-            {
-                currentT = tMaxX;
-                tMaxX += tDeltaX;
-                ix += stepX;
-            }
-            else
-            {
-                currentT = tMaxZ;
-                tMaxZ += tDeltaZ;
-                iz += stepZ;
-            }
+            int instanceIndex = cellEntries[e];
+            if (instanceStamps[instanceIndex] == queryStamp)
+                continue; // Already tested through another cell
+            instanceStamps[instanceIndex] = queryStamp;
+            queryStats.candidates++;
+            SweepTestSphere(start, direction, radius, asteroids, instanceIndex, bestHit, bestDistance);
         }
-        else
+    }
+
+    // Entries inserted after packing that did not fit into their cell
+    if (!overflowEntries.empty() && IsValidIndex(ix, iy, iz))
+    {
+        long long key = GetCellKey(ix, iy, iz);
+        for (size_t i = 0; i < overflowEntries.size(); ++i)
         {
-            if (tMaxY < tMaxZ)
-            {
-                currentT = tMaxY;
-                tMaxY += tDeltaY;
-                iy += stepY;
-            }
-            else
-            {
-                currentT = tMaxZ;
-                tMaxZ += tDeltaZ;
-                iz += stepZ;
-            }
+            int instanceIndex = overflowEntries[i].instanceIndex;
+            if (overflowEntries[i].cellKey != key || instanceStamps[instanceIndex] == queryStamp)
+                continue;
+            instanceStamps[instanceIndex] = queryStamp;
+            queryStats.candidates++;
+            SweepTestSphere(start, direction, radius, asteroids, instanceIndex, bestHit, bestDistance);
         }
+    }
+}
+
+// Broad Phase Pair Pass Implementation
+void UniformGrid::FindPairs(std::vector<GridPair> &outPairs, GridPairCallback narrowPhase, void *userData, JobSystem *jobs)
+{
+    outPairs.clear();
+    pairStats = GridPairStats{0};
 
-        if (currentT >= maxDistance)
-            break;
-        if (!IsValidIndex(ix, iy, iz))
-            break;
+    // The pass reads the packed cells only, fold overflow entries back in first
+    if (packDirty || !overflowEntries.empty())
+        Pack();
+    if (cellOffsets.empty())
+        return;
 
-        int cellIndex = Get1DIndex(ix, iy, iz);
-        // Cast gridCells.size() to int for comparison
-        if (cellIndex >= 0 && cellIndex < (int)gridCells.size())
+    size_t slotCount = cellOffsets.size() - 1;
+    if (jobs == nullptr)
+    {
+        FindPairsInSlots(0, slotCount, narrowPhase, userData, outPairs, pairStats);
+        return;
+    }
+
+    size_t slabSlots = (storageMode == GRID_STORAGE_DENSE) ? (size_t)gridDimX * gridDimY : (size_t)GRID_PAIR_HASHED_SLAB_SLOTS;
+    size_t slabCount = (slotCount + slabSlots - 1) / slabSlots;
+    if (slabPairs.size() < slabCount)
+    {
+        slabPairs.resize(slabCount);
+        slabStats.resize(slabCount);
+    }
+
+    // Every slab owns its own output vector and counters
+    const UniformGrid *grid = this;
+    std::vector<GridPair> *slabOutputs = slabPairs.data();
+    GridPairStats *slabCounters = slabStats.data();
+    jobs->ParallelFor(slabCount, 1, [=](size_t begin, size_t end) {
+        for (size_t slab = begin; slab < end; ++slab)
         {
-            uniqueIndices.insert(gridCells[cellIndex].begin(), gridCells[cellIndex].end());
+            slabOutputs[slab].clear();
+            slabCounters[slab] = GridPairStats{0};
+            size_t beginSlot = slab * slabSlots;
+            grid->FindPairsInSlots(beginSlot, std::min(beginSlot + slabSlots, slotCount), narrowPhase, userData,
+                                   slabOutputs[slab], slabCounters[slab]);
         }
-        else
+    });
+    jobs->Wait();
+
+    // Concatenate in slab order so the result is the same for any thread count
+    size_t total = 0;
+    for (size_t slab = 0; slab < slabCount; ++slab)
+        total += slabPairs[slab].size();
+    outPairs.reserve(total);
+    for (size_t slab = 0; slab < slabCount; ++slab)
+    {
+        outPairs.insert(outPairs.end(), slabPairs[slab].begin(), slabPairs[slab].end());
+        pairStats.cellsScanned += slabStats[slab].cellsScanned;
+        pairStats.candidatePairs += slabStats[slab].candidatePairs;
+        pairStats.pairs += slabStats[slab].pairs;
+    }
+}
+
+void UniformGrid::FindPairsInSlots(size_t beginSlot, size_t endSlot, GridPairCallback narrowPhase, void *userData,
+                                   std::vector<GridPair> &outPairs, GridPairStats &stats) const
+{
+    for (size_t slot = beginSlot; slot < endSlot; ++slot)
+    {
+        int cellBegin = cellOffsets[slot];
+        int cellEnd = cellBegin + cellCounts[slot];
+        if (cellEnd - cellBegin < 2)
+        {
+            stats.cellsScanned += (cellEnd > cellBegin) ? 1 : 0;
+            continue;
+        }
+        stats.cellsScanned++;
+
+        for (int e = cellBegin; e < cellEnd; ++e)
+        {
+            int first = cellEntries[e];
+            const GridInstanceRange &firstRange = instanceRanges[first];
+            for (int f = e + 1; f < cellEnd; ++f)
+            {
+                int second = cellEntries[f];
+                const GridInstanceRange &secondRange = instanceRanges[second];
+
+                // Both ranges contain this cell, so their overlap is a box with this as one of its cells.
+                // Only the overlap's min corner reports the pair, every other shared cell skips it.
+                int refX = std::max(firstRange.minCell.x, secondRange.minCell.x);
+                int refY = std::max(firstRange.minCell.y, secondRange.minCell.y);
+                int refZ = std::max(firstRange.minCell.z, secondRange.minCell.z);
+                if (FindCellSlot(refX, refY, refZ) != (int)slot)
+                    continue;
+
+                GridPair pair = {std::min(first, second), std::max(first, second)};
+                stats.candidatePairs++;
+                if (narrowPhase != nullptr && !narrowPhase(pair.a, pair.b, userData))
+                    continue;
+                stats.pairs++;
+                outPairs.push_back(pair);
+            }
+        }
+    }
+}
+
+// Frustum Query Implementation
+void UniformGrid::QueryFrustum(const Frustum &frustum, FrameVector<int> &outInside, FrameVector<int> &outIntersecting)
+{
+    BeginQuery(outInside); // Same stamp dedups across both outputs
+    outIntersecting.clear();
+
+    // Only the cells covered by the frustum's bounding box can be visible
+    Vector3Int minCell = GetCellIndices(frustum.bounds.min);
+    Vector3Int maxCell = GetCellIndices(frustum.bounds.max);
+    GatherFrustumBlock(frustum, minCell, maxCell, outInside, outIntersecting);
+}
+
+// Test a block of cells (inclusive range) and recurse into halves while it straddles a plane
+void UniformGrid::GatherFrustumBlock(const Frustum &frustum, Vector3Int minCell, Vector3Int maxCell,
+                                     FrameVector<int> &outInside, FrameVector<int> &outIntersecting)
+{
+    BoundingBox blockBounds = {
+        {gridMinBounds.x + minCell.x * gridCellSize.x, gridMinBounds.y + minCell.y * gridCellSize.y, gridMinBounds.z + minCell.z * gridCellSize.z},
+        {gridMinBounds.x + (maxCell.x + 1) * gridCellSize.x, gridMinBounds.y + (maxCell.y + 1) * gridCellSize.y, gridMinBounds.z + (maxCell.z + 1) * gridCellSize.z}};
+
+    FrustumTestResult test = FrustumTestBox(frustum, blockBounds);
+    if (test == FRUSTUM_OUTSIDE)
+        return;
+
+    int sizeX = maxCell.x - minCell.x + 1;
+    int sizeY = maxCell.y - minCell.y + 1;
+    int sizeZ = maxCell.z - minCell.z + 1;
+
+    if (test == FRUSTUM_INSIDE || (sizeX == 1 && sizeY == 1 && sizeZ == 1))
+    {
+        FrameVector<int> &outIndices = (test == FRUSTUM_INSIDE) ? outInside : outIntersecting;
+        for (int iz = minCell.z; iz <= maxCell.z; ++iz)
         {
-            TraceLog(LOG_WARNING, "GRID RAY QUERY: Calculated invalid cell index %d for coords (%d, %d, %d)", cellIndex, ix, iy, iz);
+            for (int iy = minCell.y; iy <= maxCell.y; ++iy)
+            {
+                for (int ix = minCell.x; ix <= maxCell.x; ++ix)
+                {
+                    GatherCell(ix, iy, iz, outIndices);
+                }
+            }
         }
+        return;
+    }
+
+    // Split along the longest axis (in cells)
+    Vector3Int lowMax = maxCell;
+    Vector3Int highMin = minCell;
+    if (sizeX >= sizeY && sizeX >= sizeZ)
+    {
+        lowMax.x = minCell.x + sizeX / 2 - 1;
+        highMin.x = lowMax.x + 1;
+    }
+    else if (sizeY >= sizeZ)
+    {
+        lowMax.y = minCell.y + sizeY / 2 - 1;
+        highMin.y = lowMax.y + 1;
+    }
+    else
+    {
+        lowMax.z = minCell.z + sizeZ / 2 - 1;
+        highMin.z = lowMax.z + 1;
     }
-    std::vector<int> resultIndices(uniqueIndices.begin(), uniqueIndices.end());
-    return resultIndices;
+    GatherFrustumBlock(frustum, minCell, lowMax, outInside, outIntersecting);
+    GatherFrustumBlock(frustum, highMin, maxCell, outInside, outIntersecting);
 }
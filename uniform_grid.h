@@ -4,10 +4,13 @@
 #include "raylib.h"
 #include "raymath.h"
 #include <vector>
-#include <set>
 
-// Include Asteroid definition needed for BuildInstanced parameter
-#include "asteroid_field.h"
+// Include AsteroidStore definition needed for BuildInstanced parameter
+#include "asteroid_store.h"
+#include "frame_arena.h"
+#include "frustum.h"
+#include "job_system.h"
+#include "spatial_index.h"
 
 // Helper struct for integer grid coordinates
 typedef struct Vector3Int
@@ -17,40 +20,211 @@ typedef struct Vector3Int
     int z;
 } Vector3Int;
 
-class UniformGrid
+// Unordered instance pair reported by FindPairs (a < b)
+typedef struct GridPair
+{
+    int a;
+    int b;
+} GridPair;
+
+// Narrow phase for FindPairs: return true to keep the pair. Called concurrently from job threads
+// when FindPairs runs on a job system, so it must only read shared data.
+typedef bool (*GridPairCallback)(int a, int b, void *userData);
+
+// Counters of the last FindPairs pass
+typedef struct GridPairStats
+{
+    int cellsScanned;   // Occupied cells walked
+    int candidatePairs; // Unique pairs sharing a cell (broad phase output)
+    int pairs;          // Pairs kept by the narrow phase (== candidatePairs without one)
+} GridPairStats;
+
+constexpr int GRID_PAIR_HASHED_SLAB_SLOTS = 256; // Occupied cells per job in hashed mode (dense: one z layer)
+
+// Cell storage layout. Both layouts pack every cell's index list into one contiguous
+// array (CSR: cell -> [offset, offset + count)), built with a counting sort.
+typedef enum GridStorageMode
+{
+    GRID_STORAGE_AUTO = 0, // Dense unless the dense offsets array would exceed GRID_MAX_DENSE_CELLS
+    GRID_STORAGE_DENSE,    // Offsets for every cell, cell lookup is a direct index
+    GRID_STORAGE_HASHED,   // Offsets only for occupied cells, looked up through a hash table
+} GridStorageMode;
+
+constexpr long long GRID_MAX_DENSE_CELLS = 1 << 22; // ~16 MB of offsets
+
+class UniformGrid : public SpatialIndex
 {
 public:
-    UniformGrid(Vector3 worldMin, Vector3 worldMax, Vector3 cellSize);
+    UniformGrid(Vector3 worldMin, Vector3 worldMax, Vector3 cellSize, GridStorageMode storageMode = GRID_STORAGE_AUTO);
+    const char *GetName() const override { return "Grid"; }
     void Clear();
-    // Add still takes index and world bounds
-    void Add(int instanceIndex, BoundingBox worldBounds);
+    // Add still takes index and world bounds (packed into the CSR arrays on the next Pack/query,
+    // or inserted in place once the grid is packed)
+    void Add(int instanceIndex, BoundingBox worldBounds) override;
+    // Counting-sort all added instances into the packed cell arrays
+    void Pack();
 
-    // Build method for original Asteroid struct (can be kept or removed)
-    // void Build(const std::vector<Asteroid>& asteroids);
+    // --- Incremental Updates (only the affected cells are touched) ---
+    // Remove an instance from every cell it occupies (e.g. destroyed asteroid)
+    void Remove(int instanceIndex) override;
+    // Update an instance after it moved. oldBounds lets the common case (same cells) return
+    // immediately; cell membership itself is taken from the grid's own record of the instance.
+    void Move(int instanceIndex, BoundingBox oldBounds, BoundingBox newBounds) override;
+    int GetOverflowCount() const { return (int)overflowEntries.size(); }
 
     // --- Added Build Method for Instances ---
-    void BuildInstanced(const std::vector<Asteroid> &instances);
+    void BuildInstanced(const AsteroidStore &instances) override;
     // --- End Added Build Method ---
 
     std::vector<int> Query(Vector3 worldPos);
     std::vector<int> QueryRay(Ray ray, float maxDistance);
 
+    // Allocation-free overloads: clear and fill a caller-owned buffer, reused across calls or
+    // taken from the frame arena. Duplicates are removed with a per-instance generation stamp.
+    void Query(Vector3 worldPos, FrameVector<int> &outIndices) override;
+    void QueryRay(Ray ray, float maxDistance, FrameVector<int> &outIndices) override;
+
+    // Visibility query: cells are culled against the frustum hierarchically (blocks of cells first),
+    // so the cost scales with the visible volume. Indices from cells fully inside the frustum go to
+    // outInside and need no further test; cells crossing a plane go to outIntersecting.
+    void QueryFrustum(const Frustum &frustum, FrameVector<int> &outInside, FrameVector<int> &outIntersecting) override;
+
+    // Closest hit against the asteroids' collision spheres (inactive asteroids are skipped).
+    // Cells are walked front to back and their spheres tested as they are reached, stopping at
+    // the first cell that starts beyond the best hit so far, so the cost follows the nearest hit
+    // instead of every candidate up to maxDistance.
+    GridRayHit Raycast(Ray ray, float maxDistance, const AsteroidStore &asteroids) override;
+    // Same test for many rays (weapon spreads, line-of-sight checks): outHits[i] is the hit of rays[i].
+    // With a job system the rays are split across its threads, the call returns once all are done.
+    void RaycastBatch(const Ray *rays, int rayCount, float maxDistance, const AsteroidStore &asteroids,
+                      GridRayHit *outHits, JobSystem *jobs = nullptr) override;
+
+    // Moving sphere (capsule) from start to end against the asteroids' collision spheres: earliest
+    // time of impact, 0 if it already overlaps one at start. Covers every cell within radius of the
+    // segment, so fast movement cannot step over an asteroid, and stops at the first cell past the
+    // earliest contact found so far.
+    GridSweepHit SweepSphere(Vector3 start, Vector3 end, float radius, const AsteroidStore &asteroids) override;
+
+    // All-pairs broad phase: every instance pair whose cell ranges overlap, reported exactly once.
+    // Instances are stored in every cell they overlap, so each pair is emitted only by the first
+    // cell (lowest x, y, z) both ranges share. Cells are split into slabs that run in parallel on
+    // the job system (the call returns once all are done); the output order does not depend on
+    // the thread count. narrowPhase (optional) filters the candidates, e.g. sphere vs sphere.
+    void FindPairs(std::vector<GridPair> &outPairs, GridPairCallback narrowPhase = nullptr, void *userData = nullptr,
+                   JobSystem *jobs = nullptr);
+    const GridPairStats &GetPairStats() const { return pairStats; }
+
+    const GridQueryStats &GetQueryStats() const override { return queryStats; }
+    void ResetQueryStats() override { queryStats = GridQueryStats{0}; }
+
     Vector3Int GetCellIndices(Vector3 worldPos) const;
     int Get1DIndex(int ix, int iy, int iz) const;
+    long long GetCellKey(int ix, int iy, int iz) const; // 1D index without int overflow (hashed mode)
     bool IsValidIndex(int ix, int iy, int iz) const;
 
     Vector3 GetMinBounds() const { return gridMinBounds; }
     Vector3 GetMaxBounds() const { return gridMaxBounds; }
     Vector3 GetCellSize() const { return gridCellSize; }
     Vector3Int GetDimensions() const { return Vector3Int{gridDimX, gridDimY, gridDimZ}; }
+    GridStorageMode GetStorageMode() const { return storageMode; }
+    int GetInstanceCapacity() const { return (int)instanceRanges.size(); } // Instance indices with a range record
+    size_t GetMemoryUsage() const override; // Bytes held by cell storage, hash table and per-instance records
+
+    // --- Serialization (field cache) ---
+    // Appends the packed state (packing first if needed) as one flat blob; the blob holds the
+    // bounds, cell size and storage mode too. Deserialize returns a new grid with exactly that
+    // state, or nullptr if the blob is truncated or inconsistent.
+    void Serialize(std::vector<unsigned char> &out);
+    static UniformGrid *Deserialize(const unsigned char *data, size_t size);
 
 private:
+    // Cell range an added instance overlaps (inclusive)
+    typedef struct GridInstanceRange
+    {
+        Vector3Int minCell;
+        Vector3Int maxCell;
+        bool inGrid;
+    } GridInstanceRange;
+
     Vector3 gridMinBounds;
     Vector3 gridMaxBounds;
     Vector3 gridCellSize;
     int gridDimX, gridDimY, gridDimZ;
-    int totalCells;
-    std::vector<std::vector<int>> gridCells;
+    long long totalCells;
+    GridStorageMode storageMode; // Resolved mode (never GRID_STORAGE_AUTO)
+
+    // Entry inserted after packing that did not fit into its cell's packed range
+    typedef struct GridOverflowEntry
+    {
+        long long cellKey;
+        int instanceIndex;
+    } GridOverflowEntry;
+
+    // Packed cell storage: slot s holds cellEntries[cellOffsets[s] .. cellOffsets[s] + cellCounts[s])
+    // Removals swap the last live entry into the hole, so capacity (next offset) can exceed the count.
+    std::vector<GridInstanceRange> instanceRanges; // Indexed by instance, source for Pack()
+    std::vector<int> cellOffsets;                  // Dense: totalCells + 1, hashed: occupied cells + 1
+    std::vector<int> cellCounts;                   // Live entries per slot
+    std::vector<int> cellEntries;                  // All cell index lists back to back
+    std::vector<int> packCursor;                   // Scratch write cursors for the counting sort
+    bool packDirty;
+
+    // Inserts that found no free packed space, scanned by queries until the next repack
+    std::vector<GridOverflowEntry> overflowEntries;
+
+    // Hashed mode: open-addressing table from cell key to slot (-1 key = empty)
+    std::vector<long long> hashKeys;
+    std::vector<int> hashSlots;
+
+    int FindCellSlot(int ix, int iy, int iz) const; // -1 if the cell holds nothing
+    int InsertHashedCell(long long key);            // Returns the slot, creating it if needed
+    void InsertIntoCell(int ix, int iy, int iz, int instanceIndex);
+    void RemoveFromCell(int ix, int iy, int iz, int instanceIndex);
+    // Packed grid only: leave cells in oldRange but not newRange, enter cells in newRange but not oldRange
+    void ApplyRangeChange(int instanceIndex, const GridInstanceRange &oldRange, const GridInstanceRange &newRange);
+    bool IsPacked() const { return !packDirty && !cellOffsets.empty(); }
+    static bool RangeContains(const GridInstanceRange &range, int ix, int iy, int iz);
+    void EnsurePacked()
+    {
+        if (packDirty)
+            Pack();
+    }
+
+    // Query deduplication: an index is already in the output if its stamp equals queryStamp
+    std::vector<unsigned int> instanceStamps;
+    unsigned int queryStamp;
+    GridQueryStats queryStats;
+
+    void BeginQuery(FrameVector<int> &outIndices);
+    void AdvanceQueryStamp();
+    // 3D DDA over the cells along origin + t * direction
+    typedef struct GridCellWalk
+    {
+        Vector3Int cell;
+        Vector3Int step;
+        Vector3 tMax;   // t at which the walk crosses the next cell boundary on each axis
+        Vector3 tDelta; // t between boundaries on each axis
+    } GridCellWalk;
+    bool ClipToBounds(Vector3 origin, Vector3 direction, float padding, float &tEnter, float &tExit) const;
+    GridCellWalk BeginCellWalk(Vector3 origin, Vector3 direction, float tEnter) const;
+    static float StepCellWalk(GridCellWalk &walk);
+    void SweepCellSpheres(int ix, int iy, int iz, Vector3 start, Vector3 direction, float radius,
+                          const AsteroidStore &asteroids, GridSweepHit &bestHit, float &bestDistance);
+
+    // Read-only raycast core (safe to run concurrently on a packed grid); adds the cells it scanned to cellsVisited
+    GridRayHit TraceRay(Ray ray, float maxDistance, const AsteroidStore &asteroids, int &cellsVisited) const;
+    void TestCellSpheres(int ix, int iy, int iz, Ray ray, const AsteroidStore &asteroids, GridRayHit &bestHit,
+                         int &cellsVisited) const;
+    void GatherCell(int ix, int iy, int iz, FrameVector<int> &outIndices);
+    // Pair pass over the slots [beginSlot, endSlot), appending to outPairs (read-only on a packed grid)
+    void FindPairsInSlots(size_t beginSlot, size_t endSlot, GridPairCallback narrowPhase, void *userData,
+                          std::vector<GridPair> &outPairs, GridPairStats &stats) const;
+    std::vector<std::vector<GridPair>> slabPairs; // Per-slab output of FindPairs (kept for reuse)
+    std::vector<GridPairStats> slabStats;
+    GridPairStats pairStats;
+
+    void GatherFrustumBlock(const Frustum &frustum, Vector3Int minCell, Vector3Int maxCell,
+                            FrameVector<int> &outInside, FrameVector<int> &outIntersecting);
 };
 
 #endif // UNIFORM_GRID_H